@@ -0,0 +1,210 @@
+//----------------------------------------------------------------------------
+/** @file FuegoBench.cpp
+    See FuegoBench.h */
+//----------------------------------------------------------------------------
+
+#include "SgSystem.h"
+#include "FuegoBench.h"
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include "SgDebug.h"
+#include "SgPoint.h"
+#include "SgRandom.h"
+
+using namespace std;
+
+//----------------------------------------------------------------------------
+
+namespace {
+
+/** Write a string as a JSON string literal. */
+void WriteJsonString(ostream& out, const string& s)
+{
+    out << '"';
+    for (string::const_iterator it = s.begin(); it != s.end(); ++it)
+    {
+        const char c = *it;
+        if (c == '"' || c == '\\')
+            out << '\\' << c;
+        else if (static_cast<unsigned char>(c) < 0x20)
+            out << "\\u" << hex << setw(4) << setfill('0') << int(c)
+                << dec << setfill(' ');
+        else
+            out << c;
+    }
+    out << '"';
+}
+
+} // namespace
+
+//----------------------------------------------------------------------------
+
+FuegoBenchResult::FuegoBenchResult()
+    : m_size(0),
+      m_iterations(0),
+      m_nuOps(0),
+      m_time(0)
+{ }
+
+FuegoBenchResult::FuegoBenchResult(const string& name, int size,
+                                   size_t iterations, size_t nuOps,
+                                   double time)
+    : m_name(name),
+      m_size(size),
+      m_iterations(iterations),
+      m_nuOps(nuOps),
+      m_time(time)
+{ }
+
+double FuegoBenchResult::NsPerOp() const
+{
+    if (m_nuOps == 0)
+        return 0;
+    return m_time * 1e9 / double(m_nuOps);
+}
+
+//----------------------------------------------------------------------------
+
+FuegoBenchCase::~FuegoBenchCase()
+{ }
+
+void FuegoBenchCase::ClearDetails()
+{
+    // Default implementation does nothing
+}
+
+void FuegoBenchCase::GetDetails(int size,
+                                vector<FuegoBenchResult>& results) const
+{
+    SG_UNUSED(size);
+    SG_UNUSED(results);
+    // Default implementation does nothing
+}
+
+//----------------------------------------------------------------------------
+
+FuegoBenchParam::FuegoBenchParam()
+    : m_warmupTime(0.2),
+      m_minTime(1),
+      m_seed(1),
+      m_engine(SG_RANDOM_MT19937)
+{
+    m_sizes.push_back(9);
+    m_sizes.push_back(13);
+    m_sizes.push_back(19);
+}
+
+//----------------------------------------------------------------------------
+
+FuegoBench::FuegoBench(const FuegoBenchParam& param)
+    : m_param(param)
+{ }
+
+FuegoBench::~FuegoBench()
+{
+    for (vector<FuegoBenchCase*>::iterator it = m_cases.begin();
+         it != m_cases.end(); ++it)
+        delete *it;
+}
+
+void FuegoBench::Add(FuegoBenchCase* benchCase)
+{
+    m_cases.push_back(benchCase);
+}
+
+void FuegoBench::Run()
+{
+    m_results.clear();
+    for (vector<int>::const_iterator size = m_param.m_sizes.begin();
+         size != m_param.m_sizes.end(); ++size)
+        for (vector<FuegoBenchCase*>::iterator it = m_cases.begin();
+             it != m_cases.end(); ++it)
+            if ((*it)->Name().find(m_param.m_filter) != string::npos)
+                RunCase(**it, *size);
+}
+
+void FuegoBench::RunCase(FuegoBenchCase& benchCase, int size)
+{
+    SgRandom::SetEngine(m_param.m_engine);
+    SgRandom::SetSeed(m_param.m_seed);
+    benchCase.Init(size);
+    double startTime = FuegoBenchUtil::Time();
+    do
+        benchCase.Run();
+    while (FuegoBenchUtil::Time() - startTime < m_param.m_warmupTime);
+    benchCase.ClearDetails();
+    size_t iterations = 0;
+    size_t nuOps = 0;
+    double time;
+    startTime = FuegoBenchUtil::Time();
+    do
+    {
+        nuOps += benchCase.Run();
+        ++iterations;
+        time = FuegoBenchUtil::Time() - startTime;
+    }
+    while (time < m_param.m_minTime);
+    FuegoBenchResult result(benchCase.Name(), size, iterations, nuOps, time);
+    m_results.push_back(result);
+    ostringstream nsPerOp;
+    nsPerOp << fixed << setprecision(1) << result.NsPerOp();
+    SgDebug() << "FuegoBench: " << result.m_name << ' ' << size << ' '
+              << nsPerOp.str() << " ns\n";
+    benchCase.GetDetails(size, m_results);
+}
+
+void FuegoBench::WriteJson(ostream& out) const
+{
+    out << "{\n"
+        << "  \"program\": \"fuego_bench\",\n"
+        << "  \"version\": ";
+#ifdef VERSION
+    WriteJsonString(out, VERSION);
+#else
+    WriteJsonString(out, "");
+#endif
+    out << ",\n"
+        << "  \"label\": ";
+    WriteJsonString(out, m_param.m_label);
+    out << ",\n"
+        << "  \"assertions\": ";
+#ifdef NDEBUG
+    out << "false";
+#else
+    out << "true";
+#endif
+    out << ",\n"
+        << "  \"max_size\": " << SG_MAX_SIZE << ",\n"
+        << "  \"seed\": " << m_param.m_seed << ",\n"
+        << "  \"random_engine\": \"" << SgRandomEngineTypeStr(m_param.m_engine)
+        << "\",\n"
+        << "  \"warmup_time\": " << m_param.m_warmupTime << ",\n"
+        << "  \"min_time\": " << m_param.m_minTime << ",\n"
+        << "  \"results\": [";
+    for (size_t i = 0; i < m_results.size(); ++i)
+    {
+        const FuegoBenchResult& r = m_results[i];
+        out << (i == 0 ? "\n" : ",\n") << "    { \"name\": ";
+        WriteJsonString(out, r.m_name);
+        out << ", \"size\": " << r.m_size
+            << ", \"iterations\": " << r.m_iterations
+            << ", \"ops\": " << r.m_nuOps
+            << ", \"seconds\": " << setprecision(6) << fixed << r.m_time
+            << ", \"ns_per_op\": " << setprecision(2) << r.NsPerOp()
+            << " }";
+    }
+    out << "\n  ]\n}\n";
+}
+
+//----------------------------------------------------------------------------
+
+double FuegoBenchUtil::Time()
+{
+    using namespace std::chrono;
+    return duration<double>(steady_clock::now().time_since_epoch()).count();
+}
+
+//----------------------------------------------------------------------------
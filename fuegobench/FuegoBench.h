@@ -0,0 +1,166 @@
+//----------------------------------------------------------------------------
+/** @file FuegoBench.h
+    Microbenchmark driver for the hot paths of the Fuego libraries. */
+//----------------------------------------------------------------------------
+
+#ifndef FUEGOBENCH_H
+#define FUEGOBENCH_H
+
+#include <iosfwd>
+#include <string>
+#include <vector>
+#include "SgRandomEngine.h"
+
+//----------------------------------------------------------------------------
+
+/** Result of one benchmark case on one board size. */
+struct FuegoBenchResult
+{
+    /** Name of the case, e.g. "GoBoard.PlayUndo".
+        Detail results of a case use names of the form
+        "GoUctPlayoutPolicy.GenerateMove/AtariCapture". */
+    std::string m_name;
+
+    int m_size;
+
+    /** Number of measured calls of FuegoBenchCase::Run() */
+    std::size_t m_iterations;
+
+    /** Number of measured operations. */
+    std::size_t m_nuOps;
+
+    /** Measured time in seconds. */
+    double m_time;
+
+    FuegoBenchResult();
+
+    FuegoBenchResult(const std::string& name, int size,
+                     std::size_t iterations, std::size_t nuOps,
+                     double time);
+
+    /** Time per operation in nanoseconds, zero if no operations. */
+    double NsPerOp() const;
+};
+
+//----------------------------------------------------------------------------
+
+/** A benchmark case.
+    The case is initialized once for each board size with the global random
+    seed (see SgRandom::SetSeed()) and engine (see SgRandom::SetEngine())
+    reset to the seed and engine of the benchmark run, so that the positions
+    and random playouts are reproducible. Run() is called repeatedly, first
+    during warmup, then during the measurement. */
+class FuegoBenchCase
+{
+public:
+    virtual ~FuegoBenchCase();
+
+    /** Name of the case in the output. */
+    virtual std::string Name() const = 0;
+
+    /** Prepare the data for a board size. */
+    virtual void Init(int size) = 0;
+
+    /** Run one iteration.
+        An iteration should take long enough (at least some microseconds)
+        that the time measurement overhead is negligible.
+        @return The number of operations in this iteration */
+    virtual std::size_t Run() = 0;
+
+    /** Clear detail statistics.
+        Called after the warmup. Default implementation does nothing. */
+    virtual void ClearDetails();
+
+    /** Get detail results collected since ClearDetails().
+        For cases that measure parts of an iteration separately.
+        Default implementation adds no results. */
+    virtual void GetDetails(int size,
+                            std::vector<FuegoBenchResult>& results) const;
+};
+
+//----------------------------------------------------------------------------
+
+/** Parameters of a benchmark run. */
+struct FuegoBenchParam
+{
+    /** Board sizes to run each case on. */
+    std::vector<int> m_sizes;
+
+    /** Time in seconds to run each case before measuring. */
+    double m_warmupTime;
+
+    /** Minimum measured time in seconds for each case and size. */
+    double m_minTime;
+
+    /** Random seed used for initializing each case. */
+    int m_seed;
+
+    /** Random engine set before initializing each case.
+        See SgRandom::SetEngine() */
+    SgRandomEngineType m_engine;
+
+    /** Only run cases with names containing this string. */
+    std::string m_filter;
+
+    /** User-defined label written to the output (e.g. a commit ID). */
+    std::string m_label;
+
+    FuegoBenchParam();
+};
+
+//----------------------------------------------------------------------------
+
+/** Runs benchmark cases and writes the results in JSON format. */
+class FuegoBench
+{
+public:
+    FuegoBench(const FuegoBenchParam& param);
+
+    ~FuegoBench();
+
+    /** Add a benchmark case. Takes ownership. */
+    void Add(FuegoBenchCase* benchCase);
+
+    /** Run all matching cases on all board sizes.
+        Prints progress to SgDebug(). */
+    void Run();
+
+    const std::vector<FuegoBenchResult>& Results() const;
+
+    void WriteJson(std::ostream& out) const;
+
+private:
+    FuegoBenchParam m_param;
+
+    std::vector<FuegoBenchCase*> m_cases;
+
+    std::vector<FuegoBenchResult> m_results;
+
+    void RunCase(FuegoBenchCase& benchCase, int size);
+
+    /** Not implemented */
+    FuegoBench(const FuegoBench&);
+
+    /** Not implemented */
+    FuegoBench& operator=(const FuegoBench&);
+};
+
+inline const std::vector<FuegoBenchResult>& FuegoBench::Results() const
+{
+    return m_results;
+}
+
+//----------------------------------------------------------------------------
+
+namespace FuegoBenchUtil
+{
+
+/** Monotonic wall clock time in seconds with high resolution.
+    Unlike SgTime::Get(), it is suitable for timing single calls. */
+double Time();
+
+} // namespace FuegoBenchUtil
+
+//----------------------------------------------------------------------------
+
+#endif // FUEGOBENCH_H
@@ -0,0 +1,1385 @@
+//----------------------------------------------------------------------------
+/** @file FuegoBenchCases.cpp
+    See FuegoBenchCases.h */
+//----------------------------------------------------------------------------
+
+#include "SgSystem.h"
+#include "FuegoBenchCases.h"
+
+#include <limits>
+#include <sstream>
+#include <boost/scoped_ptr.hpp>
+#include "FuegoBench.h"
+#include "GoBensonSolver.h"
+#include "GoBoard.h"
+#include "GoBoardUtil.h"
+#include "GoCfgDistance.h"
+#include "GoLadder.h"
+#include "GoSafetySolver.h"
+#include "GoUctAdditiveKnowledgeGreenpeep.h"
+#include "GoUctAdditiveKnowledgePredictor.h"
+#include "GoUctBoard.h"
+#include "GoUctDefaultMoveFilter.h"
+#include "GoUctDefaultPriorKnowledge.h"
+#include "GoUctGlobalSearch.h"
+#include "GoUctPatterns.h"
+#include "GoUctPlayoutPolicy.h"
+#include "SgDebug.h"
+#include "SgHash.h"
+#include "SgHashTable.h"
+#include "SgRandom.h"
+#include "SgUctTree.h"
+
+using namespace std;
+
+//----------------------------------------------------------------------------
+
+namespace {
+
+typedef GoUctPlayoutPolicy<GoUctBoard> Policy;
+
+typedef GoUctPlayoutPolicyFactory<GoUctBoard> PolicyFactory;
+
+typedef GoUctGlobalSearch<Policy,PolicyFactory> Search;
+
+/** Play random legal moves that do not fill an own eye.
+    Used for creating reproducible middle game positions. */
+void PlayRandomMoves(GoBoard& bd, int nuMoves, SgRandom& random)
+{
+    GoPointList moves;
+    for (int i = 0; i < nuMoves; ++i)
+    {
+        moves.Clear();
+        for (GoBoard::Iterator it(bd); it; ++it)
+            if (  bd.IsEmpty(*it)
+               && bd.IsLegal(*it)
+               && ! GoBoardUtil::IsCompletelySurrounded(bd, *it)
+               )
+                moves.PushBack(*it);
+        if (moves.IsEmpty())
+            break;
+        bd.Play(moves[random.Int(moves.Length())]);
+    }
+}
+
+/** Set up a middle game position with about a third of the board filled. */
+void InitMiddleGame(GoBoard& bd, int size, SgRandom& random)
+{
+    bd.Init(size);
+    // Cheapest ko rule, cases that measure the effect of the ko rule set it
+    // after the setup
+    bd.Rules().SetKoRule(GoRules::SIMPLEKO);
+    PlayRandomMoves(bd, size * size / 3, random);
+}
+
+/** Maximum number of moves in a benchmark playout. */
+int MaxPlayoutLength(const GoUctBoard& bd)
+{
+    return 3 * bd.Size() * bd.Size();
+}
+
+//----------------------------------------------------------------------------
+
+class GoBoardPlayUndoBench
+    : public FuegoBenchCase
+{
+public:
+    /** @param neighborhoodHash Enable GoBoard::SetNeighborhoodHash()
+        @param superko Use the situational superko rule in a position with
+        a long history of moves and captures */
+    GoBoardPlayUndoBench(bool neighborhoodHash, bool superko);
+
+    string Name() const;
+
+    void Init(int size);
+
+    size_t Run();
+
+private:
+    bool m_neighborhoodHash;
+
+    bool m_superko;
+
+    SgRandom m_random;
+
+    GoBoard m_bd;
+
+    GoPointList m_moves;
+};
+
+GoBoardPlayUndoBench::GoBoardPlayUndoBench(bool neighborhoodHash,
+                                           bool superko)
+    : m_neighborhoodHash(neighborhoodHash),
+      m_superko(superko)
+{ }
+
+string GoBoardPlayUndoBench::Name() const
+{
+    if (m_neighborhoodHash)
+        return "GoBoard.PlayUndo/nbhash";
+    if (m_superko)
+        return "GoBoard.PlayUndo/superko";
+    return "GoBoard.PlayUndo";
+}
+
+void GoBoardPlayUndoBench::Init(int size)
+{
+    InitMiddleGame(m_bd, size, m_random);
+    if (m_superko)
+    {
+        PlayRandomMoves(m_bd, 2 * size * size, m_random);
+        m_bd.Rules().SetKoRule(GoRules::SUPERKO);
+    }
+    m_bd.SetNeighborhoodHash(m_neighborhoodHash);
+    m_moves.Clear();
+    for (GoBoard::Iterator it(m_bd); it; ++it)
+        if (m_bd.IsLegal(*it))
+            m_moves.PushBack(*it);
+    SgDebug() << Name() << ": GoBoard::MemoryUsed() " << m_bd.MemoryUsed()
+              << " bytes after " << m_bd.MoveNumber() << " moves\n";
+}
+
+size_t GoBoardPlayUndoBench::Run()
+{
+    for (GoPointList::Iterator it(m_moves); it; ++it)
+    {
+        m_bd.Play(*it);
+        m_bd.Undo();
+    }
+    return m_moves.Length();
+}
+
+//----------------------------------------------------------------------------
+
+class GoBoardCopyFromBench
+    : public FuegoBenchCase
+{
+public:
+    /** @param replay Measure replaying the game instead of
+        GoBoard::CopyFrom() */
+    GoBoardCopyFromBench(bool replay);
+
+    string Name() const;
+
+    void Init(int size);
+
+    size_t Run();
+
+private:
+    static const size_t NU_COPY = 10;
+
+    bool m_replay;
+
+    SgRandom m_random;
+
+    GoBoard m_bd;
+
+    GoBoard m_copy;
+};
+
+GoBoardCopyFromBench::GoBoardCopyFromBench(bool replay)
+    : m_replay(replay)
+{ }
+
+string GoBoardCopyFromBench::Name() const
+{
+    if (m_replay)
+        return "GoBoard.CopyFrom/replay";
+    return "GoBoard.CopyFrom";
+}
+
+void GoBoardCopyFromBench::Init(int size)
+{
+    m_bd.Init(size);
+    PlayRandomMoves(m_bd, 2 * size * size, m_random);
+    SgDebug() << Name() << ": " << m_bd.MoveNumber() << " moves\n";
+}
+
+size_t GoBoardCopyFromBench::Run()
+{
+    for (size_t i = 0; i < NU_COPY; ++i)
+        if (m_replay)
+        {
+            m_copy.Init(m_bd.Size(), m_bd.Rules(), m_bd.Setup());
+            for (int j = 0; j < m_bd.MoveNumber(); ++j)
+                m_copy.Play(m_bd.Move(j));
+        }
+        else
+            m_copy.CopyFrom(m_bd);
+    SG_ASSERT(m_copy.GetHashCode() == m_bd.GetHashCode());
+    return NU_COPY;
+}
+
+//----------------------------------------------------------------------------
+
+class GoUctBoardInitBench
+    : public FuegoBenchCase
+{
+public:
+    string Name() const;
+
+    void Init(int size);
+
+    size_t Run();
+
+private:
+    static const size_t NU_INIT = 100;
+
+    SgRandom m_random;
+
+    GoBoard m_bd;
+
+    boost::scoped_ptr<GoUctBoard> m_uctBd;
+};
+
+string GoUctBoardInitBench::Name() const
+{
+    return "GoUctBoard.Init";
+}
+
+void GoUctBoardInitBench::Init(int size)
+{
+    InitMiddleGame(m_bd, size, m_random);
+    m_uctBd.reset(new GoUctBoard(m_bd));
+}
+
+size_t GoUctBoardInitBench::Run()
+{
+    for (size_t i = 0; i < NU_INIT; ++i)
+        m_uctBd->Init(m_bd);
+    return NU_INIT;
+}
+
+//----------------------------------------------------------------------------
+
+class GoUctBoardPlayBench
+    : public FuegoBenchCase
+{
+public:
+    GoUctBoardPlayBench(bool neighborhoodHash);
+
+    string Name() const;
+
+    void Init(int size);
+
+    size_t Run();
+
+private:
+    bool m_neighborhoodHash;
+
+    SgRandom m_random;
+
+    GoBoard m_bd;
+
+    GoUctPlayoutPolicyParam m_param;
+
+    boost::scoped_ptr<GoUctBoard> m_uctBd;
+
+    /** Moves of a playout from m_bd. */
+    vector<SgPoint> m_sequence;
+};
+
+GoUctBoardPlayBench::GoUctBoardPlayBench(bool neighborhoodHash)
+    : m_neighborhoodHash(neighborhoodHash)
+{ }
+
+string GoUctBoardPlayBench::Name() const
+{
+    return m_neighborhoodHash ? "GoUctBoard.Play/nbhash" : "GoUctBoard.Play";
+}
+
+void GoUctBoardPlayBench::Init(int size)
+{
+    InitMiddleGame(m_bd, size, m_random);
+    m_uctBd.reset(new GoUctBoard(m_bd));
+    Policy policy(*m_uctBd, m_param);
+    policy.StartPlayout();
+    m_sequence.clear();
+    int nuPasses = 0;
+    while (nuPasses < 2
+           && static_cast<int>(m_sequence.size()) < MaxPlayoutLength(*m_uctBd))
+    {
+        SgPoint p = policy.GenerateMove();
+        nuPasses = (p == SG_PASS ? nuPasses + 1 : 0);
+        m_uctBd->Play(p);
+        policy.OnPlay();
+        m_sequence.push_back(p);
+    }
+    policy.EndPlayout();
+    m_bd.SetNeighborhoodHash(m_neighborhoodHash);
+    m_uctBd->SetNeighborhoodHash(m_neighborhoodHash);
+}
+
+size_t GoUctBoardPlayBench::Run()
+{
+    m_uctBd->Init(m_bd);
+    for (vector<SgPoint>::const_iterator it = m_sequence.begin();
+         it != m_sequence.end(); ++it)
+        m_uctBd->Play(*it);
+    return m_sequence.size();
+}
+
+//----------------------------------------------------------------------------
+
+class GoUctPlayoutPolicyPlayoutBench
+    : public FuegoBenchCase
+{
+public:
+    string Name() const;
+
+    void Init(int size);
+
+    size_t Run();
+
+    void ClearDetails();
+
+    void GetDetails(int size, vector<FuegoBenchResult>& results) const;
+
+private:
+    SgRandom m_random;
+
+    GoBoard m_bd;
+
+    GoUctPlayoutPolicyParam m_param;
+
+    boost::scoped_ptr<GoUctBoard> m_uctBd;
+
+    boost::scoped_ptr<Policy> m_policy;
+
+    /** Number of generated moves per move type. */
+    SgArray<size_t,_GOUCT_NU_DEFAULT_PLAYOUT_TYPE> m_nuMoves;
+
+    /** Time of GenerateMove() per returned move type. */
+    SgArray<double,_GOUCT_NU_DEFAULT_PLAYOUT_TYPE> m_time;
+};
+
+void GoUctPlayoutPolicyPlayoutBench::ClearDetails()
+{
+    m_nuMoves.Fill(0);
+    m_time.Fill(0);
+}
+
+void GoUctPlayoutPolicyPlayoutBench::GetDetails(int size,
+                                  vector<FuegoBenchResult>& results) const
+{
+    for (int i = 0; i < _GOUCT_NU_DEFAULT_PLAYOUT_TYPE; ++i)
+        if (m_nuMoves[i] > 0)
+        {
+            GoUctPlayoutPolicyType type =
+                static_cast<GoUctPlayoutPolicyType>(i);
+            results.push_back(FuegoBenchResult(
+                string("GoUctPlayoutPolicy.GenerateMove/")
+                + GoUctPlayoutPolicyTypeStr(type),
+                size, 0, m_nuMoves[i], m_time[i]));
+        }
+}
+
+string GoUctPlayoutPolicyPlayoutBench::Name() const
+{
+    return "GoUctPlayoutPolicy.Playout";
+}
+
+void GoUctPlayoutPolicyPlayoutBench::Init(int size)
+{
+    InitMiddleGame(m_bd, size, m_random);
+    m_uctBd.reset(new GoUctBoard(m_bd));
+    m_policy.reset(new Policy(*m_uctBd, m_param));
+    ClearDetails();
+}
+
+size_t GoUctPlayoutPolicyPlayoutBench::Run()
+{
+    m_uctBd->Init(m_bd);
+    m_policy->StartPlayout();
+    const int maxLength = MaxPlayoutLength(*m_uctBd);
+    int nuPasses = 0;
+    int length = 0;
+    while (nuPasses < 2 && length < maxLength)
+    {
+        double startTime = FuegoBenchUtil::Time();
+        SgPoint p = m_policy->GenerateMove();
+        double time = FuegoBenchUtil::Time() - startTime;
+        GoUctPlayoutPolicyType type = m_policy->MoveType();
+        ++m_nuMoves[type];
+        m_time[type] += time;
+        nuPasses = (p == SG_PASS ? nuPasses + 1 : 0);
+        m_uctBd->Play(p);
+        m_policy->OnPlay();
+        ++length;
+    }
+    m_policy->EndPlayout();
+    return length;
+}
+
+//----------------------------------------------------------------------------
+
+class GoUctPatternsMatchAnyBench
+    : public FuegoBenchCase
+{
+public:
+    GoUctPatternsMatchAnyBench();
+
+    string Name() const;
+
+    void Init(int size);
+
+    size_t Run();
+
+    /** Number of matches. Prevents optimizing away the matching. */
+    size_t m_nuMatches;
+
+private:
+    SgRandom m_random;
+
+    GoBoard m_bd;
+
+    boost::scoped_ptr<GoUctBoard> m_uctBd;
+
+    boost::scoped_ptr<GoUctPatterns<GoUctBoard> > m_patterns;
+
+    GoPointList m_empty;
+};
+
+GoUctPatternsMatchAnyBench::GoUctPatternsMatchAnyBench()
+    : m_nuMatches(0)
+{ }
+
+string GoUctPatternsMatchAnyBench::Name() const
+{
+    return "GoUctPatterns.MatchAny";
+}
+
+void GoUctPatternsMatchAnyBench::Init(int size)
+{
+    InitMiddleGame(m_bd, size, m_random);
+    m_uctBd.reset(new GoUctBoard(m_bd));
+    m_patterns.reset(new GoUctPatterns<GoUctBoard>(*m_uctBd,
+                           GoUctPatterns<GoUctBoard>::PATTERN_LOCAL));
+    m_empty.Clear();
+    for (GoUctBoard::Iterator it(*m_uctBd); it; ++it)
+        if (m_uctBd->IsEmpty(*it))
+            m_empty.PushBack(*it);
+}
+
+size_t GoUctPatternsMatchAnyBench::Run()
+{
+    for (GoPointList::Iterator it(m_empty); it; ++it)
+        if (m_patterns->MatchAny(*it))
+            ++m_nuMatches;
+    return m_empty.Length();
+}
+
+//----------------------------------------------------------------------------
+
+class SgUctSearchSelectChildBench
+    : public FuegoBenchCase
+{
+public:
+    SgUctSearchSelectChildBench();
+
+    string Name() const;
+
+    void Init(int size);
+
+    size_t Run();
+
+private:
+    /** Number of games of the search that builds the tree. */
+    static const int NU_GAMES = 3000;
+
+    GoBoard m_bd;
+
+    GoUctPlayoutPolicyParam m_policyParam;
+
+    GoUctDefaultMoveFilterParam m_treeFilterParam;
+
+    boost::scoped_ptr<Search> m_search;
+
+    vector<const SgUctNode*> m_nodes;
+
+    int m_randomizeCounter;
+};
+
+SgUctSearchSelectChildBench::SgUctSearchSelectChildBench()
+    : m_randomizeCounter(0)
+{ }
+
+string SgUctSearchSelectChildBench::Name() const
+{
+    return "SgUctSearch.SelectChild";
+}
+
+void SgUctSearchSelectChildBench::Init(int size)
+{
+    m_bd.Init(size);
+    m_search.reset(new Search(m_bd, new PolicyFactory(m_policyParam),
+                              m_policyParam, m_treeFilterParam));
+    m_search->SetNumberThreads(1);
+    m_search->SetMaxNodes(20 * NU_GAMES);
+    vector<SgMove> sequence;
+    m_search->Search(NU_GAMES, numeric_limits<double>::max(), sequence);
+    m_nodes.clear();
+    for (SgUctTreeIterator it(m_search->Tree()); it; ++it)
+        if ((*it).HasChildren() && (*it).PosCount() > 0)
+            m_nodes.push_back(&(*it));
+    m_randomizeCounter = m_search->RandomizeRaveFrequency();
+}
+
+size_t SgUctSearchSelectChildBench::Run()
+{
+    for (vector<const SgUctNode*>::const_iterator it = m_nodes.begin();
+         it != m_nodes.end(); ++it)
+        m_search->SelectChild(m_randomizeCounter, true, **it);
+    return m_nodes.size();
+}
+
+//----------------------------------------------------------------------------
+
+/** Short single-threaded searches from a middle game position, as a
+    measure of the throughput of the search. */
+class GoUctGlobalSearchBench
+    : public FuegoBenchCase
+{
+public:
+    /** @param territoryStatistics Enable
+        GoUctGlobalSearchStateParam::m_territoryStatistics */
+    GoUctGlobalSearchBench(bool territoryStatistics);
+
+    string Name() const;
+
+    void Init(int size);
+
+    size_t Run();
+
+private:
+    /** Number of games per search. */
+    static const int NU_GAMES = 500;
+
+    bool m_territoryStatistics;
+
+    SgRandom m_random;
+
+    GoBoard m_bd;
+
+    GoUctPlayoutPolicyParam m_policyParam;
+
+    GoUctDefaultMoveFilterParam m_treeFilterParam;
+
+    boost::scoped_ptr<Search> m_search;
+};
+
+GoUctGlobalSearchBench::GoUctGlobalSearchBench(bool territoryStatistics)
+    : m_territoryStatistics(territoryStatistics)
+{ }
+
+string GoUctGlobalSearchBench::Name() const
+{
+    return m_territoryStatistics ? "GoUctGlobalSearch.Search/territory"
+                                 : "GoUctGlobalSearch.Search";
+}
+
+void GoUctGlobalSearchBench::Init(int size)
+{
+    InitMiddleGame(m_bd, size, m_random);
+    m_search.reset(new Search(m_bd, new PolicyFactory(m_policyParam),
+                              m_policyParam, m_treeFilterParam));
+    m_search->SetNumberThreads(1);
+    m_search->SetMaxNodes(100 * NU_GAMES);
+    m_search->m_param.m_territoryStatistics = m_territoryStatistics;
+}
+
+size_t GoUctGlobalSearchBench::Run()
+{
+    vector<SgMove> sequence;
+    m_search->Search(NU_GAMES, numeric_limits<double>::max(), sequence);
+    return NU_GAMES;
+}
+
+//----------------------------------------------------------------------------
+
+class GoUctGlobalSearchStartBench
+    : public FuegoBenchCase
+{
+public:
+    GoUctGlobalSearchStartBench(unsigned int nuThreads);
+
+    string Name() const;
+
+    void Init(int size);
+
+    size_t Run();
+
+private:
+    unsigned int m_nuThreads;
+
+    /** Index of the game in m_games of the current position. */
+    int m_game;
+
+    SgRandom m_random;
+
+    GoBoard m_bd;
+
+    /** Two different long games, the position alternates between them. */
+    GoBoard m_games[2];
+
+    GoUctPlayoutPolicyParam m_policyParam;
+
+    GoUctDefaultMoveFilterParam m_treeFilterParam;
+
+    boost::scoped_ptr<Search> m_search;
+};
+
+GoUctGlobalSearchStartBench::GoUctGlobalSearchStartBench(
+                                                     unsigned int nuThreads)
+    : m_nuThreads(nuThreads)
+{ }
+
+string GoUctGlobalSearchStartBench::Name() const
+{
+    if (m_nuThreads == 1)
+        return "GoUctGlobalSearch.Start";
+    ostringstream name;
+    name << "GoUctGlobalSearch.Start/" << m_nuThreads << "threads";
+    return name.str();
+}
+
+void GoUctGlobalSearchStartBench::Init(int size)
+{
+    for (int i = 0; i < 2; ++i)
+    {
+        m_games[i].Init(size);
+        PlayRandomMoves(m_games[i], 2 * size * size, m_random);
+    }
+    m_game = 0;
+    m_bd.CopyFrom(m_games[m_game]);
+    m_search.reset(new Search(m_bd, new PolicyFactory(m_policyParam),
+                              m_policyParam, m_treeFilterParam));
+    m_search->SetNumberThreads(m_nuThreads);
+    m_search->SetMaxNodes(1000);
+    // Create the threads and thread states outside of the measurement
+    vector<SgMove> sequence;
+    m_search->Search(1, numeric_limits<double>::max(), sequence);
+}
+
+size_t GoUctGlobalSearchStartBench::Run()
+{
+    m_game = 1 - m_game;
+    m_bd.CopyFrom(m_games[m_game]);
+    vector<SgMove> sequence;
+    m_search->Search(1, numeric_limits<double>::max(), sequence);
+    return 1;
+}
+
+//----------------------------------------------------------------------------
+
+class GoLadderStatusBench
+    : public FuegoBenchCase
+{
+public:
+    string Name() const;
+
+    void Init(int size);
+
+    size_t Run();
+
+private:
+    SgRandom m_random;
+
+    GoBoard m_bd;
+
+    /** Anchors of blocks with one or two liberties. */
+    GoPointList m_prey;
+};
+
+string GoLadderStatusBench::Name() const
+{
+    return "GoLadder.LadderStatus";
+}
+
+void GoLadderStatusBench::Init(int size)
+{
+    InitMiddleGame(m_bd, size, m_random);
+    m_prey.Clear();
+    for (GoBlockIterator it(m_bd); it; ++it)
+        if (m_bd.NumLiberties(*it) <= 2)
+            m_prey.PushBack(*it);
+}
+
+size_t GoLadderStatusBench::Run()
+{
+    for (GoPointList::Iterator it(m_prey); it; ++it)
+        GoLadderUtil::LadderStatus(m_bd, *it);
+    return m_prey.Length();
+}
+
+//----------------------------------------------------------------------------
+
+/** Static safety of all blocks at the end of a random game, in which most
+    blocks have eyes. Includes the setup of the GoRegionBoard. */
+class StaticSafetyBench
+    : public FuegoBenchCase
+{
+public:
+    /** @param benson Use GoBensonSolver instead of GoSafetySolver */
+    StaticSafetyBench(bool benson);
+
+    string Name() const;
+
+    void Init(int size);
+
+    size_t Run();
+
+private:
+    bool m_benson;
+
+    SgRandom m_random;
+
+    GoBoard m_bd;
+
+    /** Prevents that the compiler removes the computation. */
+    int m_sum;
+};
+
+StaticSafetyBench::StaticSafetyBench(bool benson)
+    : m_benson(benson),
+      m_sum(0)
+{ }
+
+string StaticSafetyBench::Name() const
+{
+    return m_benson ? "GoBensonSolver.FindSafePoints"
+                    : "GoSafetySolver.FindSafePoints";
+}
+
+void StaticSafetyBench::Init(int size)
+{
+    InitMiddleGame(m_bd, size, m_random);
+    PlayRandomMoves(m_bd, 3 * size * size, m_random);
+}
+
+size_t StaticSafetyBench::Run()
+{
+    SgBWSet safe;
+    if (m_benson)
+    {
+        GoBensonSolver solver(m_bd);
+        solver.FindSafePoints(&safe);
+    }
+    else
+    {
+        GoSafetySolver solver(m_bd);
+        solver.FindSafePoints(&safe);
+    }
+    m_sum += safe.Both().Size();
+    return 1;
+}
+
+//----------------------------------------------------------------------------
+
+/** CFG distances up to distance 3 from all empty points, as used by the
+    locality bonus of GoUctDefaultPriorKnowledge. */
+class CfgDistanceBench
+    : public FuegoBenchCase
+{
+public:
+    /** @param reuse Use GoCfgDistance instead of GoBoardUtil::CfgDistance()
+        */
+    CfgDistanceBench(bool reuse);
+
+    string Name() const;
+
+    void Init(int size);
+
+    size_t Run();
+
+private:
+    bool m_reuse;
+
+    SgRandom m_random;
+
+    GoBoard m_bd;
+
+    GoCfgDistance m_distance;
+
+    /** Prevents that the compiler removes the computation. */
+    int m_sum;
+};
+
+CfgDistanceBench::CfgDistanceBench(bool reuse)
+    : m_reuse(reuse),
+      m_sum(0)
+{ }
+
+string CfgDistanceBench::Name() const
+{
+    return m_reuse ? "GoCfgDistance.Compute" : "GoBoardUtil.CfgDistance";
+}
+
+void CfgDistanceBench::Init(int size)
+{
+    InitMiddleGame(m_bd, size, m_random);
+}
+
+size_t CfgDistanceBench::Run()
+{
+    size_t n = 0;
+    for (GoBoard::Iterator it(m_bd); it; ++it)
+        if (m_bd.IsEmpty(*it))
+        {
+            if (m_reuse)
+            {
+                m_distance.Compute(m_bd, *it, 3);
+                m_sum += m_distance.Points().Length();
+            }
+            else
+                m_sum += GoBoardUtil::CfgDistance(m_bd, *it, 3)[*it];
+            ++n;
+        }
+    return n;
+}
+
+//----------------------------------------------------------------------------
+
+/** Pattern tables shared by all instances of
+    GoUctAdditiveKnowledgeGreenpeepBench. Created on first use, the tables
+    are large. */
+const GoUctAdditiveKnowledgeParamGreenpeep& GreenpeepParam()
+{
+    static boost::scoped_ptr<GoUctAdditiveKnowledgeParamGreenpeep> param;
+    if (! param)
+        param.reset(new GoUctAdditiveKnowledgeParamGreenpeep());
+    return *param;
+}
+
+/** Base class for benchmarks of the knowledge computed when a node is
+    expanded.
+    Measures the time per expanded position in positions a few moves away
+    from a middle game position, reached by playing and taking back moves
+    as in the in-tree phase of the search. */
+class ExpandBench
+    : public FuegoBenchCase
+{
+public:
+    virtual ~ExpandBench();
+
+    void Init(int size);
+
+    size_t Run();
+
+protected:
+    GoBoard m_bd;
+
+    /** Create the knowledge for m_bd. */
+    virtual void InitKnowledge() = 0;
+
+    virtual void ProcessPosition(vector<SgUctMoveInfo>& moves) = 0;
+
+    /** Called after a move was played on m_bd.
+        Default implementation does nothing. */
+    virtual void OnPlay();
+
+    /** Called before a move is taken back on m_bd.
+        Default implementation does nothing. */
+    virtual void PreUndo();
+
+private:
+    /** Number of expanded positions per Run(). */
+    static const int NU_PATHS = 32;
+
+    /** Maximum number of moves from the start position to an expanded
+        position. */
+    static const int MAX_DEPTH = 8;
+
+    SgRandom m_random;
+
+    /** Moves from the start position to the expanded positions. */
+    vector<vector<SgMove> > m_paths;
+
+    /** Move lists of the expanded positions. */
+    vector<vector<SgUctMoveInfo> > m_moves;
+};
+
+ExpandBench::~ExpandBench()
+{ }
+
+void ExpandBench::Init(int size)
+{
+    InitMiddleGame(m_bd, size, m_random);
+    m_paths.assign(NU_PATHS, vector<SgMove>());
+    m_moves.assign(NU_PATHS, vector<SgUctMoveInfo>());
+    for (int i = 0; i < NU_PATHS; ++i)
+    {
+        const int depth = 1 + m_random.Int(MAX_DEPTH);
+        const int moveNumber = m_bd.MoveNumber();
+        PlayRandomMoves(m_bd, depth, m_random);
+        for (int j = moveNumber; j < m_bd.MoveNumber(); ++j)
+            m_paths[i].push_back(m_bd.Move(j).Point());
+        for (GoBoard::Iterator it(m_bd); it; ++it)
+            if (m_bd.IsEmpty(*it) && m_bd.IsLegal(*it))
+                m_moves[i].push_back(SgUctMoveInfo(*it));
+        m_moves[i].push_back(SgUctMoveInfo(SG_PASS));
+        while (m_bd.MoveNumber() > moveNumber)
+            m_bd.Undo();
+    }
+    InitKnowledge();
+}
+
+void ExpandBench::OnPlay()
+{ }
+
+void ExpandBench::PreUndo()
+{ }
+
+size_t ExpandBench::Run()
+{
+    for (int i = 0; i < NU_PATHS; ++i)
+    {
+        const vector<SgMove>& path = m_paths[i];
+        for (vector<SgMove>::const_iterator it = path.begin();
+             it != path.end(); ++it)
+        {
+            m_bd.Play(*it);
+            OnPlay();
+        }
+        ProcessPosition(m_moves[i]);
+        for (size_t j = 0; j < path.size(); ++j)
+        {
+            PreUndo();
+            m_bd.Undo();
+        }
+    }
+    return NU_PATHS;
+}
+
+//----------------------------------------------------------------------------
+
+class GoUctAdditiveKnowledgeGreenpeepBench
+    : public ExpandBench
+{
+public:
+    GoUctAdditiveKnowledgeGreenpeepBench(bool incremental);
+
+    string Name() const;
+
+protected:
+    void InitKnowledge();
+
+    void ProcessPosition(vector<SgUctMoveInfo>& moves);
+
+private:
+    bool m_incremental;
+
+    boost::scoped_ptr<GoUctAdditiveKnowledgeGreenpeep> m_knowledge;
+};
+
+GoUctAdditiveKnowledgeGreenpeepBench::GoUctAdditiveKnowledgeGreenpeepBench(
+                                                              bool incremental)
+    : m_incremental(incremental)
+{ }
+
+string GoUctAdditiveKnowledgeGreenpeepBench::Name() const
+{
+    return string("GoUctAdditiveKnowledgeGreenpeep.ProcessPosition/")
+        + (m_incremental ? "incremental" : "full");
+}
+
+void GoUctAdditiveKnowledgeGreenpeepBench::InitKnowledge()
+{
+    m_knowledge.reset(new GoUctAdditiveKnowledgeGreenpeep(m_bd,
+                                                          GreenpeepParam()));
+    m_knowledge->SetIncremental(m_incremental);
+}
+
+void GoUctAdditiveKnowledgeGreenpeepBench::ProcessPosition(
+                                                vector<SgUctMoveInfo>& moves)
+{
+    m_knowledge->ProcessPosition(moves);
+}
+
+//----------------------------------------------------------------------------
+
+class GoUctDefaultPriorKnowledgeBench
+    : public ExpandBench
+{
+public:
+    GoUctDefaultPriorKnowledgeBench(bool useUctBoard);
+
+    string Name() const;
+
+protected:
+    void InitKnowledge();
+
+    void ProcessPosition(vector<SgUctMoveInfo>& moves);
+
+private:
+    bool m_useUctBoard;
+
+    GoUctPlayoutPolicyParam m_param;
+
+    boost::scoped_ptr<GoUctDefaultPriorKnowledge> m_knowledge;
+};
+
+GoUctDefaultPriorKnowledgeBench::GoUctDefaultPriorKnowledgeBench(
+                                                              bool useUctBoard)
+    : m_useUctBoard(useUctBoard)
+{ }
+
+string GoUctDefaultPriorKnowledgeBench::Name() const
+{
+    return string("GoUctDefaultPriorKnowledge.ProcessPosition/")
+        + (m_useUctBoard ? "uctboard" : "goboard");
+}
+
+void GoUctDefaultPriorKnowledgeBench::InitKnowledge()
+{
+    m_knowledge.reset(new GoUctDefaultPriorKnowledge(m_bd, m_param));
+    m_knowledge->SetUseUctBoard(m_useUctBoard);
+}
+
+void GoUctDefaultPriorKnowledgeBench::ProcessPosition(
+                                                vector<SgUctMoveInfo>& moves)
+{
+    m_knowledge->ProcessPosition(moves);
+}
+
+//----------------------------------------------------------------------------
+
+class GoUctAdditiveKnowledgePredictorBench
+    : public ExpandBench
+{
+public:
+    /** @param hiddenSize 0 for the default linear weights, otherwise random
+        MLP weights with this hidden size */
+    GoUctAdditiveKnowledgePredictorBench(int hiddenSize);
+
+    string Name() const;
+
+protected:
+    void InitKnowledge();
+
+    void ProcessPosition(vector<SgUctMoveInfo>& moves);
+
+private:
+    int m_hiddenSize;
+
+    GoUctAdditiveKnowledgeParamPredictor m_param;
+
+    boost::scoped_ptr<GoUctAdditiveKnowledgePredictor> m_knowledge;
+};
+
+GoUctAdditiveKnowledgePredictorBench::GoUctAdditiveKnowledgePredictorBench(
+                                                               int hiddenSize)
+    : m_hiddenSize(hiddenSize)
+{
+    if (hiddenSize == 0)
+        return;
+    // The speed does not depend on the values, only a few features are set
+    SgRandom random;
+    ostringstream weights;
+    weights << "fuego_move_predictor 1\nhidden " << hiddenSize << '\n';
+    const char* lines[] = { "hidden_bias", "output", "capture 1",
+                            "dist_last 2", "line 0" };
+    for (size_t i = 0; i < sizeof(lines) / sizeof(lines[0]); ++i)
+    {
+        weights << lines[i];
+        for (int k = 0; k < hiddenSize; ++k)
+            weights << ' ' << (random.Int(2001) - 1000) / 1000.;
+        weights << '\n';
+    }
+    istringstream in(weights.str());
+    m_param.Read(in);
+}
+
+string GoUctAdditiveKnowledgePredictorBench::Name() const
+{
+    ostringstream name;
+    name << "GoUctAdditiveKnowledgePredictor.ProcessPosition/";
+    if (m_hiddenSize == 0)
+        name << "linear";
+    else
+        name << "mlp" << m_hiddenSize;
+    return name.str();
+}
+
+void GoUctAdditiveKnowledgePredictorBench::InitKnowledge()
+{
+    m_knowledge.reset(new GoUctAdditiveKnowledgePredictor(m_bd, m_param));
+}
+
+void GoUctAdditiveKnowledgePredictorBench::ProcessPosition(
+                                                vector<SgUctMoveInfo>& moves)
+{
+    m_knowledge->ProcessPosition(moves);
+}
+
+//----------------------------------------------------------------------------
+
+/** Benchmark of the tree filter of GoUctGlobalSearchState. */
+class GoUctDefaultMoveFilterBench
+    : public ExpandBench
+{
+public:
+    /** @param incremental Report the changes of the board to the filter */
+    GoUctDefaultMoveFilterBench(bool incremental);
+
+    string Name() const;
+
+    /** Number of filtered moves. Prevents optimizing away the filter. */
+    size_t m_nuFiltered;
+
+protected:
+    void InitKnowledge();
+
+    void ProcessPosition(vector<SgUctMoveInfo>& moves);
+
+    void OnPlay();
+
+    void PreUndo();
+
+private:
+    bool m_incremental;
+
+    GoUctDefaultMoveFilterParam m_param;
+
+    boost::scoped_ptr<GoUctDefaultMoveFilter> m_filter;
+};
+
+GoUctDefaultMoveFilterBench::GoUctDefaultMoveFilterBench(bool incremental)
+    : m_nuFiltered(0),
+      m_incremental(incremental)
+{
+    // As in GoUctPlayer
+    m_param.SetCheckSafety(false);
+}
+
+string GoUctDefaultMoveFilterBench::Name() const
+{
+    return string("GoUctDefaultMoveFilter.Get/")
+        + (m_incremental ? "incremental" : "full");
+}
+
+void GoUctDefaultMoveFilterBench::InitKnowledge()
+{
+    m_filter.reset(new GoUctDefaultMoveFilter(m_bd, m_param));
+    if (m_incremental)
+        m_filter->OnBoardChange();
+}
+
+void GoUctDefaultMoveFilterBench::ProcessPosition(
+                                                vector<SgUctMoveInfo>& moves)
+{
+    SG_UNUSED(moves);
+    m_nuFiltered += m_filter->Get().size();
+}
+
+void GoUctDefaultMoveFilterBench::OnPlay()
+{
+    m_filter->OnPlay();
+}
+
+void GoUctDefaultMoveFilterBench::PreUndo()
+{
+    m_filter->PreUndo();
+}
+
+//----------------------------------------------------------------------------
+
+/** Hash table data for SgHashTableStoreLookup. */
+struct HashData
+{
+    int m_value;
+
+    HashData();
+
+    explicit HashData(int value);
+
+    void AgeData();
+
+    void Invalidate();
+
+    bool IsBetterThan(const HashData& data) const;
+
+    bool IsValid() const;
+};
+
+HashData::HashData()
+    : m_value(-1)
+{ }
+
+HashData::HashData(int value)
+    : m_value(value)
+{ }
+
+void HashData::AgeData()
+{ }
+
+void HashData::Invalidate()
+{
+    m_value = -1;
+}
+
+bool HashData::IsBetterThan(const HashData& data) const
+{
+    return m_value > data.m_value;
+}
+
+bool HashData::IsValid() const
+{
+    return m_value >= 0;
+}
+
+class SgHashTableStoreLookupBench
+    : public FuegoBenchCase
+{
+public:
+    string Name() const;
+
+    void Init(int size);
+
+    size_t Run();
+
+private:
+    /** Number of table entries (a typical transposition table size). */
+    static const int MAX_HASH = 1 << 16;
+
+    /** Number of hash codes. Twice the table size to cause collisions. */
+    static const int NU_CODES = 2 * MAX_HASH;
+
+    boost::scoped_ptr<SgHashTable<HashData,4> > m_table;
+
+    vector<SgHashCode> m_codes;
+};
+
+string SgHashTableStoreLookupBench::Name() const
+{
+    return "SgHashTable.StoreLookup";
+}
+
+void SgHashTableStoreLookupBench::Init(int size)
+{
+    // Table does not depend on the board size
+    SG_UNUSED(size);
+    m_table.reset(new SgHashTable<HashData,4>(MAX_HASH));
+    m_codes.clear();
+    for (int i = 0; i < NU_CODES; ++i)
+        m_codes.push_back(SgHashCode::Random());
+}
+
+size_t SgHashTableStoreLookupBench::Run()
+{
+    for (int i = 0; i < NU_CODES; ++i)
+        m_table->Store(m_codes[i], HashData(i));
+    HashData data;
+    for (int i = 0; i < NU_CODES; ++i)
+        m_table->Lookup(m_codes[i], &data);
+    return 2 * NU_CODES;
+}
+
+//----------------------------------------------------------------------------
+
+class SgRandomPlayoutBench
+    : public FuegoBenchCase
+{
+public:
+    SgRandomPlayoutBench(SgRandomEngineType engine);
+
+    string Name() const;
+
+    void Init(int size);
+
+    size_t Run();
+
+private:
+    SgRandomEngineType m_engine;
+
+    SgRandom m_random;
+
+    GoBoard m_bd;
+
+    GoUctPlayoutPolicyParam m_param;
+
+    boost::scoped_ptr<GoUctBoard> m_uctBd;
+
+    boost::scoped_ptr<Policy> m_policy;
+};
+
+SgRandomPlayoutBench::SgRandomPlayoutBench(SgRandomEngineType engine)
+    : m_engine(engine)
+{ }
+
+string SgRandomPlayoutBench::Name() const
+{
+    return string("SgRandom.Playout/") + SgRandomEngineTypeStr(m_engine);
+}
+
+void SgRandomPlayoutBench::Init(int size)
+{
+    // Same position for all engines
+    InitMiddleGame(m_bd, size, m_random);
+    SgRandom::SetEngine(m_engine);
+    m_uctBd.reset(new GoUctBoard(m_bd));
+    m_policy.reset(new Policy(*m_uctBd, m_param));
+}
+
+size_t SgRandomPlayoutBench::Run()
+{
+    m_uctBd->Init(m_bd);
+    m_policy->StartPlayout();
+    const int maxLength = MaxPlayoutLength(*m_uctBd);
+    int nuPasses = 0;
+    int length = 0;
+    while (nuPasses < 2 && length < maxLength)
+    {
+        SgPoint p = m_policy->GenerateMove();
+        nuPasses = (p == SG_PASS ? nuPasses + 1 : 0);
+        m_uctBd->Play(p);
+        m_policy->OnPlay();
+        ++length;
+    }
+    m_policy->EndPlayout();
+    return 1;
+}
+
+} // namespace
+
+//----------------------------------------------------------------------------
+
+void FuegoBenchCases::AddAll(FuegoBench& bench)
+{
+    bench.Add(new GoBoardPlayUndoBench(false, false));
+    bench.Add(new GoBoardPlayUndoBench(true, false));
+    bench.Add(new GoBoardPlayUndoBench(false, true));
+    bench.Add(new GoBoardCopyFromBench(false));
+    bench.Add(new GoBoardCopyFromBench(true));
+    bench.Add(new GoUctBoardInitBench());
+    bench.Add(new GoUctBoardPlayBench(false));
+    bench.Add(new GoUctBoardPlayBench(true));
+    bench.Add(new GoUctPlayoutPolicyPlayoutBench());
+    bench.Add(new GoUctPatternsMatchAnyBench());
+    bench.Add(new SgUctSearchSelectChildBench());
+    bench.Add(new GoUctGlobalSearchBench(false));
+    bench.Add(new GoUctGlobalSearchBench(true));
+    bench.Add(new GoUctGlobalSearchStartBench(1));
+    bench.Add(new GoUctGlobalSearchStartBench(4));
+    bench.Add(new GoUctGlobalSearchStartBench(16));
+    bench.Add(new GoUctGlobalSearchStartBench(64));
+    bench.Add(new GoLadderStatusBench());
+    bench.Add(new StaticSafetyBench(true));
+    bench.Add(new StaticSafetyBench(false));
+    bench.Add(new CfgDistanceBench(false));
+    bench.Add(new CfgDistanceBench(true));
+    bench.Add(new GoUctAdditiveKnowledgeGreenpeepBench(true));
+    bench.Add(new GoUctAdditiveKnowledgeGreenpeepBench(false));
+    bench.Add(new GoUctDefaultPriorKnowledgeBench(true));
+    bench.Add(new GoUctDefaultPriorKnowledgeBench(false));
+    bench.Add(new GoUctAdditiveKnowledgePredictorBench(0));
+    bench.Add(new GoUctAdditiveKnowledgePredictorBench(16));
+    bench.Add(new GoUctDefaultMoveFilterBench(true));
+    bench.Add(new GoUctDefaultMoveFilterBench(false));
+    bench.Add(new SgHashTableStoreLookupBench());
+    for (int i = 0; i < _SG_NU_RANDOM_ENGINE; ++i)
+        bench.Add(new SgRandomPlayoutBench(
+                                      static_cast<SgRandomEngineType>(i)));
+}
+
+//----------------------------------------------------------------------------
@@ -0,0 +1,91 @@
+//----------------------------------------------------------------------------
+/** @file FuegoBenchCases.h
+    Benchmark cases of FuegoBench. */
+//----------------------------------------------------------------------------
+
+#ifndef FUEGOBENCH_CASES_H
+#define FUEGOBENCH_CASES_H
+
+class FuegoBench;
+
+//----------------------------------------------------------------------------
+
+namespace FuegoBenchCases
+{
+
+/** Add all benchmark cases.
+    The cases are:
+    - @c GoBoard.PlayUndo GoBoard::Play() and GoBoard::Undo() of all legal
+      moves in a middle game position (simple ko rule). Detail result
+      @c GoBoard.PlayUndo/nbhash with neighborhood hash codes enabled (see
+      GoBoard::SetNeighborhoodHash()), @c GoBoard.PlayUndo/superko with
+      the situational superko rule in a position after a random game with
+      more than twice as many moves as points on the board. Writes
+      GoBoard::MemoryUsed() in the position to SgDebug().
+    - @c GoBoard.CopyFrom GoBoard::CopyFrom() of a position after a random
+      game with more than twice as many moves as points on the board.
+      Detail result @c GoBoard.CopyFrom/replay with GoBoard::Init() and
+      GoBoard::Play() of the moves of the game instead.
+    - @c GoUctBoard.Init GoUctBoard::Init() from a middle game position
+    - @c GoUctBoard.Play GoUctBoard::Play() of the moves of a recorded
+      playout (including one GoUctBoard::Init() per playout). Detail
+      result @c GoUctBoard.Play/nbhash with neighborhood hash codes
+      enabled.
+    - @c GoUctPlayoutPolicy.Playout Playouts with GoUctPlayoutPolicy
+      (time per move, including playing the move and the timing of the
+      single GoUctPlayoutPolicy::GenerateMove() calls). Detail results
+      @c GoUctPlayoutPolicy.GenerateMove/<type> contain the time of
+      GoUctPlayoutPolicy::GenerateMove() per returned move type.
+    - @c GoUctPatterns.MatchAny GoUctPatterns::MatchAny() on all empty
+      points of a middle game position
+    - @c SgUctSearch.SelectChild SgUctSearch::SelectChild() on all expanded
+      nodes of a tree built by a short GoUctGlobalSearch
+    - @c GoUctGlobalSearch.Search Single-threaded searches of 500 games
+      from a middle game position (time per game). Detail result
+      @c GoUctGlobalSearch.Search/territory with territory statistics
+      enabled.
+    - @c GoUctGlobalSearch.Start Latency of a GoUctGlobalSearch of a
+      single game after the position changed to a different long game, as
+      after a loadsgf command (time per search, including updating the
+      thread states to the new position). Detail results
+      @c GoUctGlobalSearch.Start/<n>threads with n threads.
+    - @c GoLadder.LadderStatus GoLadderUtil::LadderStatus() for all blocks
+      with one or two liberties in a middle game position
+    - @c GoBensonSolver.FindSafePoints, @c GoSafetySolver.FindSafePoints
+      Static safety of all blocks at the end of a random game (time per
+      position, including the setup of the GoRegionBoard)
+    - @c GoBoardUtil.CfgDistance, @c GoCfgDistance.Compute CFG distances
+      up to distance 3 from each empty point of a middle game position
+      with GoBoardUtil::CfgDistance() and GoCfgDistance::Compute()
+    - @c GoUctAdditiveKnowledgeGreenpeep.ProcessPosition/<mode>
+      GoUctAdditiveKnowledgeGreenpeep::ProcessPosition() (time per expanded
+      position) in positions a few moves away from a middle game position,
+      reached by playing and taking back moves as in the in-tree phase of
+      the search. Mode @c incremental updates the contexts of the changed
+      points only, mode @c full computes all contexts from scratch.
+    - @c GoUctDefaultPriorKnowledge.ProcessPosition/<board>
+      GoUctDefaultPriorKnowledge::ProcessPosition() in the same positions.
+      Board @c uctboard runs the playout policy and the scans on a
+      GoUctBoard copy of the position, @c goboard on the GoBoard.
+    - @c GoUctAdditiveKnowledgePredictor.ProcessPosition/<model>
+      GoUctAdditiveKnowledgePredictor::ProcessPosition() in the same
+      positions. Model @c linear uses the default weights, @c mlp16 random
+      weights with a hidden layer of size 16.
+    - @c GoUctDefaultMoveFilter.Get/<mode> GoUctDefaultMoveFilter::Get()
+      with the parameters of the tree filter of GoUctPlayer in the same
+      positions. Mode @c incremental reports the moves played and taken
+      back to the filter, mode @c full computes all results at each call.
+    - @c SgHashTable.StoreLookup SgHashTable::Store() and
+      SgHashTable::Lookup() of random hash codes in a table with more
+      codes than entries
+    - @c SgRandom.Playout/<engine> Playouts with GoUctPlayoutPolicy (time
+      per playout) using the random engine @c engine for all instances of
+      SgRandom (see SgRandom::SetEngine()). The position is the same for
+      all engines. */
+void AddAll(FuegoBench& bench);
+
+} // namespace FuegoBenchCases
+
+//----------------------------------------------------------------------------
+
+#endif // FUEGOBENCH_CASES_H
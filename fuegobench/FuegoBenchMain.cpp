@@ -0,0 +1,153 @@
+//----------------------------------------------------------------------------
+/** @file FuegoBenchMain.cpp
+    Main function for FuegoBench. */
+//----------------------------------------------------------------------------
+
+#include "SgSystem.h"
+
+#include <fstream>
+#include <iostream>
+#include "FuegoBench.h"
+#include "FuegoBenchCases.h"
+#include "GoInit.h"
+#include "SgDebug.h"
+#include "SgException.h"
+#include "SgInit.h"
+#include "SgPoint.h"
+
+#include <boost/utility.hpp>
+#include <boost/program_options/options_description.hpp>
+#include <boost/program_options/cmdline.hpp>
+#include <boost/program_options/variables_map.hpp>
+#include <boost/program_options/parsers.hpp>
+
+using std::string;
+namespace po = boost::program_options;
+
+//----------------------------------------------------------------------------
+
+namespace {
+
+/** @name Settings from command line options */
+// @{
+
+FuegoBenchParam g_param;
+
+/** File for the JSON output. Standard output if empty. */
+string g_output;
+
+// @} // @name
+
+void Help(po::options_description& desc)
+{
+    std::cout << "Options:\n" << desc << '\n';
+    exit(1);
+}
+
+void ParseOptions(int argc, char** argv)
+{
+    std::vector<int> sizes;
+    std::string engine;
+    po::options_description desc;
+    desc.add_options()
+        ("filter",
+         po::value<std::string>(&g_param.m_filter)->default_value(""),
+         "only run benchmarks with names containing this string")
+        ("help", "displays this help and exit")
+        ("label",
+         po::value<std::string>(&g_param.m_label)->default_value(""),
+         "label written to the output, e.g. a commit ID")
+        ("output",
+         po::value<std::string>(&g_output)->default_value(""),
+         "write results in JSON format to this file (default: stdout)")
+        ("random-engine",
+         po::value<std::string>(&engine)->default_value("mt19937"),
+         "random engine (mt19937, xoshiro128, pcg32)")
+        ("size",
+         po::value<std::vector<int> >(&sizes)->composing(),
+         "board size, can be used multiple times (default: 9, 13, 19)")
+        ("srand",
+         po::value<int>(&g_param.m_seed)->default_value(1),
+         "random seed for the positions and playouts (must not be 0)")
+        ("time",
+         po::value<double>(&g_param.m_minTime)->default_value(1),
+         "minimum measured time per benchmark and size in seconds")
+        ("warmup",
+         po::value<double>(&g_param.m_warmupTime)->default_value(0.2),
+         "warmup time per benchmark and size in seconds");
+    po::variables_map vm;
+    try
+    {
+        po::store(po::parse_command_line(argc, argv, desc), vm);
+        po::notify(vm);
+    }
+    catch (...)
+    {
+        Help(desc);
+    }
+    if (vm.count("help"))
+        Help(desc);
+    if (! SgRandomEngineTypeFromStr(engine.c_str(), g_param.m_engine))
+        throw SgException("unknown random engine " + engine);
+    if (g_param.m_seed == 0)
+        throw SgException("random seed 0 is not reproducible");
+    if (! sizes.empty())
+    {
+        for (std::vector<int>::const_iterator it = sizes.begin();
+             it != sizes.end(); ++it)
+            if (*it < SG_MIN_SIZE || *it > SG_MAX_SIZE)
+                throw SgException("invalid board size");
+        g_param.m_sizes = sizes;
+    }
+    else
+    {
+        // Drop default sizes that are not supported by this build
+        std::vector<int> defaultSizes;
+        defaultSizes.swap(g_param.m_sizes);
+        for (std::vector<int>::const_iterator it = defaultSizes.begin();
+             it != defaultSizes.end(); ++it)
+            if (*it <= SG_MAX_SIZE)
+                g_param.m_sizes.push_back(*it);
+    }
+}
+
+void MainLoop()
+{
+    FuegoBench bench(g_param);
+    FuegoBenchCases::AddAll(bench);
+    bench.Run();
+    if (g_output.empty())
+        bench.WriteJson(std::cout);
+    else
+    {
+        std::ofstream out(g_output.c_str());
+        if (! out)
+            throw SgException("could not open " + g_output);
+        bench.WriteJson(out);
+    }
+}
+
+} // namespace
+
+//----------------------------------------------------------------------------
+
+int main(int argc, char** argv)
+{
+    try
+    {
+        ParseOptions(argc, argv);
+        SgInit();
+        GoInit();
+        MainLoop();
+        GoFini();
+        SgFini();
+    }
+    catch (const std::exception& e)
+    {
+        SgDebug() << e.what() << '\n';
+        return 1;
+    }
+    return 0;
+}
+
+//----------------------------------------------------------------------------
@@ -18,6 +18,7 @@
 #include "FuegoMainEngine.h"
 #include "FuegoMainUtil.h"
 #include "GoInit.h"
+#include "GoUctPatternFile.h"
 #include "SgDebug.h"
 #include "SgException.h"
 #include "SgInit.h"
@@ -54,6 +55,9 @@ const char* g_programPath;
 
 int g_srand;
 
+/** Pattern file. If empty, FuegoMainUtil::LoadPatterns() is used. */
+string g_patterns;
+
 vector<string> g_inputFiles;
 
 // @} // @name
@@ -105,6 +109,10 @@ void ParseOptions(int argc, char** argv)
          "make clear_board fail after n invocations")
         ("nobook", "don't automatically load opening book")
         ("nohandicap", "don't support handicap commands")
+        ("patterns",
+         po::value<std::string>(&g_patterns)->default_value(""),
+         "load pattern tables from file (default: fuego-patterns.dat in "
+         "program or data directory, compiled-in patterns if not found)")
         ("quiet", "don't print debug messages")
         ("srand", 
          po::value<int>(&g_srand)->default_value(0),
@@ -180,6 +188,11 @@ int main(int argc, char** argv)
         GoInit();
         PrintStartupMessage();
         SgRandom::SetSeed(g_srand);
+        // Before the engine creates any pattern tables
+        if (g_patterns != "")
+            GoUctPatternFile::Load(g_patterns);
+        else
+            FuegoMainUtil::LoadPatterns(SgPlatform::GetProgramDir());
         FuegoMainEngine engine(g_fixedBoardSize, g_programPath, ! g_allowHandicap);
         GoGtpAssertionHandler assertionHandler(engine);
         if (g_maxGames >= 0)
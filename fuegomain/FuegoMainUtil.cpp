@@ -10,6 +10,7 @@
 #include <fstream>
 #include <sstream>
 #include "GoBook.h"
+#include "GoUctPatternFile.h"
 #include "SgDebug.h"
 #include "SgStringUtil.h"
 
@@ -42,6 +43,25 @@ bool LoadBookFile(GoBook& book, const path& file)
     return true;
 }
 
+bool LoadPatternFile(const path& file)
+{
+    std::string nativeFile = SgStringUtil::GetNativeFileName(file);
+    if (! exists(file))
+        return false;
+    SgDebug() << "Loading pattern file '" << nativeFile << "'... ";
+    try
+    {
+        GoUctPatternFile::Load(nativeFile);
+    }
+    catch (const SgException& e)
+    {
+        SgDebug() << "error: " << e.what() << '\n';
+        return false;
+    }
+    SgDebug() << "ok\n";
+    return true;
+}
+
 } // namespace
 
 //----------------------------------------------------------------------------
@@ -63,6 +83,18 @@ void FuegoMainUtil::LoadBook(GoBook& book,
     throw SgException("Could not find opening book.");
 }
 
+void FuegoMainUtil::LoadPatterns(const boost::filesystem::path& programDir)
+{
+    const std::string fileName = "fuego-patterns.dat";
+    if (LoadPatternFile(programDir / fileName))
+        return;
+    #if defined(DATADIR) && defined(PACKAGE)
+        if (LoadPatternFile(path(DATADIR) / PACKAGE / fileName))
+            return;
+    #endif
+    SgDebug() << "Using compiled-in patterns\n";
+}
+
 std::string FuegoMainUtil::Version()
 {
     std::ostringstream s;
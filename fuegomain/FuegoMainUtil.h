@@ -27,6 +27,17 @@ namespace FuegoMainUtil
         @throws SgException, if book is not found */
     void LoadBook(GoBook& book, const path& programDir);
 
+    /** Try to load the pattern file (see GoUctPatternFile) from a set of
+        known paths.
+        The file name is "fuego-patterns.dat". The paths tried are (in this
+        order):
+        - the directory of the executable
+        - DATADIR/PACKAGE
+        If no valid file is found, the compiled-in patterns are used.
+        @param programDir the directory of the executable (may be a relative
+        path or an empty string) */
+    void LoadPatterns(const path& programDir);
+
     /** Return Fuego version.
         If the macro VERSION was defined by the build system during compile
         time, its value is used as the version, otherwise the version
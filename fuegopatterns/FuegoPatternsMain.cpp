@@ -0,0 +1,105 @@
+//----------------------------------------------------------------------------
+/** @file FuegoPatternsMain.cpp
+    Main function for the generator of pattern files.
+    Writes the compiled-in pattern tables to a file in the format of
+    GoUctPatternFile. */
+//----------------------------------------------------------------------------
+
+#include "SgSystem.h"
+
+#include <iostream>
+#include <boost/scoped_ptr.hpp>
+#include "GoInit.h"
+#include "GoUctAdditiveKnowledgeGreenpeep.h"
+#include "GoUctPatternData.h"
+#include "GoUctPatternFile.h"
+#include "SgDebug.h"
+#include "SgException.h"
+#include "SgInit.h"
+
+#include <boost/program_options/options_description.hpp>
+#include <boost/program_options/cmdline.hpp>
+#include <boost/program_options/variables_map.hpp>
+#include <boost/program_options/parsers.hpp>
+
+using std::string;
+namespace po = boost::program_options;
+
+//----------------------------------------------------------------------------
+
+namespace {
+
+/** @name Settings from command line options */
+// @{
+
+string g_output;
+
+// @} // @name
+
+void Help(po::options_description& desc)
+{
+    std::cout << "Options:\n" << desc << '\n';
+    exit(1);
+}
+
+void ParseOptions(int argc, char** argv)
+{
+    po::options_description desc;
+    desc.add_options()
+        ("help", "displays this help and exit")
+        ("output",
+         po::value<std::string>(&g_output)->default_value(
+                                                     "fuego-patterns.dat"),
+         "the pattern file to write");
+    po::variables_map vm;
+    try
+    {
+        po::store(po::parse_command_line(argc, argv, desc), vm);
+        po::notify(vm);
+    }
+    catch (...)
+    {
+        Help(desc);
+    }
+    if (vm.count("help"))
+        Help(desc);
+}
+
+void MainLoop()
+{
+    GoUctPatternFileWriter writer;
+    GoUctPatternData::AddToPatternFile(writer);
+    // Large tables, allocate on the heap
+    boost::scoped_ptr<GoUctAdditiveKnowledgeParamGreenpeep>
+        greenpeep(new GoUctAdditiveKnowledgeParamGreenpeep(false));
+    greenpeep->AddToPatternFile(writer);
+    writer.Write(g_output);
+    // Check that the file can be read
+    GoUctPatternFile file(g_output);
+    SgDebug() << "Wrote " << g_output << '\n';
+}
+
+} // namespace
+
+//----------------------------------------------------------------------------
+
+int main(int argc, char** argv)
+{
+    try
+    {
+        ParseOptions(argc, argv);
+        SgInit();
+        GoInit();
+        MainLoop();
+        GoFini();
+        SgFini();
+    }
+    catch (const std::exception& e)
+    {
+        SgDebug() << e.what() << '\n';
+        return 1;
+    }
+    return 0;
+}
+
+//----------------------------------------------------------------------------
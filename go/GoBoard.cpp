@@ -9,6 +9,7 @@
 #include <boost/static_assert.hpp>
 #include <algorithm>
 #include "GoInit.h"
+#include "GoNeighborhoodHash.h"
 #include "SgNbIterator.h"
 #include "SgStack.h"
 
@@ -36,23 +37,14 @@ void UpdateChanges(SgPoint p, SgArrayList<SgPoint,SG_MAXPOINT>& changes,
 //----------------------------------------------------------------------------
 
 GoBoard::GoBoard(int size, const GoSetup& setup, const GoRules& rules)
-    : m_snapshot(new Snapshot()),
-      m_const(size),
-      m_blockList(new SgArrayList<Block,GO_MAX_NUM_MOVES>()),
-      m_moves(new SgArrayList<StackEntry,GO_MAX_NUM_MOVES>())
-
+    : m_const(size)
 {
     GoInitCheck();
     Init(size, rules, setup);
 }
 
 GoBoard::~GoBoard()
-{
-    delete m_blockList;
-    m_blockList = 0;
-    delete m_moves;
-    m_moves = 0;
-}
+{ }
 
 void GoBoard::CheckConsistency() const
 {
@@ -215,11 +207,81 @@ void GoBoard::AddStoneToBlock(SgPoint p, SgBlackWhite c, Block* block,
     m_state.m_block[p] = block;
 }
 
+GoBoard::Block* GoBoard::CopiedBlock(const GoBoard& bd, const Block* block)
+{
+    if (block == 0)
+        return 0;
+    return &m_blockList[bd.m_blockList.Index(block)];
+}
+
+void GoBoard::CopyFrom(const GoBoard& bd)
+{
+    if (&bd == this)
+        return;
+    m_size = bd.m_size;
+    m_const.ChangeSize(m_size);
+    m_rules = bd.m_rules;
+    m_setup = bd.m_setup;
+    m_moveInfo = bd.m_moveInfo;
+    m_capturedStones = bd.m_capturedStones;
+    m_allowAnyRepetition = bd.m_allowAnyRepetition;
+    m_allowKoRepetition = bd.m_allowKoRepetition;
+    m_koModifiesHash = bd.m_koModifiesHash;
+    m_koColor = bd.m_koColor;
+    m_koLoser = bd.m_koLoser;
+    m_isBorder = bd.m_isBorder;
+    m_state = bd.m_state;
+    // Blocks are copied at the same positions in the block stack, pointers
+    // to blocks are translated with CopiedBlock()
+    const int nuBlocks = bd.m_blockList.Length();
+    m_blockList.Resize(nuBlocks);
+    for (int i = 0; i < nuBlocks; ++i)
+        m_blockList[i] = bd.m_blockList[i];
+    const Block* lastBlock = 0;
+    Block* lastCopiedBlock = 0;
+    for (SgPoint p = 0; p < SG_MAXPOINT; ++p)
+    {
+        const Block* block = bd.m_state.m_block[p];
+        if (block == 0)
+            continue;
+        // Adjacent points often belong to the same block
+        if (block != lastBlock)
+        {
+            lastBlock = block;
+            lastCopiedBlock = CopiedBlock(bd, block);
+        }
+        m_state.m_block[p] = lastCopiedBlock;
+    }
+    const int nuMoves = bd.m_moves.Length();
+    m_moves.Resize(nuMoves);
+    for (int i = 0; i < nuMoves; ++i)
+    {
+        StackEntry& entry = m_moves[i];
+        entry = bd.m_moves[i];
+        entry.m_stoneAddedTo = CopiedBlock(bd, entry.m_stoneAddedTo);
+        entry.m_suicide = CopiedBlock(bd, entry.m_suicide);
+    }
+    m_blockRefs.resize(bd.m_blockRefs.size());
+    for (std::size_t i = 0; i < m_blockRefs.size(); ++i)
+        m_blockRefs[i] = CopiedBlock(bd, bd.m_blockRefs[i]);
+    m_hashHistory.CopyFrom(bd.m_hashHistory);
+    if (m_snapshot)
+        m_snapshot->m_moveNumber = -1;
+    if (m_neighborhoodHash)
+    {
+        if (bd.m_neighborhoodHash)
+            *m_neighborhoodHash = *bd.m_neighborhoodHash;
+        else
+            m_neighborhoodHash->Init(*this);
+    }
+    CheckConsistency();
+}
+
 GoBoard::Block& GoBoard::CreateNewBlock()
 {
     // Reuse without initialization
-    m_blockList->Resize(m_blockList->Length() + 1);
-    Block& block = m_blockList->Last();
+    m_blockList.Resize(m_blockList.Length() + 1);
+    Block& block = m_blockList.Last();
     return block;
 }
 
@@ -361,7 +423,6 @@ void GoBoard::UpdateBlocksAfterAddStone(SgPoint p, SgBlackWhite c,
     {
         entry.m_stoneAddedTo = 0;
         CreateSingleStoneBlock(p, c);
-        entry.m_merged.Clear();
     }
     else
     {
@@ -376,7 +437,10 @@ void GoBoard::UpdateBlocksAfterAddStone(SgPoint p, SgBlackWhite c,
         {
             entry.m_stoneAddedTo = 0;
             MergeBlocks(p, c, adjBlocks);
-            entry.m_merged = adjBlocks;
+            for (SgArrayList<Block*,4>::Iterator it(adjBlocks); it; ++it)
+                m_blockRefs.push_back(*it);
+            entry.m_nuMerged =
+                static_cast<unsigned char>(adjBlocks.Length());
         }
     }
 }
@@ -403,16 +467,18 @@ void GoBoard::UpdateBlocksAfterUndo(const StackEntry& entry)
     }
     else
     {
-        for (SgArrayList<Block*,4>::Iterator it(entry.m_merged); it; ++it)
+        const int firstMerged = entry.m_firstBlockRef + entry.m_nuKilled;
+        for (int i = firstMerged; i < firstMerged + entry.m_nuMerged; ++i)
         {
-            Block* block = *it;
+            Block* block = m_blockRefs[i];
             for (Block::StoneIterator stn(block->Stones()); stn; ++stn)
                 m_state.m_block[*stn] = block;
         }
-        m_blockList->PopBack();
+        m_blockList.PopBack();
     }
-    for (SgArrayList<Block*,4>::Iterator it(entry.m_killed); it; ++it)
-        RestoreKill(*it, SgOppBW(entry.m_color));
+    for (int i = entry.m_firstBlockRef;
+         i < entry.m_firstBlockRef + entry.m_nuKilled; ++i)
+        RestoreKill(m_blockRefs[i], SgOppBW(entry.m_color));
     AddLibToAdjBlocks(p);
 }
 
@@ -422,7 +488,10 @@ void GoBoard::Init(int size, const GoRules& rules, const GoSetup& setup)
     m_size = size;
     SG_ASSERTRANGE(m_size, SG_MIN_SIZE, SG_MAX_SIZE);
     m_state.m_hash.Clear();
-    m_moves->Clear();
+    m_state.m_positionHash.Clear();
+    m_moves.Clear();
+    m_blockRefs.clear();
+    m_hashHistory.Clear();
     m_state.m_prisoners[SG_BLACK] = 0;
     m_state.m_prisoners[SG_WHITE] = 0;
     m_state.m_numStones[SG_BLACK] = 0;
@@ -443,6 +512,8 @@ void GoBoard::Init(int size, const GoRules& rules, const GoSetup& setup)
     }
     m_state.m_isFirst.Fill(true);
     m_state.m_isNewPosition = true;
+    if (m_neighborhoodHash)
+        m_neighborhoodHash->Init(m_size);
     for (SgGrid row = 1; row <= m_size; ++row)
         for (SgGrid col = 1; col <= m_size; ++col)
         {
@@ -477,10 +548,11 @@ void GoBoard::Init(int size, const GoRules& rules, const GoSetup& setup)
             AddStone(p, *c);
             ++m_state.m_numStones[*c];
             m_state.m_hash.XorStone(p, *c);
+            m_state.m_positionHash.XorStone(p, *c);
             m_state.m_isFirst[p] = false;
         }
     m_state.m_toPlay = setup.m_player;
-    m_blockList->Clear();
+    m_blockList.Clear();
     m_state.m_block.Fill(0);
     for (GoBoard::Iterator it(*this); it; ++it)
     {
@@ -491,7 +563,8 @@ void GoBoard::Init(int size, const GoRules& rules, const GoSetup& setup)
             InitBlock(block, c, *it);
         }
     }
-    m_snapshot->m_moveNumber = -1;
+    if (m_snapshot)
+        m_snapshot->m_moveNumber = -1;
     CheckConsistency();
 }
 
@@ -525,9 +598,24 @@ void GoBoard::InitBlock(GoBoard::Block& block, SgBlackWhite c, SgPoint anchor)
     block.Init(c, anchor, stones, liberties);
 }
 
+std::size_t GoBoard::MemoryUsed() const
+{
+    std::size_t bytes = sizeof(GoBoard)
+        + m_moves.Capacity() * sizeof(StackEntry)
+        + m_blockList.Capacity() * sizeof(Block)
+        + m_blockRefs.capacity() * sizeof(Block*);
+    if (m_snapshot)
+        bytes += sizeof(Snapshot)
+            + m_snapshot->m_blockPointers.capacity() * sizeof(Block*)
+            + m_snapshot->m_blocks.capacity() * sizeof(Block);
+    if (m_neighborhoodHash)
+        bytes += sizeof(GoNeighborhoodHash);
+    return bytes;
+}
+
 GoPlayerMove GoBoard::Move(int i) const
 {
-    const StackEntry& entry = (*m_moves)[i];
+    const StackEntry& entry = m_moves[i];
     SgPoint p = entry.m_point;
     SgBlackWhite c = entry.m_color;
     return GoPlayerMove(c, p);
@@ -641,6 +729,8 @@ void GoBoard::AddStone(SgPoint p, SgBlackWhite c)
     ++nuNeighbors[p - SG_WE];
     ++nuNeighbors[p + SG_WE];
     ++nuNeighbors[p + SG_NS];
+    if (m_neighborhoodHash)
+        m_neighborhoodHash->XorStone(p, c);
 }
 
 void GoBoard::RemoveStone(SgPoint p)
@@ -659,6 +749,8 @@ void GoBoard::RemoveStone(SgPoint p)
     --nuNeighbors[p - SG_WE];
     --nuNeighbors[p + SG_WE];
     --nuNeighbors[p + SG_NS];
+    if (m_neighborhoodHash)
+        m_neighborhoodHash->XorStone(p, c);
 }
 
 void GoBoard::KillBlock(const Block* block)
@@ -670,6 +762,7 @@ void GoBoard::KillBlock(const Block* block)
         SgPoint stn = *it;
         AddLibToAdjBlocks(stn, opp);
         m_state.m_hash.XorStone(stn, c);
+        m_state.m_positionHash.XorStone(stn, c);
         RemoveStone(stn);
         m_capturedStones.PushBack(stn);
         m_state.m_block[stn] = 0;
@@ -691,16 +784,22 @@ bool GoBoard::FullBoardRepetition() const
         int nuMoves = MoveNumber();
         if (nuMoves == 0)
             return false;
-        const StackEntry& entry = (*m_moves)[nuMoves - 1];
+        const StackEntry& entry = m_moves[nuMoves - 1];
         return (entry.m_point == entry.m_koPoint);
     }
+    // A repetition needs the same hash code as one of the earlier
+    // positions, which is usually ruled out by one lookup in the index of
+    // m_hashHistory. Otherwise walk back the move stack, which excludes
+    // hash collisions and checks the color to play for SUPERKO.
+    if (! m_hashHistory.Contains(m_state.m_positionHash.Get()))
+        return false;
     SgBWArray<SgArrayList<SgPoint,SG_MAXPOINT> > changes;
     int nuChanges = 0;
-    int moveNumber = m_moves->Length() - 1;
+    int moveNumber = m_moves.Length() - 1;
     bool requireSameToPlay = (koRule == GoRules::SUPERKO);
     while (moveNumber >= 0)
     {
-        const StackEntry& entry = (*m_moves)[moveNumber];
+        const StackEntry& entry = m_moves[moveNumber];
         SgPoint p = entry.m_point;
         if (! IsPass(p) && entry.m_color != SG_EMPTY
             && entry.m_color == GetColor(p)
@@ -712,9 +811,10 @@ bool GoBoard::FullBoardRepetition() const
         if (! IsPass(entry.m_point))
         {
             UpdateChanges(entry.m_point, changes[entry.m_color], nuChanges);
-            for (SgArrayList<Block*,4>::Iterator it(entry.m_killed); it; ++it)
+            for (int i = entry.m_firstBlockRef;
+                 i < entry.m_firstBlockRef + entry.m_nuKilled; ++i)
             {
-                Block* killed = *it;
+                const Block* killed = m_blockRefs[i];
                 for (GoPointList::Iterator stn(killed->Stones()); stn; ++stn)
                     UpdateChanges(*stn, changes[killed->Color()], nuChanges);
             }
@@ -754,11 +854,15 @@ void GoBoard::Play(SgPoint p, SgBlackWhite player)
     CheckConsistency();
     ++m_countPlay;
     // Reuse stack entry without initialization
-    m_moves->Resize(m_moves->Length() + 1);
-    StackEntry& entry = m_moves->Last();
+    m_moves.Resize(m_moves.Length() + 1);
+    StackEntry& entry = m_moves.Last();
     entry.m_point = p;
     entry.m_color = player;
+    entry.m_firstBlockRef = static_cast<int>(m_blockRefs.size());
+    entry.m_nuKilled = 0;
+    entry.m_nuMerged = 0;
     SaveState(entry);
+    m_hashHistory.Push(m_state.m_positionHash.Get());
     m_state.m_koPoint = SG_NULLPOINT;
     m_capturedStones.Clear();
     m_moveInfo.reset();
@@ -775,10 +879,11 @@ void GoBoard::Play(SgPoint p, SgBlackWhite player)
     bool wasFirstStone = IsFirst(p);
     m_state.m_isFirst[p] = false;
     m_state.m_hash.XorStone(p, player);
+    m_state.m_positionHash.XorStone(p, player);
     AddStone(p, player);
     ++m_state.m_numStones[player];
     RemoveLibAndKill(p, opp, entry);
-    if (! entry.m_killed.IsEmpty())
+    if (entry.m_nuKilled > 0)
     {
         m_moveInfo.set(GO_MOVEFLAG_CAPTURING);
         // If this is the first time a point is played here, then repetition
@@ -811,10 +916,13 @@ void GoBoard::Play(SgPoint p, SgBlackWhite player)
 void GoBoard::Undo()
 {
     CheckConsistency();
-    const StackEntry& entry = m_moves->Last();
+    const StackEntry& entry = m_moves.Last();
     RestoreState(entry);
     UpdateBlocksAfterUndo(entry);
-    m_moves->PopBack();
+    m_blockRefs.resize(entry.m_firstBlockRef);
+    m_moves.PopBack();
+    m_state.m_positionHash.Set(m_hashHistory.Last());
+    m_hashHistory.Pop();
     CheckConsistency();
 }
 
@@ -823,7 +931,6 @@ void GoBoard::Undo()
 void GoBoard::RemoveLibAndKill(SgPoint p, SgBlackWhite opp,
                                StackEntry& entry)
 {
-    entry.m_killed.Clear();
     if (NumNeighbors(p, SG_BLACK) == 0 && NumNeighbors(p, SG_WHITE) == 0)
         return;
     SgArrayList<Block*,4> blocks = GetAdjacentBlocks(p);
@@ -833,7 +940,8 @@ void GoBoard::RemoveLibAndKill(SgPoint p, SgBlackWhite opp,
         b->ExcludeLiberty(p);
         if (b->Color() == opp && b->NumLiberties() == 0)
         {
-            entry.m_killed.PushBack(b);
+            m_blockRefs.push_back(b);
+            ++entry.m_nuKilled;
             KillBlock(b);
         }
     }
@@ -873,33 +981,54 @@ void GoBoard::SaveState(StackEntry& entry)
 
 void GoBoard::TakeSnapshot()
 {
+    if (! m_snapshot)
+        m_snapshot.reset(new Snapshot());
     m_snapshot->m_moveNumber = MoveNumber();
-    m_snapshot->m_blockListSize = m_blockList->Length();
+    m_snapshot->m_blockListSize = m_blockList.Length();
+    m_snapshot->m_blockRefsSize = static_cast<int>(m_blockRefs.size());
     m_snapshot->m_state = m_state;
+    m_snapshot->m_blockPointers.clear();
+    m_snapshot->m_blocks.clear();
     for (GoBoard::Iterator it(*this); it; ++it)
     {
-        SgPoint p = *it;
-        if (m_state.m_block[p] != 0)
-            m_snapshot->m_blockArray[p] = *m_state.m_block[p];
+        Block* block = m_state.m_block[*it];
+        if (block != 0 && block->Anchor() == *it)
+        {
+            m_snapshot->m_blockPointers.push_back(block);
+            m_snapshot->m_blocks.push_back(*block);
+        }
     }
 }
 
 void GoBoard::RestoreSnapshot()
 {
+    SG_ASSERT(m_snapshot);
     SG_ASSERT(m_snapshot->m_moveNumber >= 0);
     SG_ASSERT(m_snapshot->m_moveNumber <= MoveNumber());
     if (m_snapshot->m_moveNumber == MoveNumber())
         return;
-    m_blockList->Resize(m_snapshot->m_blockListSize);
-    m_moves->Resize(m_snapshot->m_moveNumber);
+    m_blockList.Resize(m_snapshot->m_blockListSize);
+    m_moves.Resize(m_snapshot->m_moveNumber);
+    m_blockRefs.resize(m_snapshot->m_blockRefsSize);
+    while (m_hashHistory.Size() > m_snapshot->m_moveNumber)
+        m_hashHistory.Pop();
     m_state = m_snapshot->m_state;
-    for (GoBoard::Iterator it(*this); it; ++it)
+    for (std::size_t i = 0; i < m_snapshot->m_blocks.size(); ++i)
+        *m_snapshot->m_blockPointers[i] = m_snapshot->m_blocks[i];
+    if (m_neighborhoodHash)
+        m_neighborhoodHash->Init(*this);
+    CheckConsistency();
+}
+
+void GoBoard::SetNeighborhoodHash(bool enable)
+{
+    if (! enable)
+        m_neighborhoodHash.reset();
+    else if (! m_neighborhoodHash)
     {
-        SgPoint p = *it;
-        if (m_state.m_block[p] != 0)
-            *m_state.m_block[p] = m_snapshot->m_blockArray[p];
+        m_neighborhoodHash.reset(new GoNeighborhoodHash());
+        m_neighborhoodHash->Init(*this);
     }
-    CheckConsistency();
 }
 
 //----------------------------------------------------------------------------
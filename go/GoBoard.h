@@ -12,8 +12,11 @@
 
 #include <bitset>
 #include <cstring>
+#include <memory>
+#include <vector>
 #include <stdint.h>
 #include <boost/static_assert.hpp>
+#include "GoHashHistory.h"
 #include "GoPlayerMove.h"
 #include "GoRules.h"
 #include "GoSetup.h"
@@ -21,6 +24,7 @@
 #include "SgArrayList.h"
 #include "SgBoardConst.h"
 #include "SgBoardColor.h"
+#include "SgChunkList.h"
 #include "SgMarker.h"
 #include "SgBWArray.h"
 #include "SgBWSet.h"
@@ -31,6 +35,8 @@
 #include "SgPointIterator.h"
 #include "SgPointSet.h"
 
+class GoNeighborhoodHash;
+
 //----------------------------------------------------------------------------
 
 /** Board size to choose at startup. */
@@ -117,9 +123,28 @@ public:
 
     const SgBoardConst& BoardConst() const;
 
+    /** Make this board a copy of another board.
+        Copies the position, the move history with the information to undo
+        the moves, the ko state, the hash codes, the position hashes for the
+        repetition checks and the rules. The cost is proportional to the
+        number of points and the length of the game, but unlike replaying
+        the game, it does not execute any moves. Does not copy the snapshot
+        (TakeSnapshot() needs to be called again), the user marker and
+        CountPlay(). The neighborhood hash codes are computed, if
+        enabled on this board (see SetNeighborhoodHash()), independently of
+        whether they are enabled on the other board. */
+    void CopyFrom(const GoBoard& bd);
+
     /** Number of calls to Play since creation of this board. */
     uint64_t CountPlay() const;
 
+    /** Number of bytes used by this board.
+        Includes the memory of the move and block stacks, which grows with
+        the maximum game length since the creation of the board, of the
+        snapshot, if TakeSnapshot() was used, and of the neighborhood hash
+        codes, if enabled. */
+    std::size_t MemoryUsed() const;
+
     /** Re-initializes the board with new size.
         Keeps old GoRules. */
     void Init(int size, const GoSetup& setup = GoSetup());
@@ -388,6 +413,17 @@ public:
         of whose turn it is to play. */
     SgHashCode GetHashCodeInclToPlay() const;
 
+    /** Enable or disable incremental hash codes of the neighborhoods of
+        the points.
+        Disabled by default. If enabled, each added or removed stone updates
+        the hash codes, see GoNeighborhoodHash. */
+    void SetNeighborhoodHash(bool enable);
+
+    /** The hash codes of the neighborhoods of the points.
+        @return The hash codes or 0, if not enabled with
+        SetNeighborhoodHash() */
+    const GoNeighborhoodHash* NeighborhoodHash() const;
+
     /** Return the number of stones in the block at 'p'.
         Not defined for empty or border points. */
     int NumStones(SgPoint p) const;
@@ -622,6 +658,9 @@ private:
 
         SgHashCode GetInclToPlay(SgBlackWhite toPlay) const;
 
+        /** Restore a value returned by Get(). */
+        void Set(const SgHashCode& hash);
+
         void XorCaptured(int moveNumber, SgPoint firstCapturedStone);
 
         void XorStone(SgPoint p, SgBlackWhite c);
@@ -658,44 +697,27 @@ private:
     };
 
     /** Information to undo a move.
-        Holds information necessary to undo a play. */
+        Holds information necessary to undo a play. The blocks killed or
+        merged by the move are stored in m_blockRefs, which keeps the entry
+        small for the common move without captures and merges. */
     struct StackEntry
     {
-        /** Color of the move. */
-        SgBlackWhite m_color;
-
-        /** Location of the move. */
-        SgPoint m_point;
-
-        /** Old value of m_isFirst[m_point].
-            Only defined if m_point is not SG_PASS */
-        bool m_isFirst;
-
-        /** Old value of m_isNewPosition */
-        bool m_isNewPosition;
+        /** Old value of m_hash */
+        HashCode m_hash;
 
         Block* m_stoneAddedTo;
 
-        /** @name Only defined if m_stoneAddedTo != 0 */
-        //@{
-
-        SgPoint m_oldAnchor;
-
-        SgArrayList<SgPoint, 4> m_newLibs;
-
-        SgArrayList<Block*, 4> m_merged;
+        Block* m_suicide;
 
-        //@}
+        /** Color of the move. */
+        SgBlackWhite m_color;
 
-        /** @name Only defined if m_type == PLAY */
-        //@{
+        /** Location of the move. */
+        SgPoint m_point;
 
         /** Old value of m_toPlay */
         SgBlackWhite m_toPlay;
 
-        /** Old value of m_hash */
-        HashCode m_hash;
-
         /** Old value of m_koPoint */
         SgPoint m_koPoint;
 
@@ -708,12 +730,34 @@ private:
         /** Old value of m_koLoser */
         SgEmptyBlackWhite m_koLoser;
 
+        /** Index of the first block killed or merged by the move in
+            m_blockRefs.
+            The killed blocks are followed by the merged blocks. */
+        int m_firstBlockRef;
+
+        /** Number of blocks killed by the move. */
+        unsigned char m_nuKilled;
+
+        /** Number of blocks merged by the move. */
+        unsigned char m_nuMerged;
+
+        /** Old value of m_isFirst[m_point].
+            Only defined if m_point is not SG_PASS */
+        bool m_isFirst;
+
+        /** Old value of m_isNewPosition */
+        bool m_isNewPosition;
+
         /** Old value of m_koModifiesHash */
         bool m_koModifiesHash;
 
-        Block* m_suicide;
+        /** @name Only defined if m_stoneAddedTo != 0 */
+        //@{
+
+        SgPoint m_oldAnchor;
+
+        SgArrayList<SgPoint, 4> m_newLibs;
 
-        SgArrayList<Block*, 4> m_killed;
         //@}
     };
 
@@ -733,6 +777,11 @@ private:
         /** Hash code for this board position. */
         HashCode m_hash;
 
+        /** Hash code of the stones only.
+            Unlike m_hash, not modified by captures and ko wins (see
+            KoModifiesHash()). Used for the full board repetition check. */
+        HashCode m_positionHash;
+
         SgBWSet m_all;
 
         SgPointSet m_empty;
@@ -773,16 +822,25 @@ private:
 
         int m_blockListSize;
 
+        int m_blockRefsSize;
+
         State m_state;
 
-        /** State of blocks currently on the board. */
-        SgPointArray<Block> m_blockArray;
+        /** Blocks currently on the board. */
+        std::vector<Block*> m_blockPointers;
+
+        /** State of the blocks in m_blockPointers. */
+        std::vector<Block> m_blocks;
     };
 
     State m_state;
 
+    /** Created by the first call of TakeSnapshot(). */
     std::unique_ptr<Snapshot> m_snapshot;
 
+    /** See SetNeighborhoodHash() */
+    std::unique_ptr<GoNeighborhoodHash> m_neighborhoodHash;
+
     /** See CountPlay */
     uint64_t m_countPlay;
 
@@ -802,8 +860,10 @@ private:
     GoMoveInfo m_moveInfo;
 
     /** Block data (stored in a stack).
-        Maximum number: A move can create zero or one new block. */
-    SgArrayList<Block, GO_MAX_NUM_MOVES>* m_blockList;
+        Maximum number: A move can create zero or one new block. The
+        elements are not moved when the stack grows, m_state.m_block and
+        the stack entries point to them. */
+    SgChunkList<Block,16> m_blockList;
 
     // The following members are mutable since they're used while computing
     // stones and liberties, but are either restored to their previous setting
@@ -828,7 +888,14 @@ private:
 
     SgArray<bool, SG_MAXPOINT> m_isBorder;
 
-    SgArrayList<StackEntry, GO_MAX_NUM_MOVES>* m_moves;
+    SgChunkList<StackEntry,64> m_moves;
+
+    /** Blocks killed or merged by the moves in m_moves.
+        See StackEntry::m_firstBlockRef */
+    std::vector<Block*> m_blockRefs;
+
+    /** Values of m_state.m_positionHash before the moves in m_moves. */
+    GoHashHistory m_hashHistory;
 
     static bool IsPass(SgPoint p);
 
@@ -879,6 +946,11 @@ private:
 
     void CheckConsistencyBlock(SgPoint p) const;
 
+    /** Address of the block in this board that is at the same position in
+        the block stack as a block of another board.
+        Used by CopyFrom(). */
+    Block* CopiedBlock(const GoBoard& bd, const Block* block);
+
     bool FullBoardRepetition() const;
 
     /** Kill own block if no liberties.
@@ -1180,6 +1252,11 @@ inline SgHashCode GoBoard::HashCode::GetInclToPlay(SgBlackWhite toPlay) const
     return hash;
 }
 
+inline void GoBoard::HashCode::Set(const SgHashCode& hash)
+{
+    m_hash = hash;
+}
+
 inline void GoBoard::HashCode::XorCaptured(int moveNumber,
                                            SgPoint firstCapturedStone)
 {
@@ -1263,7 +1340,7 @@ inline bool GoBoard::AtMostNumLibs(SgPoint block, int n) const
 
 inline bool GoBoard::CanUndo() const
 {
-    return (m_moves->Length() > 0);
+    return (m_moves.Length() > 0);
 }
 
 inline const GoPointList& GoBoard::CapturedStones() const
@@ -1311,8 +1388,8 @@ inline SgPoint GoBoard::Get2ndLastMove() const
     int moveNumber = MoveNumber();
     if (moveNumber < 2)
         return SG_NULLMOVE;
-    const StackEntry& entry1 = (*m_moves)[moveNumber - 1];
-    const StackEntry& entry2 = (*m_moves)[moveNumber - 2];
+    const StackEntry& entry1 = m_moves[moveNumber - 1];
+    const StackEntry& entry2 = m_moves[moveNumber - 2];
     SgBlackWhite toPlay = ToPlay();
     if (entry1.m_color != SgOppBW(toPlay) || entry2.m_color != toPlay)
         return SG_NULLMOVE;
@@ -1339,7 +1416,7 @@ inline SgPoint GoBoard::GetLastMove() const
     int moveNumber = MoveNumber();
     if (moveNumber == 0)
         return SG_NULLMOVE;
-    const StackEntry& entry = (*m_moves)[moveNumber - 1];
+    const StackEntry& entry = m_moves[moveNumber - 1];
     if (entry.m_color != SgOppBW(ToPlay()))
         return SG_NULLMOVE;
     return entry.m_point;
@@ -1596,7 +1673,12 @@ inline const SgPointSet& GoBoard::LineSet(SgGrid line) const
 
 inline int GoBoard::MoveNumber() const
 {
-    return m_moves->Length();
+    return m_moves.Length();
+}
+
+inline const GoNeighborhoodHash* GoBoard::NeighborhoodHash() const
+{
+    return m_neighborhoodHash.get();
 }
 
 inline int GoBoard::Num8Neighbors(SgPoint p, SgBlackWhite c) const
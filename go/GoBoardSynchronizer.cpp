@@ -60,6 +60,12 @@ void GoBoardSynchronizer::PreUndo()
 void GoBoardSynchronizer::OnUndo()
 { }
 
+void GoBoardSynchronizer::UpdateFromCopy()
+{
+    m_subscriber->CopyFrom(m_publisher);
+    OnBoardChange();
+}
+
 void GoBoardSynchronizer::UpdateFromInit()
 {
     m_subscriber->Init(m_publisher.Size(), m_publisher.Setup());
@@ -69,9 +75,8 @@ void GoBoardSynchronizer::UpdateFromInit()
         ExecuteSubscriber(m_publisher.Move(i));
 }
 
-void GoBoardSynchronizer::UpdateIncremental()
+void GoBoardSynchronizer::UpdateIncremental(int nuCommon)
 {
-    const int nuCommon = FindNuCommon();
     const int nuSubscriber = m_subscriber->MoveNumber();
     const int nuUndo = nuSubscriber - nuCommon;
     for (int i = 0; i < nuUndo; ++i)
@@ -91,11 +96,25 @@ void GoBoardSynchronizer::UpdateSubscriber()
     if (m_subscriber == 0)
         return;
     m_subscriber->Rules() = m_publisher.Rules();
+    const int nuPublisher = m_publisher.MoveNumber();
     if (m_publisher.Size() != m_subscriber->Size()
         || m_publisher.Setup() != m_subscriber->Setup())
-        UpdateFromInit();
+    {
+        if (nuPublisher >= MIN_MOVES_COPY)
+            UpdateFromCopy();
+        else
+            UpdateFromInit();
+    }
     else
-        UpdateIncremental();
+    {
+        const int nuCommon = FindNuCommon();
+        const int nuChanges = m_subscriber->MoveNumber() - nuCommon
+            + nuPublisher - nuCommon;
+        if (nuChanges >= MIN_MOVES_COPY)
+            UpdateFromCopy();
+        else
+            UpdateIncremental(nuCommon);
+    }
     UpdateToPlay();
     SG_ASSERT(m_publisher.GetHashCode() == m_subscriber->GetHashCode());
 }
@@ -28,16 +28,26 @@ public:
 
     /** Update the subscriber board.
         Calls Init, Play, Undo and/or SetToPlay to update the
-        subscriber to the current state of the publisher.
+        subscriber to the current state of the publisher. If the subscriber
+        needs at least MIN_MOVES_COPY moves or undos to reach the state of
+        the publisher, it is updated with GoBoard::CopyFrom() instead, which
+        is faster than replaying the moves.
         If no subscriber was set with SetSubscriber, this function does
         nothing. */
     void UpdateSubscriber();
 
+    /** Minimum number of changes for updating the subscriber with
+        GoBoard::CopyFrom().
+        See UpdateSubscriber(). */
+    static const int MIN_MOVES_COPY = 20;
+
 protected:
     /** @name Hook functions for incremental update events */
     // @{
 
-    /** Board was initialized with new size.
+    /** Board was initialized with new size or copied from the publisher.
+        The subscriber was not updated by single moves, PrePlay(), OnPlay(),
+        PreUndo() and OnUndo() were not called.
         Default implementation does nothing. */
     virtual void OnBoardChange();
 
@@ -74,9 +84,11 @@ private:
 
     int FindNuCommon() const;
 
+    void UpdateFromCopy();
+
     void UpdateFromInit();
 
-    void UpdateIncremental();
+    void UpdateIncremental(int nuCommon);
 
     void UpdateToPlay();
 };
@@ -0,0 +1,66 @@
+//----------------------------------------------------------------------------
+/** @file GoCfgDistance.cpp
+    See GoCfgDistance.h */
+//----------------------------------------------------------------------------
+
+#include "SgSystem.h"
+#include "GoCfgDistance.h"
+
+//----------------------------------------------------------------------------
+
+GoCfgDistance::GoCfgDistance()
+{ }
+
+inline void GoCfgDistance::Check(const GoBoard& bd, SgPoint p, int d)
+{
+    if (! bd.IsBorder(p))
+    {
+        if (bd.Occupied(p))
+            p = bd.Anchor(p);
+        if (m_marker.NewMark(p))
+        {
+            m_distance[p] = d;
+            m_points.PushBack(p);
+        }
+    }
+}
+
+void GoCfgDistance::Compute(const GoBoard& bd, SgPoint p, int maxDist)
+{
+    // Same search as in GoBoardUtil::CfgDistance()
+    m_marker.Clear();
+    m_points.Clear();
+    Check(bd, p, 0);
+    int begin = 0;
+    int end = 1;
+    int d = 0;
+    while (begin != end && d < maxDist)
+    {
+        ++d;
+        for (int i = begin; i != end; ++i)
+        {
+            p = m_points[i];
+            if (bd.Occupied(p))
+            {
+                for (GoBoard::StoneIterator it(bd, p); it; ++it)
+                {
+                    Check(bd, *it + SG_NS, d);
+                    Check(bd, *it - SG_NS, d);
+                    Check(bd, *it + SG_WE, d);
+                    Check(bd, *it - SG_WE, d);
+                }
+            }
+            else
+            {
+                Check(bd, p + SG_NS, d);
+                Check(bd, p - SG_NS, d);
+                Check(bd, p + SG_WE, d);
+                Check(bd, p - SG_WE, d);
+            }
+        }
+        begin = end;
+        end = m_points.Length();
+    }
+}
+
+//----------------------------------------------------------------------------
@@ -0,0 +1,74 @@
+//----------------------------------------------------------------------------
+/** @file GoCfgDistance.h
+    Common fate graph distances for repeated use. */
+//----------------------------------------------------------------------------
+
+#ifndef GO_CFGDISTANCE_H
+#define GO_CFGDISTANCE_H
+
+#include <limits>
+#include "GoBoard.h"
+#include "SgMarker.h"
+
+//----------------------------------------------------------------------------
+
+/** Common fate graph distances from a point up to a maximum distance.
+    Computes the same distances as GoBoardUtil::CfgDistance(), but is meant
+    for computing them many times, e.g. from the last move at every node
+    expansion of a search. The arrays are kept between calls of Compute()
+    and are not cleared (the valid entries are marked with an SgMarker), so
+    the cost of Compute() depends only on the number of points within the
+    maximum distance and not on the size of the board. */
+class GoCfgDistance
+{
+public:
+    GoCfgDistance();
+
+    /** Compute the distances from a point.
+        @param bd The board
+        @param p The point (empty or occupied)
+        @param maxDist The maximum distance */
+    void Compute(const GoBoard& bd, SgPoint p, int maxDist);
+
+    /** The distance of a point to the point of the last Compute().
+        @param p An empty point or a block anchor
+        @return The distance or std::numeric_limits<int>::max(), if it is
+        larger than the maximum distance */
+    int Distance(SgPoint p) const;
+
+    /** The empty points and block anchors within the maximum distance,
+        ordered by distance. */
+    const GoPointList& Points() const;
+
+private:
+    /** Points with a valid entry in m_distance */
+    SgMarker m_marker;
+
+    SgArray<int,SG_MAXPOINT> m_distance;
+
+    GoPointList m_points;
+
+    void Check(const GoBoard& bd, SgPoint p, int d);
+
+    /** Not implemented */
+    GoCfgDistance(const GoCfgDistance&);
+
+    /** Not implemented */
+    GoCfgDistance& operator=(const GoCfgDistance&);
+};
+
+inline int GoCfgDistance::Distance(SgPoint p) const
+{
+    if (m_marker.Contains(p))
+        return m_distance[p];
+    return std::numeric_limits<int>::max();
+}
+
+inline const GoPointList& GoCfgDistance::Points() const
+{
+    return m_points;
+}
+
+//----------------------------------------------------------------------------
+
+#endif // GO_CFGDISTANCE_H
@@ -0,0 +1,34 @@
+//----------------------------------------------------------------------------
+/** @file GoHashHistory.cpp
+    See GoHashHistory.h */
+//----------------------------------------------------------------------------
+
+#include "SgSystem.h"
+#include "GoHashHistory.h"
+
+//----------------------------------------------------------------------------
+
+GoHashHistory::GoHashHistory()
+    : m_count(0)
+{ }
+
+void GoHashHistory::Clear()
+{
+    m_hash.clear();
+    m_count.Fill(0);
+}
+
+void GoHashHistory::CopyFrom(const GoHashHistory& history)
+{
+    if (&history == this)
+        return;
+    for (std::vector<SgHashCode>::const_iterator it = m_hash.begin();
+         it != m_hash.end(); ++it)
+        --m_count[Bucket(*it)];
+    m_hash = history.m_hash;
+    for (std::vector<SgHashCode>::const_iterator it = m_hash.begin();
+         it != m_hash.end(); ++it)
+        ++m_count[Bucket(*it)];
+}
+
+//----------------------------------------------------------------------------
@@ -0,0 +1,101 @@
+//----------------------------------------------------------------------------
+/** @file GoHashHistory.h
+    Hash codes of the earlier positions of a game for repetition checks. */
+//----------------------------------------------------------------------------
+
+#ifndef GO_HASHHISTORY_H
+#define GO_HASHHISTORY_H
+
+#include <vector>
+#include "SgArray.h"
+#include "SgHash.h"
+
+//----------------------------------------------------------------------------
+
+/** Stack of the hash codes of the positions before the moves of a game,
+    with an index for fast lookups.
+    Used by GoBoard for the full board repetition check of the superko
+    rules. The index is an array of counters indexed by SgHashCode::Hash().
+    Contains() returns false after a single array access, unless a position
+    with the same index is in the history; only then the hash codes are
+    compared. A found hash code can still be a hash
+    collision, the caller needs to verify the repetition. */
+class GoHashHistory
+{
+public:
+    GoHashHistory();
+
+    void Clear();
+
+    /** Make this history a copy of another history.
+        Faster than the assignment operator for short histories, because
+        it only updates the counters of the index used by the hash codes
+        of both histories. */
+    void CopyFrom(const GoHashHistory& history);
+
+    /** Does the history contain a hash code? */
+    bool Contains(const SgHashCode& hash) const;
+
+    /** The hash code of the last position. */
+    const SgHashCode& Last() const;
+
+    void Pop();
+
+    void Push(const SgHashCode& hash);
+
+    int Size() const;
+
+private:
+    static const int INDEX_SIZE = 4096;
+
+    std::vector<SgHashCode> m_hash;
+
+    /** Number of hash codes in m_hash for each value of Bucket(). */
+    SgArray<int,INDEX_SIZE> m_count;
+
+    static int Bucket(const SgHashCode& hash);
+};
+
+inline int GoHashHistory::Bucket(const SgHashCode& hash)
+{
+    return hash.Hash(INDEX_SIZE);
+}
+
+inline bool GoHashHistory::Contains(const SgHashCode& hash) const
+{
+    if (m_count[Bucket(hash)] == 0)
+        return false;
+    for (std::vector<SgHashCode>::const_reverse_iterator it = m_hash.rbegin();
+         it != m_hash.rend(); ++it)
+        if (*it == hash)
+            return true;
+    return false;
+}
+
+inline const SgHashCode& GoHashHistory::Last() const
+{
+    SG_ASSERT(! m_hash.empty());
+    return m_hash.back();
+}
+
+inline void GoHashHistory::Pop()
+{
+    SG_ASSERT(! m_hash.empty());
+    --m_count[Bucket(m_hash.back())];
+    m_hash.pop_back();
+}
+
+inline void GoHashHistory::Push(const SgHashCode& hash)
+{
+    ++m_count[Bucket(hash)];
+    m_hash.push_back(hash);
+}
+
+inline int GoHashHistory::Size() const
+{
+    return static_cast<int>(m_hash.size());
+}
+
+//----------------------------------------------------------------------------
+
+#endif // GO_HASHHISTORY_H
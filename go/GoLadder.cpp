@@ -29,11 +29,30 @@ const int GOOD_FOR_HUNTER = -1000;
 //----------------------------------------------------------------------------
 
 GoLadder::GoLadder()
+    : m_recordMoves(0),
+      m_overflow(false)
 { }
 
-inline bool GoLadder::CheckMoveOverflow() const
+inline bool GoLadder::CheckMoveOverflow()
 {
-    return m_bd->MoveNumber() >= m_maxMoveNumber;
+    if (m_bd->MoveNumber() >= m_maxMoveNumber)
+    {
+        m_overflow = true;
+        return true;
+    }
+    return false;
+}
+
+inline void GoLadder::RecordMove(SgPoint p)
+{
+    if (m_recordMoves != 0)
+        m_recordMoves->Include(p);
+}
+
+inline bool GoLadder::PlayIfLegal(SgPoint p, SgBlackWhite color)
+{
+    RecordMove(p);
+    return GoBoardUtil::PlayIfLegal(*m_bd, p, color);
 }
 
 void GoLadder::InitMaxMoveNumber()
@@ -109,7 +128,7 @@ int GoLadder::PlayHunterMove(int depth, SgPoint move, SgPoint lib1,
     SG_ASSERT(move == lib1 || move == lib2);
     // TODO: only pass move and otherLib
     int result = 0;
-    if (PlayIfLegal(*m_bd, move, m_hunterColor))
+    if (PlayIfLegal(move, m_hunterColor))
     {
         // Find new adjacent blocks: only block just played can be new
         // in atari.
@@ -177,7 +196,7 @@ int GoLadder::PlayPreyMove(int depth, SgPoint move, SgPoint lib1,
         }
         m_partOfPrey.Include(move);
     }
-    if (PlayIfLegal(*m_bd, move, m_preyColor))
+    if (PlayIfLegal(move, m_preyColor))
     {
         if (move == lib1)
         {
@@ -319,6 +338,7 @@ int GoLadder::HunterLadder(int depth, SgPoint lib1, SgPoint lib2,
     {
         // If not playing at lib1, then prey will play at lib1 and
         // get three liberties; little to update in this case.
+        RecordMove(lib1);
         m_bd->Play(lib1, m_hunterColor);
         result = PreyLadder(depth + 1, lib2, adjBlk, sequence);
         if (sequence)
@@ -469,7 +489,7 @@ int GoLadder::Ladder(const GoBoard& bd, SgPoint prey, SgBlackWhite toPlay,
                 // Try whether any of these moves lead to escape.
                 for (SgVectorIterator<SgPoint> it(movesToTry); it; ++it)
                 {
-                    if (PlayIfLegal(*m_bd, *it, m_preyColor))
+                    if (PlayIfLegal(*it, m_preyColor))
                     {
                         if (Ladder(bd, prey, m_hunterColor, 0, twoLibIsEscape)
                             > 0)
@@ -520,7 +540,7 @@ bool GoLadder::IsSnapback(SgPoint prey)
     if (m_bd->IsSingleStone(prey) && m_bd->InAtari(prey))
     {
         SgPoint liberty = *GoBoard::LibertyIterator(*m_bd, prey);
-        if (PlayIfLegal(*m_bd, liberty, SgOppBW(m_bd->GetStone(prey))))
+        if (PlayIfLegal(liberty, SgOppBW(m_bd->GetStone(prey))))
         {
             isSnapback = (m_bd->InAtari(liberty)
                           && ! m_bd->IsSingleStone(liberty));
@@ -50,6 +50,17 @@ public:
     int Ladder(const GoBoard& bd, SgPoint prey, SgBlackWhite toPlay,
                SgVector<SgPoint>* sequence, bool twoLibIsEscape = false);
 
+    /** Record the points of all moves tried in subsequent calls of Ladder().
+        Includes illegal moves, which were tried. Used by GoLadderCache to
+        find the region of the board that a ladder result depends on.
+        @param moves The set to add the points to. Not cleared by Ladder().
+        0 disables recording (default). */
+    void SetRecordMoves(SgPointSet* moves);
+
+    /** Did a call of Ladder() since the last call of this function abort
+        the search because of the limit of the move number? */
+    bool CheckAndClearOverflow();
+
 private:
     /** Maximum number of moves in ladder.
         If board has simple ko rule, ladders could not terminate. */
@@ -66,7 +77,19 @@ private:
 
     SgBlackWhite m_hunterColor;
 
-    bool CheckMoveOverflow() const;
+    /** See SetRecordMoves() */
+    SgPointSet* m_recordMoves;
+
+    /** See CheckAndClearOverflow() */
+    bool m_overflow;
+
+    bool CheckMoveOverflow();
+
+    /** Add a move to the recorded moves, see SetRecordMoves() */
+    void RecordMove(SgPoint p);
+
+    /** Record a move and play it, if it is legal. */
+    bool PlayIfLegal(SgPoint p, SgBlackWhite color);
 
     void InitMaxMoveNumber();
 
@@ -99,6 +122,18 @@ private:
     void ReduceToBlocks(GoPointList& stones);
 };
 
+inline bool GoLadder::CheckAndClearOverflow()
+{
+    const bool overflow = m_overflow;
+    m_overflow = false;
+    return overflow;
+}
+
+inline void GoLadder::SetRecordMoves(SgPointSet* moves)
+{
+    m_recordMoves = moves;
+}
+
 //----------------------------------------------------------------------------
 
 namespace GoLadderUtil {
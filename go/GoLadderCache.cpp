@@ -0,0 +1,346 @@
+//----------------------------------------------------------------------------
+/** @file GoLadderCache.cpp
+    See GoLadderCache.h */
+//----------------------------------------------------------------------------
+
+#include "SgSystem.h"
+#include "GoLadderCache.h"
+
+#include <iomanip>
+#include <iostream>
+#include <boost/io/ios_state.hpp>
+#include "GoBoardUtil.h"
+#include "GoModBoard.h"
+
+using std::fixed;
+using std::setprecision;
+
+//----------------------------------------------------------------------------
+
+GoLadderCacheStatistics::GoLadderCacheStatistics()
+{
+    Clear();
+}
+
+void GoLadderCacheStatistics::Add(const GoLadderCacheStatistics& other)
+{
+    m_nuPositions += other.m_nuPositions;
+    m_nuSearches += other.m_nuSearches;
+    m_nuAvoided += other.m_nuAvoided;
+}
+
+void GoLadderCacheStatistics::Clear()
+{
+    m_nuPositions = 0;
+    m_nuSearches = 0;
+    m_nuAvoided = 0;
+}
+
+void GoLadderCacheStatistics::Write(std::ostream& out) const
+{
+    boost::io::ios_all_saver saver(out);
+    const std::size_t nuQueries = m_nuSearches + m_nuAvoided;
+    out << "Positions " << m_nuPositions
+        << " Searches " << m_nuSearches
+        << " Avoided " << m_nuAvoided << fixed << setprecision(1) << " ("
+        << (nuQueries > 0 ? m_nuAvoided * 100.0 / double(nuQueries) : 0.0)
+        << "%) AvoidedPerPos " << setprecision(2)
+        << (m_nuPositions > 0 ?
+            m_nuAvoided / double(m_nuPositions) : 0.0);
+}
+
+//----------------------------------------------------------------------------
+
+GoLadderCache::Key::Key()
+    : m_type(LADDER),
+      m_anchor(SG_NULLPOINT),
+      m_firstMove(SG_NULLMOVE),
+      m_toPlay(SG_BLACK),
+      m_koPoint(SG_NULLPOINT),
+      m_size(0)
+{ }
+
+GoLadderCache::Key::Key(const GoBoard& bd, QueryType type, SgPoint prey,
+                        SgPoint firstMove, SgBlackWhite toPlay)
+    : m_type(type),
+      m_anchor(bd.Anchor(prey)),
+      m_firstMove(firstMove),
+      m_toPlay(toPlay),
+      m_koPoint(bd.KoPoint()),
+      m_size(bd.Size())
+{ }
+
+bool GoLadderCache::Key::operator==(const Key& key) const
+{
+    return m_anchor == key.m_anchor
+        && m_firstMove == key.m_firstMove
+        && m_type == key.m_type
+        && m_toPlay == key.m_toPlay
+        && m_koPoint == key.m_koPoint
+        && m_size == key.m_size;
+}
+
+std::size_t GoLadderCache::Key::Hash() const
+{
+    // The ko point and the board size are rarely different for the same
+    // other fields, no need to include them
+    std::size_t h = static_cast<std::size_t>(m_anchor);
+    h = h * SG_MAXPOINT + static_cast<std::size_t>(m_firstMove + 1);
+    h = h * 4 + static_cast<std::size_t>(m_type);
+    h = h * 2 + static_cast<std::size_t>(m_toPlay);
+    return h * 0x9e3779b1u;
+}
+
+//----------------------------------------------------------------------------
+
+GoLadderCache::Entry::Entry()
+    : m_isValid(false),
+      m_hasSequence(false),
+      m_result(0)
+{ }
+
+//----------------------------------------------------------------------------
+
+GoLadderCache::GoLadderCache(std::size_t nuEntries)
+    : m_entries((nuEntries + NU_WAYS - 1) / NU_WAYS * NU_WAYS),
+      m_nextWay(0)
+{ }
+
+void GoLadderCache::Clear()
+{
+    for (std::vector<Entry>::iterator it = m_entries.begin();
+         it != m_entries.end(); ++it)
+        it->m_isValid = false;
+}
+
+void GoLadderCache::ClearStatistics()
+{
+    m_statistics.Clear();
+}
+
+bool GoLadderCache::Find(const GoBoard& bd, const Key& key, bool needSequence,
+                         Entry*& entry)
+{
+    if (m_entries.empty())
+    {
+        entry = 0;
+        return false;
+    }
+    // Use the upper bits of the product in Key::Hash()
+    const std::size_t nuSets = m_entries.size() / NU_WAYS;
+    Entry* set = &m_entries[(key.Hash() >> 8) % nuSets * NU_WAYS];
+    entry = 0;
+    for (int i = 0; i < NU_WAYS; ++i)
+    {
+        Entry& e = set[i];
+        if (! e.m_isValid)
+        {
+            if (entry == 0)
+                entry = &e;
+        }
+        else if (  e.m_key == key
+                && (! needSequence || e.m_hasSequence)
+                && RegionCode(bd, e.m_region) == e.m_regionCode
+                )
+        {
+            entry = &e;
+            ++m_statistics.m_nuAvoided;
+            return true;
+        }
+    }
+    if (entry == 0)
+        entry = &set[m_nextWay++ % NU_WAYS];
+    return false;
+}
+
+void GoLadderCache::GetRegion(const GoBoard& bd, const Key& key,
+                              const Entry* entry, SgPointSet& region) const
+{
+    region.Clear();
+    if (entry != 0 && entry->m_isValid && entry->m_key == key)
+        for (std::vector<SgPoint>::const_iterator it = entry->m_region.begin();
+             it != entry->m_region.end(); ++it)
+            region.Include(*it);
+    else
+        region = SgPointSet::AllPoints(bd.Size());
+}
+
+void GoLadderCache::FindLadderEscapeMoves(const GoBoard& bd, SgPoint prey,
+                                          SgVector<SgPoint>& escapeMoves)
+{
+    SG_ASSERT(bd.NumLiberties(prey) == 1);
+    SG_ASSERT(escapeMoves.IsEmpty());
+    SgPoint p = bd.TheLiberty(prey);
+    SgVector<SgPoint> candidates;
+    candidates.PushBack(p);
+    if (IsLadderEscapeMove(bd, prey, p))
+        escapeMoves.PushBack(p);
+    for (GoAdjBlockIterator<GoBoard> it(bd, prey, 1); it; ++it)
+    {
+        // check if prey can escape by capturing *it on p.
+        SgPoint p = bd.TheLiberty(*it);
+        if (! candidates.Contains(p))
+        {
+            candidates.PushBack(p);
+            if (IsLadderEscapeMove(bd, prey, p))
+                escapeMoves.PushBack(p);
+        }
+    }
+}
+
+bool GoLadderCache::IsLadderCaptureMove(const GoBoard& bd, SgPoint prey,
+                                        SgPoint firstMove)
+{
+    SG_ASSERT(bd.NumLiberties(prey) == 2);
+    SG_ASSERT(bd.IsLibertyOfBlock(firstMove, bd.Anchor(prey)));
+    const SgBlackWhite defender = bd.GetStone(prey);
+    const Key key(bd, CAPTURE_MOVE, prey, firstMove, defender);
+    Entry* entry;
+    int result;
+    if (Find(bd, key, false, entry))
+        result = entry->m_result;
+    else
+        result = Search(entry, key, bd, prey, SgOppBW(defender), 0, false);
+    return result < 0;
+}
+
+bool GoLadderCache::IsLadderEscapeMove(const GoBoard& bd, SgPoint prey,
+                                       SgPoint firstMove)
+{
+    SG_ASSERT(bd.NumLiberties(prey) == 1);
+    const SgBlackWhite defender = bd.GetStone(prey);
+    const Key key(bd, ESCAPE_MOVE, prey, firstMove, SgOppBW(defender));
+    Entry* entry;
+    int result;
+    if (Find(bd, key, false, entry))
+        result = entry->m_result;
+    else
+        result = Search(entry, key, bd, prey, defender, 0, false);
+    // The prey still exists after a legal first move of the defender, so
+    // GoLadder::Ladder() does not return 0
+    return result > 0;
+}
+
+int GoLadderCache::Ladder(const GoBoard& bd, SgPoint prey,
+                          SgBlackWhite toPlay, SgVector<SgPoint>* sequence,
+                          bool twoLibIsEscape, SgPointSet* region)
+{
+    SG_ASSERT(bd.Occupied(prey));
+    const Key key(bd, twoLibIsEscape ? LADDER_TWO_LIB_IS_ESCAPE : LADDER,
+                  prey, SG_NULLMOVE, toPlay);
+    Entry* entry;
+    int result;
+    if (Find(bd, key, sequence != 0, entry))
+    {
+        if (sequence != 0)
+            *sequence = entry->m_sequence;
+        result = entry->m_result;
+    }
+    else
+        result = Search(entry, key, bd, prey, SG_EMPTY, sequence,
+                        twoLibIsEscape);
+    if (region != 0)
+        GetRegion(bd, key, entry, *region);
+    return result;
+}
+
+SgHashCode GoLadderCache::RegionCode(const GoBoard& bd,
+                                     const std::vector<SgPoint>& region) const
+{
+    BOOST_STATIC_ASSERT(SG_BLACK == 0);
+    BOOST_STATIC_ASSERT(SG_WHITE == 1);
+    const SgHashZobrist<64>& zobrist = SgHashZobrist<64>::GetTable();
+    SgHashCode code;
+    code.Clear();
+    for (std::vector<SgPoint>::const_iterator it = region.begin();
+         it != region.end(); ++it)
+    {
+        const SgBoardColor c = bd.GetColor(*it);
+        if (c != SG_EMPTY)
+            code.Xor(zobrist.Get(*it + c * SG_MAXPOINT));
+    }
+    return code;
+}
+
+int GoLadderCache::Search(Entry* entry, const Key& key, const GoBoard& bd,
+                          SgPoint prey, SgBlackWhite firstColor,
+                          SgVector<SgPoint>* sequence, bool twoLibIsEscape)
+{
+    ++m_statistics.m_nuSearches;
+    m_moves.Clear();
+    m_ladder.SetRecordMoves(&m_moves);
+    m_ladder.CheckAndClearOverflow();
+    int result = 0;
+    if (key.m_firstMove == SG_NULLMOVE)
+        result = m_ladder.Ladder(bd, prey, key.m_toPlay, sequence,
+                                 twoLibIsEscape);
+    else
+    {
+        // As in GoLadderUtil::IsLadderCaptureMove() and
+        // GoLadderUtil::IsLadderEscapeMove()
+        GoModBoard modBoard(bd);
+        GoBoard& playBoard = modBoard.Board();
+        GoRestoreToPlay restoreToPlay(playBoard);
+        playBoard.SetToPlay(firstColor);
+        m_moves.Include(key.m_firstMove);
+        if (GoBoardUtil::PlayIfLegal(playBoard, key.m_firstMove, firstColor))
+        {
+            result = m_ladder.Ladder(playBoard, prey, key.m_toPlay, 0,
+                                     twoLibIsEscape);
+            playBoard.Undo();
+        }
+    }
+    m_ladder.SetRecordMoves(0);
+    if (entry != 0)
+    {
+        if (m_ladder.CheckAndClearOverflow())
+            entry->m_isValid = false;
+        else
+        {
+            entry->m_key = key;
+            entry->m_result = result;
+            entry->m_hasSequence = (sequence != 0);
+            if (sequence != 0)
+                entry->m_sequence = *sequence;
+            StoreRegion(*entry, bd, prey);
+            entry->m_isValid = true;
+        }
+    }
+    return result;
+}
+
+void GoLadderCache::StoreRegion(Entry& entry, const GoBoard& bd, SgPoint prey)
+{
+    const int size = bd.Size();
+    // Moves and prey, extended by the adjacent blocks, which can merge with
+    // the prey or be captured by a move
+    SgPointSet core(m_moves);
+    for (GoBoard::StoneIterator it(bd, prey); it; ++it)
+        core.Include(*it);
+    SgPointSet near(core);
+    near.Grow(size);
+    for (SgSetIterator it(near); it; ++it)
+        if (bd.Occupied(*it) && ! core.Contains(*it))
+            for (GoBoard::StoneIterator it2(bd, *it); it2; ++it2)
+                core.Include(*it2);
+    // Blocks adjacent to the core, e.g. hunter blocks in atari next to the
+    // prey, with their liberties
+    near = core;
+    near.Grow(size);
+    SgPointSet blocks;
+    for (SgSetIterator it(near); it; ++it)
+        if (bd.Occupied(*it) && ! blocks.Contains(*it))
+            for (GoBoard::StoneIterator it2(bd, *it); it2; ++it2)
+                blocks.Include(*it2);
+    blocks.Grow(size);
+    // Neighbors of the liberties of the prey
+    SgPointSet region(near);
+    region.Grow(size);
+    region |= blocks;
+    entry.m_region.clear();
+    for (SgSetIterator it(region); it; ++it)
+        entry.m_region.push_back(*it);
+    entry.m_regionCode = RegionCode(bd, entry.m_region);
+}
+
+//----------------------------------------------------------------------------
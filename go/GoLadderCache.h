@@ -0,0 +1,271 @@
+//----------------------------------------------------------------------------
+/** @file GoLadderCache.h
+    Store for results of ladder searches. */
+//----------------------------------------------------------------------------
+
+#ifndef GO_LADDERCACHE_H
+#define GO_LADDERCACHE_H
+
+#include <iosfwd>
+#include <vector>
+#include "GoBoard.h"
+#include "GoLadder.h"
+#include "SgHash.h"
+#include "SgPointSet.h"
+#include "SgVector.h"
+
+//----------------------------------------------------------------------------
+
+/** Statistics of a GoLadderCache. */
+struct GoLadderCacheStatistics
+{
+    /** Number of positions (e.g. nodes of a search tree) that ladders were
+        read in, see GoLadderCache::StartPosition() */
+    std::size_t m_nuPositions;
+
+    /** Number of ladder searches done. */
+    std::size_t m_nuSearches;
+
+    /** Number of ladder searches avoided by reusing a stored result. */
+    std::size_t m_nuAvoided;
+
+    GoLadderCacheStatistics();
+
+    void Add(const GoLadderCacheStatistics& other);
+
+    void Clear();
+
+    /** Write the statistics in a single line. */
+    void Write(std::ostream& out) const;
+};
+
+//----------------------------------------------------------------------------
+
+/** Cached versions of the ladder functions used by the move knowledge and
+    move filters.
+    A result is stored together with the region of the board that the
+    ladder search depended on and a hash code of the stones in this region.
+    The key of an entry is the query (function, prey block anchor, first
+    move, color to play); the entry is reused, as long as the stones in the
+    region are unchanged, independent of moves played elsewhere on the board.
+    Therefore results are reused between positions of a search tree or
+    between the positions of a game. There is no explicit invalidation: a
+    move that touches the path or the liberties of a stored ladder changes
+    the hash code of its region.
+
+    The region consists of all points within distance two of the prey block
+    and of the moves tried by the search (see GoLadder::SetRecordMoves()),
+    and all blocks (with their liberties) within distance one of them. This
+    contains all points whose contents the ladder search reads, including
+    the liberties of blocks that can be captured or merged during the ladder.
+
+    The entries are organized in sets of NU_WAYS entries, selected by the
+    key. Several results for the same query, e.g. for the positions in
+    different subtrees of a search, in which the region of the ladder
+    differs, can be stored at the same time.
+
+    The legality of moves is assumed to depend only on the region and the ko
+    point, which is part of the key. With positional superko rules, a cached
+    result can in rare cases differ from a new search. Results of searches
+    that hit the move number limit of GoLadder are not stored.
+
+    Only the status of the prey (the sign of the result) is guaranteed to
+    be equal to a new search. The depth in the result of GoLadder::Ladder()
+    and the sequence depend on the order of the liberties of the blocks in
+    GoBoard, which depends on the history of moves and takebacks, and can
+    differ even between two searches in the same position without a
+    cache.
+
+    Not thread-safe; use one instance per thread. */
+class GoLadderCache
+{
+public:
+    /** Number of entries per set. */
+    static const int NU_WAYS = 4;
+
+    /** Constructor.
+        @param nuEntries The number of entries (rounded up to a multiple of
+        NU_WAYS). Zero disables storing results, all queries are
+        searched. */
+    explicit GoLadderCache(std::size_t nuEntries = 1024);
+
+    /** Remove all entries. */
+    void Clear();
+
+    /** Cached version of GoLadder::Ladder()
+        @param bd
+        @param prey
+        @param toPlay
+        @param sequence
+        @param twoLibIsEscape
+        @param[out] region If not null, the points that the result depends
+        on, see class description. All points of the board, if the result
+        could not be stored. Can be used by callers that keep their own
+        results derived from the ladder and know which points changed. */
+    int Ladder(const GoBoard& bd, SgPoint prey, SgBlackWhite toPlay,
+               SgVector<SgPoint>* sequence, bool twoLibIsEscape = false,
+               SgPointSet* region = 0);
+
+    /** Cached version of GoLadderUtil::IsLadderCaptureMove() */
+    bool IsLadderCaptureMove(const GoBoard& bd, SgPoint prey,
+                             SgPoint firstMove);
+
+    /** Cached version of GoLadderUtil::IsLadderEscapeMove() */
+    bool IsLadderEscapeMove(const GoBoard& bd, SgPoint prey,
+                            SgPoint firstMove);
+
+    /** Cached version of GoLadderUtil::FindLadderEscapeMoves() */
+    void FindLadderEscapeMoves(const GoBoard& bd, SgPoint prey,
+                               SgVector<SgPoint>& escapeMoves);
+
+    /** @name Statistics */
+    // @{
+
+    /** Count a position for the statistics.
+        Should be called once per position that ladders are read in, to get
+        the number of avoided ladder searches per position. */
+    void StartPosition();
+
+    const GoLadderCacheStatistics& Statistics() const;
+
+    void ClearStatistics();
+
+    // @} // @name
+
+private:
+    /** Type of a query. */
+    enum QueryType
+    {
+        /** GoLadder::Ladder() with twoLibIsEscape false */
+        LADDER,
+
+        /** GoLadder::Ladder() with twoLibIsEscape true */
+        LADDER_TWO_LIB_IS_ESCAPE,
+
+        /** GoLadderUtil::IsLadderCaptureMove() */
+        CAPTURE_MOVE,
+
+        /** GoLadderUtil::IsLadderEscapeMove() */
+        ESCAPE_MOVE
+    };
+
+    /** Query of a stored result. */
+    struct Key
+    {
+        QueryType m_type;
+
+        SgPoint m_anchor;
+
+        /** Move played before the ladder search or SG_NULLMOVE */
+        SgPoint m_firstMove;
+
+        SgBlackWhite m_toPlay;
+
+        SgPoint m_koPoint;
+
+        int m_size;
+
+        Key();
+
+        Key(const GoBoard& bd, QueryType type, SgPoint prey,
+            SgPoint firstMove, SgBlackWhite toPlay);
+
+        bool operator==(const Key& key) const;
+
+        std::size_t Hash() const;
+    };
+
+    struct Entry
+    {
+        Key m_key;
+
+        /** Is the entry used? */
+        bool m_isValid;
+
+        /** Was the sequence of a ladder stored? */
+        bool m_hasSequence;
+
+        /** Return value of GoLadder::Ladder() */
+        int m_result;
+
+        SgVector<SgPoint> m_sequence;
+
+        /** Points that the result depends on. */
+        std::vector<SgPoint> m_region;
+
+        /** Hash code of the stones in m_region. */
+        SgHashCode m_regionCode;
+
+        Entry();
+    };
+
+    std::vector<Entry> m_entries;
+
+    /** Counter for selecting the replaced entry of a full set. */
+    std::size_t m_nextWay;
+
+    GoLadder m_ladder;
+
+    /** Moves tried by the current ladder search. */
+    SgPointSet m_moves;
+
+    GoLadderCacheStatistics m_statistics;
+
+    /** Find a stored result.
+        @param bd
+        @param key
+        @param needSequence Only use entries with a stored ladder sequence
+        @param[out] entry The entry for storing the result of the query
+        (0 if the cache is disabled); an unused entry of the set or the
+        next entry of the set in round-robin order
+        @return @c true if a valid result was found in @c entry */
+    bool Find(const GoBoard& bd, const Key& key, bool needSequence,
+              Entry*& entry);
+
+    /** Get the region of a stored result for Ladder().
+        @param bd
+        @param key
+        @param entry The entry of the query (0 if the cache is disabled)
+        @param[out] region */
+    void GetRegion(const GoBoard& bd, const Key& key, const Entry* entry,
+                   SgPointSet& region) const;
+
+    SgHashCode RegionCode(const GoBoard& bd,
+                          const std::vector<SgPoint>& region) const;
+
+    /** Do a ladder search and store the result in an entry, if possible.
+        @param entry The entry for the query as returned by Find()
+        @param key
+        @param bd
+        @param prey
+        @param firstColor The color of the first move of the key (if any)
+        @param sequence See GoLadder::Ladder()
+        @param twoLibIsEscape See GoLadder::Ladder()
+        @return The return value of GoLadder::Ladder() or 0, if the first
+        move is illegal */
+    int Search(Entry* entry, const Key& key, const GoBoard& bd, SgPoint prey,
+               SgBlackWhite firstColor, SgVector<SgPoint>* sequence,
+               bool twoLibIsEscape);
+
+    void StoreRegion(Entry& entry, const GoBoard& bd, SgPoint prey);
+
+    /** Not implemented */
+    GoLadderCache(const GoLadderCache&);
+
+    /** Not implemented */
+    GoLadderCache& operator=(const GoLadderCache&);
+};
+
+inline const GoLadderCacheStatistics& GoLadderCache::Statistics() const
+{
+    return m_statistics;
+}
+
+inline void GoLadderCache::StartPosition()
+{
+    ++m_statistics.m_nuPositions;
+}
+
+//----------------------------------------------------------------------------
+
+#endif // GO_LADDERCACHE_H
@@ -0,0 +1,181 @@
+//----------------------------------------------------------------------------
+/** @file GoNeighborhoodHash.cpp
+    See GoNeighborhoodHash.h */
+//----------------------------------------------------------------------------
+
+#include "SgSystem.h"
+#include "GoNeighborhoodHash.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <boost/static_assert.hpp>
+
+//----------------------------------------------------------------------------
+
+namespace {
+
+/** Constant data shared by all instances of GoNeighborhoodHash. */
+struct Tables
+{
+    static const int MAX_NU_POINTS = GoNeighborhoodHash::MAX_NU_POINTS;
+
+    static const int MAX_RADIUS = GoNeighborhoodHash::MAX_RADIUS;
+
+    int m_deltaCol[MAX_NU_POINTS];
+
+    int m_deltaRow[MAX_NU_POINTS];
+
+    /** Offset of the point in the SgPoint numbering */
+    int m_offset[MAX_NU_POINTS];
+
+    /** Smallest radius - MIN_RADIUS of the neighborhoods that contain the
+        point. */
+    int m_firstRadius[MAX_NU_POINTS];
+
+    /** Indexed by deltaCol + MAX_RADIUS, deltaRow + MAX_RADIUS */
+    int m_index[2 * MAX_RADIUS + 1][2 * MAX_RADIUS + 1];
+
+    /** Indexed by 4 * index + color (SG_EMPTY unused) */
+    SgHashCode m_key[4 * MAX_NU_POINTS];
+
+    Tables();
+};
+
+Tables::Tables()
+{
+    for (int c = 0; c <= 2 * MAX_RADIUS; ++c)
+        for (int r = 0; r <= 2 * MAX_RADIUS; ++r)
+            m_index[c][r] = -1;
+    int i = 0;
+    for (int d = 0; d <= MAX_RADIUS; ++d)
+        for (int deltaRow = -d; deltaRow <= d; ++deltaRow)
+            for (int deltaCol = -d; deltaCol <= d; ++deltaCol)
+            {
+                if (std::abs(deltaCol) + std::abs(deltaRow) != d)
+                    continue;
+                m_deltaCol[i] = deltaCol;
+                m_deltaRow[i] = deltaRow;
+                m_offset[i] = deltaRow * SG_NS + deltaCol * SG_WE;
+                m_firstRadius[i] =
+                    std::max(d, int(GoNeighborhoodHash::MIN_RADIUS))
+                    - GoNeighborhoodHash::MIN_RADIUS;
+                m_index[deltaCol + MAX_RADIUS][deltaRow + MAX_RADIUS] = i;
+                ++i;
+            }
+    SG_ASSERT(i == MAX_NU_POINTS);
+    // Fixed keys instead of SgHashCode::Random(), see class documentation
+    for (int j = 0; j < 4 * MAX_NU_POINTS; ++j)
+        m_key[j] = SgHashCode(0x4e48u + j);
+}
+
+const Tables& GetTables()
+{
+    static const Tables tables;
+    return tables;
+}
+
+} // namespace
+
+//----------------------------------------------------------------------------
+
+GoNeighborhoodHash::GoNeighborhoodHash()
+{
+    Init(SG_MAX_SIZE);
+}
+
+int GoNeighborhoodHash::DeltaCol(int index)
+{
+    SG_ASSERTRANGE(index, 0, MAX_NU_POINTS - 1);
+    return GetTables().m_deltaCol[index];
+}
+
+int GoNeighborhoodHash::DeltaRow(int index)
+{
+    SG_ASSERTRANGE(index, 0, MAX_NU_POINTS - 1);
+    return GetTables().m_deltaRow[index];
+}
+
+int GoNeighborhoodHash::Index(int deltaCol, int deltaRow)
+{
+    if (std::abs(deltaCol) + std::abs(deltaRow) > MAX_RADIUS)
+        return -1;
+    return GetTables().m_index[deltaCol + MAX_RADIUS][deltaRow + MAX_RADIUS];
+}
+
+void GoNeighborhoodHash::Init(int size)
+{
+    SG_ASSERTRANGE(size, SG_MIN_SIZE, SG_MAX_SIZE);
+    const Tables& tables = GetTables();
+    for (int i = 0; i < ARRAY_SIZE; ++i)
+        for (int k = 0; k < NU_RADIUS; ++k)
+            m_hash[i][k].Clear();
+    for (SgGrid row = 1; row <= size; ++row)
+        for (SgGrid col = 1; col <= size; ++col)
+        {
+            const int p = SgPointUtil::Pt(col, row) + PADDING;
+            for (int i = 0; i < MAX_NU_POINTS; ++i)
+            {
+                const int c = col + tables.m_deltaCol[i];
+                const int r = row + tables.m_deltaRow[i];
+                if (c >= 1 && c <= size && r >= 1 && r <= size)
+                    continue;
+                const SgHashCode& key = tables.m_key[4 * i + SG_BORDER];
+                for (int k = tables.m_firstRadius[i]; k < NU_RADIUS; ++k)
+                    m_hash[p][k].Xor(key);
+            }
+        }
+}
+
+const SgHashCode& GoNeighborhoodHash::Key(int index, SgBoardColor c)
+{
+    SG_ASSERTRANGE(index, 0, MAX_NU_POINTS - 1);
+    SG_ASSERT(c == SG_BLACK || c == SG_WHITE || c == SG_BORDER);
+    return GetTables().m_key[4 * index + c];
+}
+
+void GoNeighborhoodHash::XorStone(SgPoint p, SgBlackWhite c)
+{
+    SG_ASSERT_BOARDRANGE(p);
+    SG_ASSERT_BW(c);
+    BOOST_STATIC_ASSERT(NU_RADIUS == 3);
+    const Tables& tables = GetTables();
+    const int col = SgPointUtil::Col(p);
+    p += PADDING;
+    // The points are ordered by distance, so the neighborhoods of a radius
+    // contain a prefix of them. The neighborhood of q contains p, if
+    // p = q + offset. Columns outside the board would wrap around to the
+    // neighboring row, rows outside the board are covered by the padding.
+    const int nuPoints2 = NuPoints(MIN_RADIUS);
+    const int nuPoints3 = NuPoints(MIN_RADIUS + 1);
+    int i = 0;
+    for ( ; i < nuPoints2; ++i)
+    {
+        const int qCol = col - tables.m_deltaCol[i];
+        if (qCol < 1 || qCol > SG_MAX_SIZE)
+            continue;
+        const SgHashCode& key = tables.m_key[4 * i + c];
+        SgHashCode* hash = m_hash[p - tables.m_offset[i]];
+        hash[0].Xor(key);
+        hash[1].Xor(key);
+        hash[2].Xor(key);
+    }
+    for ( ; i < nuPoints3; ++i)
+    {
+        const int qCol = col - tables.m_deltaCol[i];
+        if (qCol < 1 || qCol > SG_MAX_SIZE)
+            continue;
+        const SgHashCode& key = tables.m_key[4 * i + c];
+        SgHashCode* hash = m_hash[p - tables.m_offset[i]];
+        hash[1].Xor(key);
+        hash[2].Xor(key);
+    }
+    for ( ; i < MAX_NU_POINTS; ++i)
+    {
+        const int qCol = col - tables.m_deltaCol[i];
+        if (qCol < 1 || qCol > SG_MAX_SIZE)
+            continue;
+        m_hash[p - tables.m_offset[i]][2].Xor(tables.m_key[4 * i + c]);
+    }
+}
+
+//----------------------------------------------------------------------------
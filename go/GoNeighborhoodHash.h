@@ -0,0 +1,151 @@
+//----------------------------------------------------------------------------
+/** @file GoNeighborhoodHash.h
+    Incremental Zobrist hash codes of the neighborhoods of points. */
+//----------------------------------------------------------------------------
+
+#ifndef GO_NEIGHBORHOODHASH_H
+#define GO_NEIGHBORHOODHASH_H
+
+#include "SgArray.h"
+#include "SgBoardColor.h"
+#include "SgHash.h"
+#include "SgPoint.h"
+
+//----------------------------------------------------------------------------
+
+/** Zobrist hash codes of the neighborhoods of all points of a board.
+    The neighborhood of radius r of a point contains the points with a
+    Manhattan distance of at most r (a diamond, like the Greenpeep
+    patterns). Hash codes are kept for the radii MIN_RADIUS to MAX_RADIUS
+    and updated with XorStone() whenever a stone is added or removed, at a
+    cost of 79 XOR operations per stone and without any tests whether the
+    points are on the board.
+
+    The points of the neighborhood are numbered by Index(): sorted by
+    distance, then by row offset, then by column offset. The hash code of a
+    neighborhood is the XOR of Key() of the indices and colors of its
+    points; empty points contribute nothing, points outside the board
+    contribute the key of SG_BORDER. The keys are independent of the random
+    seed, so that hash codes of patterns can be stored in files.
+
+    Used optionally by GoBoard and GoUctBoard, see
+    GoBoard::SetNeighborhoodHash(). */
+class GoNeighborhoodHash
+{
+public:
+    static const int MIN_RADIUS = 2;
+
+    static const int MAX_RADIUS = 4;
+
+    static const int NU_RADIUS = MAX_RADIUS - MIN_RADIUS + 1;
+
+    /** Number of points in the neighborhood of MAX_RADIUS */
+    static const int MAX_NU_POINTS = 2 * MAX_RADIUS * (MAX_RADIUS + 1) + 1;
+
+    GoNeighborhoodHash();
+
+    /** Initialize the hash codes for an empty board. */
+    void Init(int size);
+
+    /** Initialize the hash codes for the position of a board.
+        @tparam BOARD GoBoard or GoUctBoard */
+    template<class BOARD>
+    void Init(const BOARD& bd);
+
+    /** Update the hash codes for a stone added to or removed from a
+        point. */
+    void XorStone(SgPoint p, SgBlackWhite c);
+
+    /** The hash code of the neighborhood of a point.
+        @param p A point on the board
+        @param radius MIN_RADIUS..MAX_RADIUS */
+    const SgHashCode& Get(SgPoint p, int radius) const;
+
+    /** Compute the hash code of the neighborhood of a point from scratch.
+        Gives the same result as Get() on a board with incremental hash
+        codes; does not need MIN_RADIUS <= radius.
+        @tparam BOARD GoBoard or GoUctBoard */
+    template<class BOARD>
+    static SgHashCode Compute(const BOARD& bd, SgPoint p, int radius);
+
+    /** Number of points within a distance. */
+    static int NuPoints(int radius);
+
+    /** Index of a point in the neighborhood.
+        @return The index or -1, if the distance is larger than
+        MAX_RADIUS */
+    static int Index(int deltaCol, int deltaRow);
+
+    static int DeltaCol(int index);
+
+    static int DeltaRow(int index);
+
+    /** Key of a point of the neighborhood with a color.
+        @param index See Index()
+        @param c SG_BLACK, SG_WHITE or SG_BORDER */
+    static const SgHashCode& Key(int index, SgBoardColor c);
+
+private:
+    /** Padding of the arrays, so that XorStone() can update the hash codes
+        of the rows within MAX_RADIUS of the board without range checks.
+        Columns outside the board are skipped, see XorStone(). */
+    static const int PADDING = MAX_RADIUS * SG_NS;
+
+    static const int ARRAY_SIZE = SG_MAXPOINT + 2 * PADDING;
+
+    /** Hash codes indexed by point + PADDING and radius - MIN_RADIUS.
+        The hash codes of the neighborhoods of a point are adjacent in
+        memory, XorStone() updates them together. */
+    SgHashCode m_hash[ARRAY_SIZE][NU_RADIUS];
+};
+
+template<class BOARD>
+void GoNeighborhoodHash::Init(const BOARD& bd)
+{
+    Init(bd.Size());
+    for (typename BOARD::Iterator it(bd); it; ++it)
+        if (bd.Occupied(*it))
+            XorStone(*it, bd.GetStone(*it));
+}
+
+template<class BOARD>
+SgHashCode GoNeighborhoodHash::Compute(const BOARD& bd, SgPoint p, int radius)
+{
+    SG_ASSERT(bd.IsValidPoint(p));
+    SG_ASSERTRANGE(radius, 0, MAX_RADIUS);
+    const int col = SgPointUtil::Col(p);
+    const int row = SgPointUtil::Row(p);
+    const int size = bd.Size();
+    SgHashCode hash;
+    for (int i = 0; i < NuPoints(radius); ++i)
+    {
+        const int c = col + DeltaCol(i);
+        const int r = row + DeltaRow(i);
+        if (c < 1 || c > size || r < 1 || r > size)
+            hash.Xor(Key(i, SG_BORDER));
+        else
+        {
+            const SgPoint q = SgPointUtil::Pt(c, r);
+            if (bd.Occupied(q))
+                hash.Xor(Key(i, bd.GetStone(q)));
+        }
+    }
+    return hash;
+}
+
+inline const SgHashCode& GoNeighborhoodHash::Get(SgPoint p, int radius) const
+{
+    SG_ASSERT_BOARDRANGE(p);
+    SG_ASSERTRANGE(radius, MIN_RADIUS, MAX_RADIUS);
+    return m_hash[p + PADDING][radius - MIN_RADIUS];
+}
+
+inline int GoNeighborhoodHash::NuPoints(int radius)
+{
+    SG_ASSERTRANGE(radius, 0, MAX_RADIUS);
+    return 2 * radius * (radius + 1) + 1;
+}
+
+//----------------------------------------------------------------------------
+
+#endif // GO_NEIGHBORHOODHASH_H
@@ -16,6 +16,44 @@ using SgPointUtil::Pt;
 
 namespace {
 
+/** Synchronizer that counts the calls of the hook functions. */
+class CountingSynchronizer
+    : public GoBoardSynchronizer
+{
+public:
+    int m_nuBoardChange;
+
+    int m_nuPlay;
+
+    int m_nuUndo;
+
+    CountingSynchronizer(const GoBoard& publisher)
+        : GoBoardSynchronizer(publisher),
+          m_nuBoardChange(0),
+          m_nuPlay(0),
+          m_nuUndo(0)
+    { }
+
+protected:
+    void OnBoardChange()
+    {
+        ++m_nuBoardChange;
+    }
+
+    void OnPlay(GoPlayerMove move)
+    {
+        SG_UNUSED(move);
+        ++m_nuPlay;
+    }
+
+    void OnUndo()
+    {
+        ++m_nuUndo;
+    }
+};
+
+//----------------------------------------------------------------------------
+
 BOOST_AUTO_TEST_CASE(GoBoardSynchronizerTest_Update)
 {
     GoBoard publisher;
@@ -30,6 +68,46 @@ BOOST_AUTO_TEST_CASE(GoBoardSynchronizerTest_Update)
     BOOST_CHECK_EQUAL(subscriber.Move(1), GoPlayerMove(SG_WHITE, Pt(2, 2)));
 }
 
+/** Test GoBoardSynchronizer::Update, if the subscriber is far behind.
+    The subscriber is updated with GoBoard::CopyFrom() and only
+    OnBoardChange() is called. */
+BOOST_AUTO_TEST_CASE(GoBoardSynchronizerTest_Update_Copy)
+{
+    GoBoard publisher(19);
+    GoBoard subscriber(9);
+    CountingSynchronizer synchronizer(publisher);
+    synchronizer.SetSubscriber(subscriber);
+    const int nuMoves = GoBoardSynchronizer::MIN_MOVES_COPY;
+    for (int i = 1; i <= nuMoves / 2; ++i)
+    {
+        publisher.Play(Pt(i, 1), SG_BLACK);
+        publisher.Play(Pt(i, 3), SG_WHITE);
+    }
+    synchronizer.UpdateSubscriber();
+    BOOST_CHECK_EQUAL(synchronizer.m_nuBoardChange, 1);
+    BOOST_CHECK_EQUAL(synchronizer.m_nuPlay, 0);
+    BOOST_CHECK_EQUAL(subscriber.Size(), 19);
+    BOOST_CHECK_EQUAL(subscriber.MoveNumber(), nuMoves);
+    BOOST_CHECK_EQUAL(subscriber.Move(nuMoves - 1),
+                      GoPlayerMove(SG_WHITE, Pt(nuMoves / 2, 3)));
+    BOOST_CHECK(subscriber.GetHashCode() == publisher.GetHashCode());
+    // Few changes are replayed
+    publisher.Undo();
+    publisher.Play(Pt(10, 10), SG_WHITE);
+    synchronizer.UpdateSubscriber();
+    BOOST_CHECK_EQUAL(synchronizer.m_nuBoardChange, 1);
+    BOOST_CHECK_EQUAL(synchronizer.m_nuUndo, 1);
+    BOOST_CHECK_EQUAL(synchronizer.m_nuPlay, 1);
+    BOOST_CHECK(subscriber.GetHashCode() == publisher.GetHashCode());
+    // Many changes are copied
+    for (int i = 0; i < nuMoves; ++i)
+        publisher.Undo();
+    synchronizer.UpdateSubscriber();
+    BOOST_CHECK_EQUAL(synchronizer.m_nuBoardChange, 2);
+    BOOST_CHECK_EQUAL(synchronizer.m_nuUndo, 1);
+    BOOST_CHECK_EQUAL(subscriber.MoveNumber(), 0);
+}
+
 /** Test GoBoardSynchronizer::Update, if setup changed. */
 BOOST_AUTO_TEST_CASE(GoBoardSynchronizerTest_Update_Setup)
 {
@@ -7,7 +7,9 @@
 
 #include <boost/test/auto_unit_test.hpp>
 #include "GoBoard.h"
+#include "GoNeighborhoodHash.h"
 #include "GoSetupUtil.h"
+#include "SgRandom.h"
 #include "SgWrite.h"
 
 using SgPointUtil::Pt;
@@ -18,6 +20,43 @@ namespace {
 
 //----------------------------------------------------------------------------
 
+/** Play random legal moves, or a pass if there is no legal move. */
+void PlayRandomLegalMoves(GoBoard& bd, int nuMoves, SgRandom& random)
+{
+    for (int i = 0; i < nuMoves; ++i)
+    {
+        GoPointList moves;
+        for (GoBoard::Iterator it(bd); it; ++it)
+            if (bd.IsLegal(*it))
+                moves.PushBack(*it);
+        bd.Play(moves.IsEmpty() ? SG_PASS
+                : moves[random.Int(moves.Length())]);
+    }
+}
+
+/** Check the blocks of a board against a board with the same moves
+    played from the start. */
+void CheckBlocksAfterReplay(const GoBoard& bd)
+{
+    GoBoard replay(bd.Size());
+    for (int i = 0; i < bd.MoveNumber(); ++i)
+        replay.Play(bd.Move(i));
+    BOOST_CHECK(replay.GetHashCode() == bd.GetHashCode());
+    for (GoBoard::Iterator it(bd); it; ++it)
+    {
+        BOOST_REQUIRE_EQUAL(replay.GetColor(*it), bd.GetColor(*it));
+        if (bd.Occupied(*it))
+        {
+            BOOST_CHECK_EQUAL(replay.Anchor(*it), bd.Anchor(*it));
+            BOOST_CHECK_EQUAL(replay.NumStones(*it), bd.NumStones(*it));
+            BOOST_CHECK_EQUAL(replay.NumLiberties(*it),
+                              bd.NumLiberties(*it));
+        }
+    }
+}
+
+//----------------------------------------------------------------------------
+
 /** Test constructor with GoSetup argument. */
 BOOST_AUTO_TEST_CASE(GoBoardTest_Constructor_Setup)
 {
@@ -131,6 +170,45 @@ BOOST_AUTO_TEST_CASE(GoBoardTest_CapturedStones)
     BOOST_CHECK(bd.CapturedStones().Contains(Pt(1, 1)));
 }
 
+/** Test GoBoard::CopyFrom after a random game.
+    The copy needs to have the same position and history and needs to be
+    independent of the original board. */
+BOOST_AUTO_TEST_CASE(GoBoardTest_CopyFrom)
+{
+    SgRandom random;
+    GoBoard bd(9);
+    bd.Rules().SetKoRule(GoRules::POS_SUPERKO);
+    PlayRandomLegalMoves(bd, 200, random);
+    GoBoard copy(13);
+    copy.SetNeighborhoodHash(true);
+    PlayRandomLegalMoves(copy, 20, random);
+    copy.CopyFrom(bd);
+    BOOST_CHECK_EQUAL(copy.Size(), 9);
+    BOOST_CHECK(copy.Rules() == bd.Rules());
+    BOOST_CHECK_EQUAL(copy.MoveNumber(), bd.MoveNumber());
+    for (int i = 0; i < bd.MoveNumber(); ++i)
+        BOOST_CHECK_EQUAL(copy.Move(i), bd.Move(i));
+    BOOST_CHECK(copy.GetHashCode() == bd.GetHashCode());
+    BOOST_CHECK_EQUAL(copy.KoPoint(), bd.KoPoint());
+    CheckBlocksAfterReplay(copy);
+    for (GoBoard::Iterator it(bd); it; ++it)
+    {
+        BOOST_CHECK_EQUAL(copy.IsLegal(*it), bd.IsLegal(*it));
+        BOOST_CHECK(copy.NeighborhoodHash()->Get(*it, 3)
+                    == GoNeighborhoodHash::Compute(copy, *it, 3));
+    }
+    // Changing the original does not change the copy
+    for (int i = 0; i < 50; ++i)
+        bd.Undo();
+    CheckBlocksAfterReplay(copy);
+    PlayRandomLegalMoves(copy, 50, random);
+    CheckBlocksAfterReplay(copy);
+    while (copy.MoveNumber() > 0)
+        copy.Undo();
+    BOOST_CHECK(copy.All(SG_BLACK).IsEmpty());
+    BOOST_CHECK(copy.All(SG_WHITE).IsEmpty());
+}
+
 /** Check default settings in GoBoard.
     Checks the default values of settings in GoBoard that some other code
     does rely on. */
@@ -407,6 +485,63 @@ BOOST_AUTO_TEST_CASE(GoBoardTest_IsLegal_PositionalSuperko)
     BOOST_CHECK(bd.IsLegal(Pt(2, 9), SG_WHITE));
 }
 
+/** Compare IsLegal() with a check against all earlier positions in random
+    games with many captures and repetitions on a small board. */
+BOOST_AUTO_TEST_CASE(GoBoardTest_IsLegal_Superko_Random)
+{
+    SgRandom random;
+    int nuRepetitions = 0;
+    for (int game = 0; game < 6; ++game)
+    {
+        GoBoard bd(3);
+        const GoRules::KoRule koRule =
+            (game % 2 == 0 ? GoRules::POS_SUPERKO : GoRules::SUPERKO);
+        std::vector<std::pair<SgBWSet,SgBlackWhite> > positions;
+        positions.push_back(std::make_pair(
+              SgBWSet(bd.All(SG_BLACK), bd.All(SG_WHITE)), bd.ToPlay()));
+        for (int i = 0; i < 200; ++i)
+        {
+            GoPointList moves;
+            for (GoBoard::Iterator it(bd); it; ++it)
+            {
+                const SgPoint p = *it;
+                if (! bd.IsEmpty(p))
+                    continue;
+                bd.Rules().SetKoRule(GoRules::SIMPLEKO);
+                bool isLegal = bd.IsLegal(p);
+                if (isLegal)
+                {
+                    bd.Play(p);
+                    const SgBWSet stones(bd.All(SG_BLACK),
+                                         bd.All(SG_WHITE));
+                    for (std::size_t j = 0; j < positions.size(); ++j)
+                        if (  positions[j].first == stones
+                           && (  koRule == GoRules::POS_SUPERKO
+                              || positions[j].second == bd.ToPlay()
+                              )
+                           )
+                        {
+                            isLegal = false;
+                            ++nuRepetitions;
+                            break;
+                        }
+                    bd.Undo();
+                }
+                bd.Rules().SetKoRule(koRule);
+                BOOST_CHECK_EQUAL(bd.IsLegal(p), isLegal);
+                if (isLegal)
+                    moves.PushBack(p);
+            }
+            bd.Play(moves.IsEmpty() ? SG_PASS
+                    : moves[random.Int(moves.Length())]);
+            BOOST_REQUIRE(! bd.LastMoveInfo(GO_MOVEFLAG_ILLEGAL));
+            positions.push_back(std::make_pair(
+                  SgBWSet(bd.All(SG_BLACK), bd.All(SG_WHITE)), bd.ToPlay()));
+        }
+    }
+    BOOST_CHECK(nuRepetitions > 0);
+}
+
 BOOST_AUTO_TEST_CASE(GoBoardTest_IsLegal_Occupied)
 {
     GoSetup setup;
@@ -727,6 +862,25 @@ BOOST_AUTO_TEST_CASE(GoBoardTest_Line_19)
     }
 }
 
+/** Test that the memory of the stacks grows with the game length. */
+BOOST_AUTO_TEST_CASE(GoBoardTest_MemoryUsed)
+{
+    SgRandom random;
+    GoBoard bd(9);
+    const std::size_t initialMemory = bd.MemoryUsed();
+    PlayRandomLegalMoves(bd, 300, random);
+    const std::size_t memory = bd.MemoryUsed();
+    BOOST_CHECK_GT(memory, initialMemory);
+    CheckBlocksAfterReplay(bd);
+    while (bd.MoveNumber() > 0)
+        bd.Undo();
+    BOOST_CHECK(bd.All(SG_BLACK).IsEmpty());
+    BOOST_CHECK(bd.All(SG_WHITE).IsEmpty());
+    // The stacks keep their memory for reuse
+    bd.Init(9);
+    BOOST_CHECK_EQUAL(bd.MemoryUsed(), memory);
+}
+
 /** Test GoBoard::NumLiberties after a combination of setup and play */
 BOOST_AUTO_TEST_CASE(GoBoardTest_NumLiberties_1)
 {
@@ -993,6 +1147,30 @@ BOOST_AUTO_TEST_CASE(GoBoardTest_SetToPlay)
     BOOST_CHECK_EQUAL(bd.ToPlay(), SG_BLACK);
 }
 
+/** Test RestoreSnapshot() after random games with captures. */
+BOOST_AUTO_TEST_CASE(GoBoardTest_TakeSnapshot_Random)
+{
+    SgRandom random;
+    GoBoard bd(9);
+    PlayRandomLegalMoves(bd, 100, random);
+    bd.TakeSnapshot();
+    const int moveNumber = bd.MoveNumber();
+    const SgHashCode hash = bd.GetHashCode();
+    for (int i = 0; i < 3; ++i)
+    {
+        PlayRandomLegalMoves(bd, 150, random);
+        bd.RestoreSnapshot();
+        BOOST_CHECK_EQUAL(bd.MoveNumber(), moveNumber);
+        BOOST_CHECK(bd.GetHashCode() == hash);
+        CheckBlocksAfterReplay(bd);
+    }
+    PlayRandomLegalMoves(bd, 50, random);
+    while (bd.MoveNumber() > moveNumber)
+        bd.Undo();
+    BOOST_CHECK(bd.GetHashCode() == hash);
+    CheckBlocksAfterReplay(bd);
+}
+
 BOOST_AUTO_TEST_CASE(GoBoardTest_ToPlay)
 {
     GoBoard bd(9);
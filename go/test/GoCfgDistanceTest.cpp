@@ -0,0 +1,79 @@
+//----------------------------------------------------------------------------
+/** @file GoCfgDistanceTest.cpp
+    Unit tests for GoCfgDistance. */
+//----------------------------------------------------------------------------
+
+#include "SgSystem.h"
+
+#include <boost/test/auto_unit_test.hpp>
+#include "GoBoard.h"
+#include "GoBoardUtil.h"
+#include "GoCfgDistance.h"
+#include "GoSetupUtil.h"
+#include "SgRandom.h"
+
+using SgPointUtil::Pt;
+
+//----------------------------------------------------------------------------
+
+namespace {
+
+BOOST_AUTO_TEST_CASE(GoCfgDistanceTest_Block)
+{
+    std::string s(". . . . .\n"
+                  ". X X X .\n"
+                  ". . . . .\n"
+                  ". . . . .\n"
+                  ". . . . .\n");
+    int boardSize;
+    GoSetup setup = GoSetupUtil::CreateSetupFromString(s, boardSize);
+    GoBoard bd(boardSize, setup);
+    GoCfgDistance distance;
+    distance.Compute(bd, Pt(1, 4), 2);
+    BOOST_CHECK_EQUAL(distance.Distance(Pt(1, 4)), 0);
+    BOOST_CHECK_EQUAL(distance.Distance(bd.Anchor(Pt(2, 4))), 1);
+    // Adjacent to the block
+    BOOST_CHECK_EQUAL(distance.Distance(Pt(5, 4)), 2);
+    BOOST_CHECK_EQUAL(distance.Distance(Pt(3, 3)), 2);
+    // Beyond the maximum distance
+    BOOST_CHECK_EQUAL(distance.Distance(Pt(3, 2)),
+                      std::numeric_limits<int>::max());
+    BOOST_CHECK_EQUAL(distance.Points()[0], Pt(1, 4));
+}
+
+/** Check that the distances are equal to GoBoardUtil::CfgDistance() in
+    the positions of random games, with a single GoCfgDistance object. */
+BOOST_AUTO_TEST_CASE(GoCfgDistanceTest_RandomGames)
+{
+    SgRandom random;
+    GoCfgDistance distance;
+    for (int game = 0; game < 4; ++game)
+    {
+        GoBoard bd(game % 2 == 0 ? 9 : 19);
+        for (int i = 0; i < 150; ++i)
+        {
+            SgVector<SgPoint> moves;
+            for (GoBoard::Iterator it(bd); it; ++it)
+                if (  bd.IsEmpty(*it)
+                   && bd.IsLegal(*it)
+                   && ! GoBoardUtil::IsCompletelySurrounded(bd, *it)
+                   )
+                    moves.PushBack(*it);
+            if (moves.IsEmpty())
+                break;
+            bd.Play(moves[random.Int(moves.Length())]);
+            const SgPoint focus = bd.GetLastMove();
+            const int maxDist = 1 + random.Int(4);
+            distance.Compute(bd, focus, maxDist);
+            SgPointArray<int> expected =
+                GoBoardUtil::CfgDistance(bd, focus, maxDist);
+            for (GoBoard::Iterator it(bd); it; ++it)
+                if (! bd.Occupied(*it) || bd.Anchor(*it) == *it)
+                    BOOST_CHECK_EQUAL(distance.Distance(*it), expected[*it]);
+        }
+    }
+}
+
+} // namespace
+
+//----------------------------------------------------------------------------
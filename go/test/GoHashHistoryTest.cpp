@@ -0,0 +1,79 @@
+//----------------------------------------------------------------------------
+/** @file GoHashHistoryTest.cpp
+    Unit tests for GoHashHistory. */
+//----------------------------------------------------------------------------
+
+#include "SgSystem.h"
+
+#include <boost/test/auto_unit_test.hpp>
+#include "GoHashHistory.h"
+
+//----------------------------------------------------------------------------
+
+namespace {
+
+BOOST_AUTO_TEST_CASE(GoHashHistoryTest_CopyFrom)
+{
+    GoHashHistory history;
+    history.Push(SgHashCode(1));
+    history.Push(SgHashCode(2));
+    GoHashHistory copy;
+    copy.Push(SgHashCode(3));
+    copy.CopyFrom(history);
+    BOOST_CHECK_EQUAL(copy.Size(), 2);
+    BOOST_CHECK(copy.Contains(SgHashCode(1)));
+    BOOST_CHECK(copy.Contains(SgHashCode(2)));
+    BOOST_CHECK(! copy.Contains(SgHashCode(3)));
+    copy.Pop();
+    copy.Pop();
+    BOOST_CHECK(! copy.Contains(SgHashCode(1)));
+    BOOST_CHECK(history.Contains(SgHashCode(2)));
+}
+
+BOOST_AUTO_TEST_CASE(GoHashHistoryTest_PushPop)
+{
+    GoHashHistory history;
+    const SgHashCode hash1(1);
+    const SgHashCode hash2(2);
+    BOOST_CHECK_EQUAL(history.Size(), 0);
+    BOOST_CHECK(! history.Contains(hash1));
+    history.Push(hash1);
+    history.Push(hash2);
+    history.Push(hash1);
+    BOOST_CHECK_EQUAL(history.Size(), 3);
+    BOOST_CHECK(history.Contains(hash1));
+    BOOST_CHECK(history.Contains(hash2));
+    BOOST_CHECK(! history.Contains(SgHashCode(3)));
+    history.Pop();
+    BOOST_CHECK(history.Contains(hash1));
+    BOOST_CHECK(history.Last() == hash2);
+    history.Pop();
+    BOOST_CHECK(! history.Contains(hash2));
+    history.Clear();
+    BOOST_CHECK_EQUAL(history.Size(), 0);
+    BOOST_CHECK(! history.Contains(hash1));
+}
+
+/** Test hash codes in the same bucket of the index. */
+BOOST_AUTO_TEST_CASE(GoHashHistoryTest_SameBucket)
+{
+    GoHashHistory history;
+    SgHashCode hash1(1);
+    SgHashCode hash2;
+    for (unsigned int i = 2; ; ++i)
+    {
+        hash2 = SgHashCode(i);
+        if (hash2.Hash(4096) == hash1.Hash(4096))
+            break;
+    }
+    history.Push(hash1);
+    BOOST_CHECK(! history.Contains(hash2));
+    history.Push(hash2);
+    history.Pop();
+    BOOST_CHECK(history.Contains(hash1));
+    BOOST_CHECK(! history.Contains(hash2));
+}
+
+} // namespace
+
+//----------------------------------------------------------------------------
@@ -0,0 +1,193 @@
+//----------------------------------------------------------------------------
+/** @file GoLadderCacheTest.cpp
+    Unit tests for GoLadderCache. */
+//----------------------------------------------------------------------------
+
+#include "SgSystem.h"
+
+#include <boost/test/auto_unit_test.hpp>
+#include "GoBoard.h"
+#include "GoBoardUtil.h"
+#include "GoLadderCache.h"
+#include "GoSetupUtil.h"
+#include "SgRandom.h"
+
+using SgPointUtil::Pt;
+
+//----------------------------------------------------------------------------
+
+namespace {
+
+/** Play a random legal move that does not fill an own eye.
+    @return false, if there is no such move */
+bool PlayRandomMove(GoBoard& bd, SgRandom& random)
+{
+    SgVector<SgPoint> moves;
+    for (GoBoard::Iterator it(bd); it; ++it)
+        if (  bd.IsEmpty(*it)
+           && bd.IsLegal(*it)
+           && ! GoBoardUtil::IsCompletelySurrounded(bd, *it)
+           )
+            moves.PushBack(*it);
+    if (moves.IsEmpty())
+        return false;
+    bd.Play(moves[random.Int(moves.Length())]);
+    return true;
+}
+
+/** Sign of a result of GoLadder::Ladder().
+    The absolute value of a result depends on the depth of the ladder,
+    and the depth and the sequence depend on the order of the liberties in
+    the blocks of the board, which changes when moves are played and taken
+    back, even by the ladder search itself. Two searches in the same
+    position can therefore only be compared by the status of the prey. */
+int Sign(int ladderResult)
+{
+    return ladderResult > 0 ? 1 : (ladderResult < 0 ? -1 : 0);
+}
+
+/** Check that the cached results are equal to the results of new ladder
+    searches for all blocks with at most two liberties. */
+void CheckPosition(const GoBoard& bd, GoLadderCache& cache)
+{
+    GoLadder ladder;
+    for (GoBlockIterator it(bd); it; ++it)
+    {
+        const SgPoint prey = *it;
+        const int nuLib = bd.NumLiberties(prey);
+        if (nuLib > 2)
+            continue;
+        for (int i = 0; i < 2; ++i)
+        {
+            const SgBlackWhite toPlay = (i == 0 ? SG_BLACK : SG_WHITE);
+            SgVector<SgPoint> sequence;
+            SgVector<SgPoint> cachedSequence;
+            int result = ladder.Ladder(bd, prey, toPlay, &sequence);
+            BOOST_CHECK_EQUAL(Sign(result),
+                              Sign(cache.Ladder(bd, prey, toPlay,
+                                                &cachedSequence)));
+            BOOST_CHECK_EQUAL(sequence.IsEmpty(), cachedSequence.IsEmpty());
+            result = ladder.Ladder(bd, prey, toPlay, 0, true);
+            BOOST_CHECK_EQUAL(Sign(result),
+                              Sign(cache.Ladder(bd, prey, toPlay, 0, true)));
+        }
+        // Copy liberties, the ladder functions modify the board temporarily
+        SgVector<SgPoint> liberties;
+        for (GoBoard::LibertyIterator it2(bd, prey); it2; ++it2)
+            liberties.PushBack(*it2);
+        for (SgVectorIterator<SgPoint> it2(liberties); it2; ++it2)
+        {
+            if (nuLib == 2)
+                BOOST_CHECK_EQUAL(
+                        GoLadderUtil::IsLadderCaptureMove(bd, prey, *it2),
+                        cache.IsLadderCaptureMove(bd, prey, *it2));
+            else
+            {
+                SgVector<SgPoint> escapeMoves;
+                SgVector<SgPoint> cachedEscapeMoves;
+                GoLadderUtil::FindLadderEscapeMoves(bd, prey, escapeMoves);
+                cache.FindLadderEscapeMoves(bd, prey, cachedEscapeMoves);
+                BOOST_CHECK(escapeMoves == cachedEscapeMoves);
+            }
+        }
+    }
+}
+
+/** Compare cached results with new ladder searches in the positions of
+    random games. */
+BOOST_AUTO_TEST_CASE(GoLadderCacheTest_RandomGames)
+{
+    SgRandom random;
+    GoLadderCache cache;
+    for (int game = 0; game < 20; ++game)
+    {
+        GoBoard bd(9);
+        // Legality with superko depends on the history, see GoLadderCache
+        bd.Rules().SetKoRule(GoRules::SIMPLEKO);
+        for (int i = 0; i < 100; ++i)
+        {
+            if (! PlayRandomMove(bd, random))
+                break;
+            cache.StartPosition();
+            CheckPosition(bd, cache);
+        }
+    }
+    const GoLadderCacheStatistics& statistics = cache.Statistics();
+    BOOST_CHECK(statistics.m_nuSearches > 0);
+    BOOST_CHECK(statistics.m_nuAvoided > 0);
+}
+
+/** Test that a stored result is invalidated by a move on the path of the
+    ladder, but not by a move far away from it. */
+BOOST_AUTO_TEST_CASE(GoLadderCacheTest_Invalidate)
+{
+    std::string s("..........\n"
+                  "..........\n"
+                  "...OO.....\n"
+                  "..OX......\n"
+                  "...O......\n"
+                  "..........\n"
+                  "..........\n"
+                  "..........\n"
+                  "..........\n"
+                  "..........");
+    int boardSize;
+    GoSetup setup = GoSetupUtil::CreateSetupFromString(s, boardSize);
+    setup.m_player = SG_BLACK;
+    GoBoard bd(boardSize, setup);
+    const SgPoint prey = Pt(4, 7);
+    GoLadderCache cache;
+    SgVector<SgPoint> sequence;
+    BOOST_CHECK(cache.Ladder(bd, prey, SG_BLACK, &sequence) < 0);
+    BOOST_REQUIRE(sequence.Length() > 4);
+    BOOST_CHECK_EQUAL(cache.Statistics().m_nuSearches, 1u);
+    bd.Play(Pt(10, 10), SG_WHITE);
+    BOOST_CHECK(cache.Ladder(bd, prey, SG_BLACK, 0) < 0);
+    BOOST_CHECK_EQUAL(cache.Statistics().m_nuSearches, 1u);
+    BOOST_CHECK_EQUAL(cache.Statistics().m_nuAvoided, 1u);
+    // Ladder breaker at the end of the ladder
+    bd.Play(sequence.Back(), SG_BLACK);
+    GoLadder ladder;
+    BOOST_CHECK_EQUAL(cache.Ladder(bd, prey, SG_BLACK, 0),
+                      ladder.Ladder(bd, prey, SG_BLACK, 0));
+    BOOST_CHECK_EQUAL(cache.Statistics().m_nuSearches, 2u);
+}
+
+/** Test that the results for a ladder in two different positions are kept
+    at the same time, as needed when a search alternates between subtrees. */
+BOOST_AUTO_TEST_CASE(GoLadderCacheTest_Versions)
+{
+    std::string s("..........\n"
+                  "..........\n"
+                  "...OO.....\n"
+                  "..OX......\n"
+                  "...O......\n"
+                  "..........\n"
+                  "..........\n"
+                  "..........\n"
+                  "..........\n"
+                  "..........");
+    int boardSize;
+    GoSetup setup = GoSetupUtil::CreateSetupFromString(s, boardSize);
+    setup.m_player = SG_BLACK;
+    GoBoard bd(boardSize, setup);
+    const SgPoint prey = Pt(4, 7);
+    GoLadderCache cache;
+    SgVector<SgPoint> sequence;
+    BOOST_CHECK(cache.Ladder(bd, prey, SG_BLACK, &sequence) < 0);
+    BOOST_REQUIRE(sequence.Length() > 4);
+    // Ladder breaker at the end of the ladder
+    bd.Play(sequence.Back(), SG_BLACK);
+    cache.Ladder(bd, prey, SG_BLACK, 0);
+    BOOST_CHECK_EQUAL(cache.Statistics().m_nuSearches, 2u);
+    bd.Undo();
+    BOOST_CHECK(cache.Ladder(bd, prey, SG_BLACK, 0) < 0);
+    bd.Play(sequence.Back(), SG_BLACK);
+    cache.Ladder(bd, prey, SG_BLACK, 0);
+    BOOST_CHECK_EQUAL(cache.Statistics().m_nuSearches, 2u);
+    BOOST_CHECK_EQUAL(cache.Statistics().m_nuAvoided, 2u);
+}
+
+} // namespace
+
+//----------------------------------------------------------------------------
@@ -0,0 +1,132 @@
+//----------------------------------------------------------------------------
+/** @file GoNeighborhoodHashTest.cpp
+    Unit tests for GoNeighborhoodHash. */
+//----------------------------------------------------------------------------
+
+#include "SgSystem.h"
+
+#include <boost/test/auto_unit_test.hpp>
+#include "GoBoard.h"
+#include "GoBoardUtil.h"
+#include "GoNeighborhoodHash.h"
+#include "SgRandom.h"
+
+using SgPointUtil::Pt;
+
+//----------------------------------------------------------------------------
+
+namespace {
+
+/** Play a random legal move that does not fill an own eye. */
+bool PlayRandomMove(GoBoard& bd, SgRandom& random)
+{
+    GoPointList moves;
+    for (GoBoard::Iterator it(bd); it; ++it)
+        if (  bd.IsEmpty(*it)
+           && bd.IsLegal(*it)
+           && ! GoBoardUtil::IsCompletelySurrounded(bd, *it)
+           )
+            moves.PushBack(*it);
+    if (moves.IsEmpty())
+        return false;
+    bd.Play(moves[random.Int(moves.Length())]);
+    return true;
+}
+
+/** Check the incremental hash codes of all points against
+    GoNeighborhoodHash::Compute(). */
+void CheckHash(const GoBoard& bd)
+{
+    const GoNeighborhoodHash* hash = bd.NeighborhoodHash();
+    BOOST_REQUIRE(hash != 0);
+    for (GoBoard::Iterator it(bd); it; ++it)
+        for (int radius = GoNeighborhoodHash::MIN_RADIUS;
+             radius <= GoNeighborhoodHash::MAX_RADIUS; ++radius)
+            BOOST_REQUIRE(hash->Get(*it, radius)
+                          == GoNeighborhoodHash::Compute(bd, *it, radius));
+}
+
+BOOST_AUTO_TEST_CASE(GoNeighborhoodHashTest_Index)
+{
+    const int n = GoNeighborhoodHash::MAX_NU_POINTS;
+    BOOST_CHECK_EQUAL(n, GoNeighborhoodHash::NuPoints(4));
+    BOOST_CHECK_EQUAL(GoNeighborhoodHash::NuPoints(2), 13);
+    for (int i = 0; i < n; ++i)
+    {
+        const int deltaCol = GoNeighborhoodHash::DeltaCol(i);
+        const int deltaRow = GoNeighborhoodHash::DeltaRow(i);
+        BOOST_CHECK_EQUAL(GoNeighborhoodHash::Index(deltaCol, deltaRow), i);
+    }
+    BOOST_CHECK_EQUAL(GoNeighborhoodHash::Index(0, 0), 0);
+    BOOST_CHECK_EQUAL(GoNeighborhoodHash::Index(0, -1), 1);
+    BOOST_CHECK_EQUAL(GoNeighborhoodHash::Index(3, 2), -1);
+    // The points of a neighborhood come first
+    BOOST_CHECK(GoNeighborhoodHash::Index(1, 1)
+                < GoNeighborhoodHash::NuPoints(2));
+    BOOST_CHECK(GoNeighborhoodHash::Index(2, 1)
+                >= GoNeighborhoodHash::NuPoints(2));
+}
+
+/** Test that the hash codes depend on the distance to the edge, but not on
+    empty points. */
+BOOST_AUTO_TEST_CASE(GoNeighborhoodHashTest_Empty)
+{
+    GoBoard bd(19);
+    bd.SetNeighborhoodHash(true);
+    const GoNeighborhoodHash& hash = *bd.NeighborhoodHash();
+    BOOST_CHECK(hash.Get(Pt(10, 10), 4).IsZero());
+    BOOST_CHECK(hash.Get(Pt(5, 5), 4).IsZero());
+    BOOST_CHECK(! hash.Get(Pt(4, 5), 4).IsZero());
+    BOOST_CHECK(hash.Get(Pt(4, 5), 3).IsZero());
+    BOOST_CHECK(hash.Get(Pt(4, 5), 4) == hash.Get(Pt(4, 10), 4));
+    BOOST_CHECK(hash.Get(Pt(1, 1), 2) != hash.Get(Pt(19, 19), 2));
+    bd.Init(9);
+    CheckHash(bd);
+}
+
+/** Compare the incremental hash codes with hash codes computed from
+    scratch while playing and taking back moves of random games. */
+BOOST_AUTO_TEST_CASE(GoNeighborhoodHashTest_RandomGames)
+{
+    SgRandom random;
+    for (int game = 0; game < 4; ++game)
+    {
+        GoBoard bd(game % 2 == 0 ? 9 : 19);
+        bd.Rules().SetKoRule(GoRules::SIMPLEKO);
+        for (int i = 0; i < 20; ++i)
+            PlayRandomMove(bd, random);
+        // Enable in the middle of the game
+        bd.SetNeighborhoodHash(true);
+        CheckHash(bd);
+        for (int i = 0; i < 300; ++i)
+        {
+            if (! PlayRandomMove(bd, random))
+                break;
+            CheckHash(bd);
+            if (random.Int(4) == 0)
+            {
+                bd.Undo();
+                CheckHash(bd);
+            }
+        }
+        while (bd.MoveNumber() > 0)
+            bd.Undo();
+        CheckHash(bd);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(GoNeighborhoodHashTest_Snapshot)
+{
+    GoBoard bd(9);
+    bd.SetNeighborhoodHash(true);
+    bd.Play(Pt(3, 3), SG_BLACK);
+    bd.TakeSnapshot();
+    bd.Play(Pt(4, 3), SG_WHITE);
+    bd.Play(Pt(3, 4), SG_BLACK);
+    bd.RestoreSnapshot();
+    CheckHash(bd);
+}
+
+} // namespace
+
+//----------------------------------------------------------------------------
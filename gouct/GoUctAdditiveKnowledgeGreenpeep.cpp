@@ -13,6 +13,8 @@
 #include <algorithm>
 
 #include "GoBoardUtil.h"
+#include "GoUctPatternFile.h"
+#include "SgDebug.h"
 #include "SgPlatform.h"
 #include "SgStringUtil.h"
 
@@ -40,6 +42,12 @@ const unsigned int PASS_CONTEXT = UINT_MAX;
 const unsigned int KO_BIT = 1U << 24;
 const unsigned int ATARI_BIT = 1U << 25;
 
+/** Minimum board size for keeping the contexts between calls of
+    ProcessPosition().
+    On small boards, most contexts change between two expanded positions
+    anyway and computing them from scratch is faster. */
+const int MIN_INCREMENTAL_SIZE = 13;
+
 /** A bit is set iff point p is either of color c or off the board. */
 inline unsigned int ColorOrBorderBit(const GoBoard& bd, SgPoint p, int c)
 {
@@ -127,15 +135,63 @@ unsigned int ExtendedContext(const GoBoard &bd,
     return extendedcontext;
 }
 
+/** Context of point p without the ko and atari bits. */
+unsigned int PointContext(const GoBoard& bd, SgPoint p, SgBlackWhite toplay)
+{
+    SgBlackWhite opponent = SgOppBW(toplay);
+    unsigned int blackcontext = SimpleContext(bd, p, SG_BLACK);
+    unsigned int whitecontext = SimpleContext(bd, p, SG_WHITE);
+    unsigned int occupancy = blackcontext ^ whitecontext;
+    unsigned int extendedcontext =
+        ExtendedContext(bd, p, occupancy, toplay, opponent);
+    if (toplay == SG_BLACK)
+        return extendedcontext | (blackcontext << 8) | (whitecontext << 16);
+    else
+        return extendedcontext | (whitecontext << 8) | (blackcontext << 16);
+}
+
+/** Convert a context of PointContext() for Black to play into the context
+    for White to play.
+    Swaps the two 8-neighbor cores. In the directions without a stone next
+    to the point, the bits for the color of the point 2 away are swapped
+    (for the border, both bits are set). The liberty bits in the directions
+    with a stone do not depend on the color to play. */
+unsigned int WhiteToPlayContext(unsigned int context)
+{
+    // Lower bit of the pair of extended bits and the occupancy mask for
+    // each direction as in ExtendedContext()
+    static const unsigned int v1[4] = { 0x1U, 0x4U, 0x10U, 0x40U };
+    static const unsigned int mask[4] = { 0x2U, 0x8U, 0x10U, 0x40U };
+    unsigned int tomovecontext = (context >> 8) & 0xffU;
+    unsigned int opponentcontext = (context >> 16) & 0xffU;
+    unsigned int occupancy = tomovecontext ^ opponentcontext;
+    unsigned int extendedcontext = 0U;
+    for (int i = 0; i < 4; ++i)
+    {
+        unsigned int bits = context & (v1[i] | (v1[i] << 1));
+        if ((occupancy & mask[i]) == 0U)
+            bits = ((bits << 1) | (bits >> 1)) & (v1[i] | (v1[i] << 1));
+        extendedcontext |= bits;
+    }
+    return extendedcontext | (opponentcontext << 8) | (tomovecontext << 16);
+}
+
+/** Compute the contexts of the moves.
+    @param bd
+    @param begin
+    @param end
+    @param pointContexts Contexts of the points for Black to play (see
+    PointContext()) or 0, if the contexts should be computed from the board
+    @param[out] contexts */
 void ComputeContexts(const GoBoard &bd,
                      vector<SgUctMoveInfo>::const_iterator begin,
                      vector<SgUctMoveInfo>::const_iterator end,
+                     const unsigned int pointContexts[],
                      unsigned int contexts[])
 {
     bool use9x9flag = bd.Size() < 15;
     std::bitset<SG_MAXPOINT + 1> atariBits;
     SgBlackWhite toplay = bd.ToPlay();
-    SgBlackWhite opponent = bd.Opponent();
     bool koExists = bd.KoPoint() != SG_NULLPOINT;
     SgMove lastMove = bd.GetLastMove();
     if (  use9x9flag 
@@ -154,19 +210,13 @@ void ComputeContexts(const GoBoard &bd,
         SgMove p = begin->m_move;
         if (p != SG_PASS)
         {
-            unsigned int blackcontext = SimpleContext(bd, p, SG_BLACK);
-            unsigned int whitecontext = SimpleContext(bd, p, SG_WHITE);
-            unsigned int occupancy = blackcontext ^ whitecontext;
-            unsigned int extendedcontext = 
-                ExtendedContext(bd, p, occupancy, toplay, opponent);
-            unsigned int context = 0;
-
-            if (toplay == SG_BLACK)
-                context = extendedcontext | (blackcontext << 8) | 
-                    (whitecontext << 16);
+            unsigned int context;
+            if (pointContexts == 0)
+                context = PointContext(bd, p, toplay);
+            else if (toplay == SG_BLACK)
+                context = pointContexts[p];
             else
-                context = extendedcontext | (whitecontext << 8) | 
-                    (blackcontext << 16);
+                context = WhiteToPlayContext(pointContexts[p]);
 
             if (use9x9flag) 
             {
@@ -198,22 +248,56 @@ void ReadPatternArray(unsigned short predictor[], int size,
     }
 }
 
-void ReadPatterns(unsigned short predictor9[],
-                  unsigned short predictor19[])
+/** Names of the tables in the pattern file. */
+const char* SECTION_9X9 = "greenpeep/9x9";
+
+const char* SECTION_19X19 = "greenpeep/19x19";
+
+/** Get a predictor table.
+    Uses the table in the loaded pattern file, if it exists, and creates the
+    table from the compiled-in patterns otherwise. */
+const unsigned short* GetPatternArray(bool usePatternFile, const char* name,
+                                      vector<unsigned short>& builtin,
+                                      int size, PatternEntry patternEntry[],
+                                      unsigned int nuPatterns)
 {
-    ReadPatternArray(predictor9, NUMPATTERNS9X9,
-                     greenpeepPatterns9, nuGreenpeepPatterns9);
-    ReadPatternArray(predictor19, NUMPATTERNS19X19,
-                     greenpeepPatterns19, nuGreenpeepPatterns19);
+    const GoUctPatternFile* file = GoUctPatternFile::Loaded();
+    if (usePatternFile && file != 0)
+    {
+        size_t nuElements;
+        const unsigned short* predictor = file->FindUInt16(name, nuElements);
+        if (predictor != 0 && nuElements == static_cast<size_t>(size))
+            return predictor;
+        SgWarning() << "Pattern file '" << file->FileName() << "' has no "
+                    << name << " table, using compiled-in patterns\n";
+    }
+    builtin.resize(size);
+    ReadPatternArray(&builtin[0], size, patternEntry, nuPatterns);
+    return &builtin[0];
 }
 
 } // namespace
 
 //----------------------------------------------------------------------------
 
-GoUctAdditiveKnowledgeParamGreenpeep::GoUctAdditiveKnowledgeParamGreenpeep()
+GoUctAdditiveKnowledgeParamGreenpeep::GoUctAdditiveKnowledgeParamGreenpeep(
+                                                           bool usePatternFile)
+{
+    m_predictor9x9 = GetPatternArray(usePatternFile, SECTION_9X9,
+                                     m_builtin9x9, NUMPATTERNS9X9,
+                                     greenpeepPatterns9,
+                                     nuGreenpeepPatterns9);
+    m_predictor19x19 = GetPatternArray(usePatternFile, SECTION_19X19,
+                                       m_builtin19x19, NUMPATTERNS19X19,
+                                       greenpeepPatterns19,
+                                       nuGreenpeepPatterns19);
+}
+
+void GoUctAdditiveKnowledgeParamGreenpeep::AddToPatternFile(
+                                      GoUctPatternFileWriter& writer) const
 {
-    ReadPatterns(m_predictor9x9, m_predictor19x19);
+    writer.AddUInt16(SECTION_9X9, m_predictor9x9, NUMPATTERNS9X9);
+    writer.AddUInt16(SECTION_19X19, m_predictor19x19, NUMPATTERNS19X19);
 }
 
 //----------------------------------------------------------------------------
@@ -222,7 +306,9 @@ GoUctAdditiveKnowledgeGreenpeep::GoUctAdditiveKnowledgeGreenpeep(
                         const GoBoard& bd,
                         const GoUctAdditiveKnowledgeParamGreenpeep& param)
   : GoUctAdditiveKnowledge(bd),
-    m_param(param)
+    m_param(param),
+    m_incremental(true),
+    m_size(0)
 {
     // Knowledge applies to all moves
     SetMoveRange(0, 10000); 
@@ -247,7 +333,25 @@ GoUctAdditiveKnowledgeGreenpeep::ProcessPosition(
         pred = m_param.m_predictor19x19;
     }
 
-    ComputeContexts(Board(), moves.begin(), moves.end(), m_contexts);
+    const GoBoard& bd = Board();
+    if (m_incremental && bd.Size() >= MIN_INCREMENTAL_SIZE)
+    {
+        UpdatePointContexts();
+        for (std::vector<SgUctMoveInfo>::const_iterator it = moves.begin();
+             it != moves.end(); ++it)
+        {
+            const SgMove p = it->m_move;
+            if (p != SG_PASS && m_isDirty[p])
+            {
+                m_pointContext[p] = PointContext(bd, p, SG_BLACK);
+                m_isDirty[p] = false;
+            }
+        }
+        ComputeContexts(bd, moves.begin(), moves.end(), m_pointContext,
+                        m_contexts);
+    }
+    else
+        ComputeContexts(bd, moves.begin(), moves.end(), 0, m_contexts);
     for (std::size_t i = 0; i < moves.size(); ++i)
     {
         float& value = moves[i].m_predictorValue;
@@ -281,6 +385,62 @@ GoUctAdditiveKnowledgeGreenpeep::ProcessPosition(
     }
 }
 
+void GoUctAdditiveKnowledgeGreenpeep::SetIncremental(bool enable)
+{
+    m_incremental = enable;
+    m_size = 0;
+}
+
+void GoUctAdditiveKnowledgeGreenpeep::UpdatePointContexts()
+{
+    // Offsets of the points in the 12-point diamond and of the point itself
+    static const int diamond[13] = {
+        0,
+        -SG_WE, +SG_WE, -SG_NS, +SG_NS,
+        -SG_NS - SG_WE, -SG_NS + SG_WE, +SG_NS - SG_WE, +SG_NS + SG_WE,
+        -2 * SG_WE, +2 * SG_WE, -2 * SG_NS, +2 * SG_NS
+    };
+    const GoBoard& bd = Board();
+    if (bd.Size() != m_size)
+    {
+        m_size = bd.Size();
+        for (SgPoint p = 0; p < SG_MAXPOINT; ++p)
+        {
+            m_color[p] = bd.GetColor(p);
+            m_isDirty[p] = true;
+        }
+        return;
+    }
+    m_blocks.Clear();
+    for (GoBoard::Iterator it(bd); it; ++it)
+    {
+        const SgPoint p = *it;
+        const SgBoardColor c = bd.GetColor(p);
+        if (c == m_color[p])
+            continue;
+        m_color[p] = c;
+        // The stone at p is part of the contexts in the diamond
+        for (int i = 0; i < 13; ++i)
+        {
+            const int q = p + diamond[i];
+            if (q >= 0 && q < SG_MAXPOINT)
+                m_isDirty[q] = true;
+        }
+        // The number of liberties can have changed for all blocks that
+        // contain p or are adjacent to it
+        for (int i = 0; i < 5; ++i)
+        {
+            const SgPoint q = p + diamond[i];
+            if (! bd.Occupied(q) || m_blocks.Contains(bd.Anchor(q)))
+                continue;
+            m_blocks.Include(bd.Anchor(q));
+            for (GoBoard::StoneIterator it2(bd, q); it2; ++it2)
+                for (int j = 1; j < 5; ++j)
+                    m_isDirty[*it2 + diamond[j]] = true;
+        }
+    }
+}
+
 void
 GoUctAdditiveKnowledgeGreenpeep::PrintContext(unsigned int context, 
                                               std::ostream& str)
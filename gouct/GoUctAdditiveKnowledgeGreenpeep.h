@@ -7,8 +7,10 @@
 
 #include "GoUctAdditiveKnowledge.h"
 #include "GoUctPlayoutPolicy.h"
+#include "SgPointSet.h"
 #include <boost/static_assert.hpp>
 
+class GoUctPatternFileWriter;
 
 /* max 26-bit: 16-bit 8-neighbor core, 8-bit liberty & 2-away extension, 
 	1 bit "ko exists", 1 bit defensive move */
@@ -21,16 +23,44 @@ const int NUMPATTERNS19X19 = 1<<24;
 
 class GoUctAdditiveKnowledgeParamGreenpeep: public GoUctAdditiveKnowledgeParam
 {
-private:
 public:
-    GoUctAdditiveKnowledgeParamGreenpeep();
+    /** Constructor.
+        @param usePatternFile Use the tables of the pattern file loaded with
+        GoUctPatternFile::Load(), if it contains them. Otherwise the tables
+        are created from the compiled-in patterns. */
+    explicit GoUctAdditiveKnowledgeParamGreenpeep(bool usePatternFile = true);
+
+    /** Add the tables to a pattern file. */
+    void AddToPatternFile(GoUctPatternFileWriter& writer) const;
+
+    /** Predictor values indexed by the context, NUMPATTERNS9X9 elements.
+        Points into the mapped pattern file or to m_builtin9x9. */
+    const unsigned short* m_predictor9x9;
 
-    unsigned short m_predictor9x9[NUMPATTERNS9X9];
-    
-    unsigned short m_predictor19x19[NUMPATTERNS19X19];
+    /** Predictor values indexed by the context, NUMPATTERNS19X19 elements.
+        @see m_predictor9x9 */
+    const unsigned short* m_predictor19x19;
+
+private:
+    /** Table created from the compiled-in patterns, if not in the pattern
+        file. */
+    std::vector<unsigned short> m_builtin9x9;
+
+    /** @see m_builtin9x9 */
+    std::vector<unsigned short> m_builtin19x19;
 };
 
-/** Use Greenpeep-style pattern values to make predictions. */
+/** Use Greenpeep-style pattern values to make predictions.
+    The 12-point contexts of the points are kept between calls of
+    ProcessPosition() and only recomputed for points whose context can have
+    changed since the last call. These are found by comparing the board with
+    a copy of the stones at the last call: a context depends only on the
+    stones within its 12-point diamond and on the number of liberties of the
+    blocks adjacent to the point. Therefore the contexts follow the moves
+    played and taken back in the in-tree phase of the search (and any other
+    change of the board) with a cost proportional to the changes.
+    This is only done on boards of size 13 or larger; on smaller boards,
+    computing all contexts is faster. */
 class GoUctAdditiveKnowledgeGreenpeep : public GoUctAdditiveKnowledge
 {
 public:
@@ -44,6 +74,15 @@ public:
 
     void ProcessPosition(std::vector<SgUctMoveInfo>& moves);
 
+    /** The context of a move in the last call of ProcessPosition().
+        @param i The index of the move in the move list */
+    unsigned int Context(std::size_t i) const;
+
+    /** Keep the contexts of the points between calls of ProcessPosition().
+        If disabled, all contexts are computed from scratch in each call.
+        Used for testing and benchmarking. Default is true. */
+    void SetIncremental(bool enable);
+
     /** Print a pattern given its pattern code. 
     	3 typical examples:
 
@@ -84,10 +123,40 @@ private:
     const GoUctAdditiveKnowledgeParamGreenpeep& m_param;
 
     unsigned int m_contexts[SG_MAX_ONBOARD + 1];
+
+    /** See SetIncremental() */
+    bool m_incremental;
+
+    /** Board size of the stored contexts; 0, if no contexts are stored. */
+    int m_size;
+
+    /** The stones on the board when the contexts were last updated. */
+    SgBoardColor m_color[SG_MAXPOINT];
+
+    /** Context of each point for Black to play, without the ko and atari
+        bits. Only valid for points with m_isDirty false. */
+    unsigned int m_pointContext[SG_MAXPOINT];
+
+    bool m_isDirty[SG_MAXPOINT];
+
+    /** Local variable in UpdatePointContexts().
+        Anchors of the blocks with updated neighbors. Reused for efficiency. */
+    SgPointSet m_blocks;
+
+    /** Mark the points whose context can have changed since the last call.
+        The contexts are recomputed in ProcessPosition() only for the
+        points that are candidate moves. */
+    void UpdatePointContexts();
 };
 
 //----------------------------------------------------------------------------
 
+inline unsigned int GoUctAdditiveKnowledgeGreenpeep::Context(std::size_t i)
+    const
+{
+    return m_contexts[i];
+}
+
 inline SgUctValue GoUctAdditiveKnowledgeGreenpeep::Minimum() const
 {
 	return ProbabilityBased() ? 0.0001f : 0.05f;
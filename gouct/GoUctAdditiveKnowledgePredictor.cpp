@@ -0,0 +1,618 @@
+//----------------------------------------------------------------------------
+/** @file GoUctAdditiveKnowledgePredictor.cpp
+    See GoUctAdditiveKnowledgePredictor.h */
+//----------------------------------------------------------------------------
+
+#include "SgSystem.h"
+#include "GoUctAdditiveKnowledgePredictor.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <boost/io/ios_state.hpp>
+#include "GoBoardUtil.h"
+#include "SgException.h"
+#include "SgVector.h"
+
+using GoUctPredictorFeatures::Group;
+using GoUctPredictorFeatures::NU_GROUPS;
+
+//----------------------------------------------------------------------------
+
+namespace {
+
+const int GROUP_SIZE[NU_GROUPS] = { 65536, 5, 5, 3, 2, 18, 18, 5, 4 };
+
+/** Partial sums of GROUP_SIZE */
+const int GROUP_OFFSET[NU_GROUPS + 1] = {
+    0, 65536, 65541, 65546, 65549, 65551, 65569, 65587, 65592, 65596 };
+
+const char* GROUP_NAME[NU_GROUPS] = {
+    "pattern", "capture", "liberties", "atari", "escape", "dist_last",
+    "dist_2nd_last", "line", "ladder" };
+
+/** Values of the LADDER group */
+enum LadderStatus
+{
+    LADDER_NONE,
+
+    LADDER_CAPTURE,
+
+    LADDER_ESCAPE,
+
+    LADDER_CAPTURED
+};
+
+/** Number of floats processed at once by the MLP kernel. */
+const int VECTOR_WIDTH = 4;
+
+#if defined(__GNUC__)
+
+/** 4 floats. The reduced alignment allows loads from rows of the weight
+    vectors, which are only aligned to a float. */
+typedef float Vec4 __attribute__((vector_size(16), aligned(4)));
+
+typedef int Vec4i __attribute__((vector_size(16), aligned(4)));
+
+/** Score of a move with the MLP model, 4 hidden units at once. */
+float EvaluateMlp(const int* features, const float* weights, int stride,
+                  const float* hiddenBias, const float* output)
+{
+    Vec4 acc[GoUctAdditiveKnowledgeParamPredictor::MAX_HIDDEN_SIZE
+             / VECTOR_WIDTH];
+    const int nuVec = stride / VECTOR_WIDTH;
+    for (int k = 0; k < nuVec; ++k)
+        acc[k] = *reinterpret_cast<const Vec4*>(hiddenBias + k * VECTOR_WIDTH);
+    for (int g = 0; g < NU_GROUPS; ++g)
+    {
+        const Vec4* row =
+            reinterpret_cast<const Vec4*>(weights + features[g] * stride);
+        for (int k = 0; k < nuVec; ++k)
+            acc[k] += row[k];
+    }
+    const Vec4 zero = { 0, 0, 0, 0 };
+    Vec4 sum = zero;
+    for (int k = 0; k < nuVec; ++k)
+    {
+        // ReLU with a mask, supported by older compilers than a vector
+        // conditional
+        const Vec4i positive = (acc[k] > zero);
+        const Vec4 hidden = (Vec4)((Vec4i)acc[k] & positive);
+        sum += hidden
+            * *reinterpret_cast<const Vec4*>(output + k * VECTOR_WIDTH);
+    }
+    return sum[0] + sum[1] + sum[2] + sum[3];
+}
+
+#else
+
+float EvaluateMlp(const int* features, const float* weights, int stride,
+                  const float* hiddenBias, const float* output)
+{
+    float acc[GoUctAdditiveKnowledgeParamPredictor::MAX_HIDDEN_SIZE];
+    std::copy(hiddenBias, hiddenBias + stride, acc);
+    for (int g = 0; g < NU_GROUPS; ++g)
+    {
+        const float* row = weights + features[g] * stride;
+        for (int k = 0; k < stride; ++k)
+            acc[k] += row[k];
+    }
+    float sum = 0;
+    for (int k = 0; k < stride; ++k)
+        if (acc[k] > 0)
+            sum += acc[k] * output[k];
+    return sum;
+}
+
+#endif
+
+/** Colors of the 8 neighbors of a point relative to the color to play. */
+int PatternCode(const GoBoard& bd, SgPoint p, SgBlackWhite toPlay)
+{
+    static const int STATE_OWN = 1;
+    static const int STATE_OPP = 2;
+    static const int STATE_BORDER = 3;
+    const int offset[8] = { SG_NS, -SG_NS, -SG_WE, SG_WE,
+                            SG_NS - SG_WE, SG_NS + SG_WE,
+                            -SG_NS - SG_WE, -SG_NS + SG_WE };
+    int code = 0;
+    for (int i = 0; i < 8; ++i)
+    {
+        const SgBoardColor c = bd.GetColor(p + offset[i]);
+        int state = 0;
+        if (c == toPlay)
+            state = STATE_OWN;
+        else if (c == SgOppBW(toPlay))
+            state = STATE_OPP;
+        else if (c == SG_BORDER)
+            state = STATE_BORDER;
+        code |= state << (2 * i);
+    }
+    return code;
+}
+
+int DistanceIndex(SgPoint p, SgPoint previous)
+{
+    if (previous == SG_NULLMOVE || previous == SG_PASS)
+        return 0;
+    const int dx = std::abs(SgPointUtil::Col(p) - SgPointUtil::Col(previous));
+    const int dy = std::abs(SgPointUtil::Row(p) - SgPointUtil::Row(previous));
+    return std::min(dx + dy + std::max(dx, dy),
+                  GROUP_SIZE[GoUctPredictorFeatures::DIST_LAST] - 1);
+}
+
+int CaptureIndex(int nuCaptured)
+{
+    if (nuCaptured <= 2)
+        return nuCaptured;
+    if (nuCaptured <= 5)
+        return 3;
+    return 4;
+}
+
+/** Small set of points for counting the liberties after a move. */
+class LibertySet
+{
+public:
+    /** Count up to this number of liberties. */
+    static const int MAX_COUNT = 4;
+
+    LibertySet()
+        : m_size(0)
+    { }
+
+    bool IsFull() const
+    {
+        return m_size == MAX_COUNT;
+    }
+
+    void Add(SgPoint p)
+    {
+        if (! IsFull() && std::find(m_points, m_points + m_size, p)
+                          == m_points + m_size)
+            m_points[m_size++] = p;
+    }
+
+    int Size() const
+    {
+        return m_size;
+    }
+
+private:
+    int m_size;
+
+    SgPoint m_points[MAX_COUNT];
+};
+
+/** Compute the groups of features that depend on the adjacent blocks. */
+void ComputeBlockFeatures(const GoBoard& bd, SgPoint p, SgBlackWhite toPlay,
+                          int* features)
+{
+    using namespace GoUctPredictorFeatures;
+    SgPoint anchors[4];
+    int nuAnchors = 0;
+    int nuCaptured = 0;
+    int atari = 0;
+    int escape = 0;
+    LibertySet liberties;
+    for (SgNb4Iterator it(p); it; ++it)
+    {
+        const SgPoint nb = *it;
+        const SgBoardColor c = bd.GetColor(nb);
+        if (c == SG_EMPTY)
+        {
+            liberties.Add(nb);
+            continue;
+        }
+        if (c == SG_BORDER)
+            continue;
+        if (c != toPlay && bd.InAtari(nb))
+            // Captured stones adjacent to the move become liberties; the
+            // liberty count is a lower bound
+            liberties.Add(nb);
+        const SgPoint anchor = bd.Anchor(nb);
+        if (std::find(anchors, anchors + nuAnchors, anchor)
+            != anchors + nuAnchors)
+            continue;
+        anchors[nuAnchors++] = anchor;
+        const int nuLib = bd.NumLiberties(anchor);
+        if (c == toPlay)
+        {
+            if (nuLib == 1)
+                escape = 1;
+            for (GoBoard::LibertyIterator it2(bd, anchor);
+                 it2 && ! liberties.IsFull(); ++it2)
+                if (*it2 != p)
+                    liberties.Add(*it2);
+        }
+        else if (nuLib == 1)
+            nuCaptured += bd.NumStones(anchor);
+        else if (nuLib == 2)
+            atari = std::max(atari, bd.NumStones(anchor) == 1 ? 1 : 2);
+    }
+    features[CAPTURE] = GROUP_OFFSET[CAPTURE] + CaptureIndex(nuCaptured);
+    features[LIBERTIES] = GROUP_OFFSET[LIBERTIES] + liberties.Size();
+    features[ATARI] = GROUP_OFFSET[ATARI] + atari;
+    features[ESCAPE] = GROUP_OFFSET[ESCAPE] + escape;
+}
+
+/** Find the ladder status of the liberties of the blocks near the last
+    move.
+    As in GoUctLadderKnowledge, only the block of the last move (if it has
+    two liberties) and the own blocks in atari adjacent to it are checked.
+    Searching the ladders of all blocks with few liberties on the board
+    takes several times longer than the rest of the predictor.
+    @param bd
+    @param ladderCache
+    @param[in,out] status The status of the points, must be initialized
+    with LADDER_NONE */
+void FindLadderStatus(const GoBoard& bd, GoLadderCache& ladderCache,
+                      SgArray<int, SG_MAXPOINT>& status)
+{
+    const SgBlackWhite toPlay = bd.ToPlay();
+    const SgPoint last = bd.GetLastMove();
+    if (SgIsSpecialMove(last) || ! bd.Occupied(last))
+        return;
+    // The ladder searches modify the board, collect the blocks first
+    SgVector<SgPoint> anchors;
+    GoBoardUtil::AdjacentBlocks(bd, last, 1, &anchors);
+    if (bd.NumLiberties(last) == 2)
+        anchors.PushBack(bd.Anchor(last));
+    for (SgVectorIterator<SgPoint> it(anchors); it; ++it)
+    {
+        const SgPoint anchor = *it;
+        const int nuLib = bd.NumLiberties(anchor);
+        if (bd.GetStone(anchor) == toPlay)
+        {
+            if (nuLib != 1)
+                continue;
+            const SgPoint lib = bd.TheLiberty(anchor);
+            // Escape overrides capture
+            status[lib] = ladderCache.IsLadderEscapeMove(bd, anchor, lib) ?
+                          LADDER_ESCAPE : LADDER_CAPTURED;
+        }
+        else if (nuLib == 2)
+        {
+            SgPoint libs[2];
+            GoBoard::LibertyIterator it2(bd, anchor);
+            libs[0] = *it2;
+            ++it2;
+            libs[1] = *it2;
+            for (int i = 0; i < 2; ++i)
+                if (  status[libs[i]] == LADDER_NONE
+                   && ladderCache.IsLadderCaptureMove(bd, anchor, libs[i])
+                   )
+                    status[libs[i]] = LADDER_CAPTURE;
+        }
+    }
+}
+
+} // namespace
+
+//----------------------------------------------------------------------------
+
+int GoUctPredictorFeatures::GroupSize(Group group)
+{
+    SG_ASSERT(group < NU_GROUPS);
+    return GROUP_SIZE[group];
+}
+
+const char* GoUctPredictorFeatures::GroupName(Group group)
+{
+    SG_ASSERT(group < NU_GROUPS);
+    return GROUP_NAME[group];
+}
+
+int GoUctPredictorFeatures::Offset(Group group)
+{
+    SG_ASSERT(group <= NU_GROUPS);
+    SG_ASSERT(group == 0 || GROUP_OFFSET[group] == GROUP_OFFSET[group - 1]
+                                                   + GROUP_SIZE[group - 1]);
+    return GROUP_OFFSET[group];
+}
+
+int GoUctPredictorFeatures::NuFeatures()
+{
+    return Offset(NU_GROUPS);
+}
+
+void GoUctPredictorFeatures::Compute(const GoBoard& bd,
+                                     const std::vector<SgUctMoveInfo>& moves,
+                                     GoLadderCache& ladderCache,
+                                     std::vector<int>& features)
+{
+    features.assign(moves.size() * NU_GROUPS, 0);
+    SgArray<int, SG_MAXPOINT> ladderStatus;
+    for (GoBoard::Iterator it(bd); it; ++it)
+        ladderStatus[*it] = LADDER_NONE;
+    ladderCache.StartPosition();
+    FindLadderStatus(bd, ladderCache, ladderStatus);
+    const SgBlackWhite toPlay = bd.ToPlay();
+    const SgPoint last = bd.GetLastMove();
+    const SgPoint secondLast = bd.Get2ndLastMove();
+    for (std::size_t i = 0; i < moves.size(); ++i)
+    {
+        const SgPoint p = moves[i].m_move;
+        if (p == SG_PASS)
+            continue;
+        SG_ASSERT(bd.IsEmpty(p));
+        int* f = &features[i * NU_GROUPS];
+        f[PATTERN] = PatternCode(bd, p, toPlay);
+        ComputeBlockFeatures(bd, p, toPlay, f);
+        f[DIST_LAST] = GROUP_OFFSET[DIST_LAST] + DistanceIndex(p, last);
+        f[DIST_2ND_LAST] = GROUP_OFFSET[DIST_2ND_LAST]
+                           + DistanceIndex(p, secondLast);
+        f[LINE] = GROUP_OFFSET[LINE]
+                  + std::min(int(bd.Line(p)), GROUP_SIZE[LINE]) - 1;
+        f[LADDER] = GROUP_OFFSET[LADDER] + ladderStatus[p];
+    }
+}
+
+//----------------------------------------------------------------------------
+
+GoUctAdditiveKnowledgeParamPredictor::GoUctAdditiveKnowledgeParamPredictor()
+{
+    SetDefaultWeights();
+}
+
+void GoUctAdditiveKnowledgeParamPredictor::Evaluate(const int* features,
+                                                    std::size_t nuMoves,
+                                                    float* scores) const
+{
+    const float* weights = &m_weights[0];
+    if (m_hiddenSize == 0)
+        for (std::size_t i = 0; i < nuMoves; ++i)
+        {
+            const int* f = features + i * NU_GROUPS;
+            float score = m_bias;
+            for (int g = 0; g < NU_GROUPS; ++g)
+                score += weights[f[g]];
+            scores[i] = score;
+        }
+    else
+        for (std::size_t i = 0; i < nuMoves; ++i)
+            scores[i] = m_bias + EvaluateMlp(features + i * NU_GROUPS,
+                                             weights, m_stride,
+                                             &m_hiddenBias[0], &m_output[0]);
+}
+
+void GoUctAdditiveKnowledgeParamPredictor::Init(int hiddenSize)
+{
+    SG_ASSERT(hiddenSize >= 0);
+    SG_ASSERT(hiddenSize <= MAX_HIDDEN_SIZE);
+    m_hiddenSize = hiddenSize;
+    m_stride = 1;
+    if (hiddenSize > 0)
+        m_stride = (hiddenSize + VECTOR_WIDTH - 1) / VECTOR_WIDTH
+                   * VECTOR_WIDTH;
+    m_bias = 0;
+    m_passScore = 0;
+    m_weights.assign(GoUctPredictorFeatures::NuFeatures() * m_stride, 0.f);
+    m_hiddenBias.assign(m_stride, 0.f);
+    m_output.assign(m_stride, 0.f);
+    m_largePatterns.Clear();
+}
+
+void GoUctAdditiveKnowledgeParamPredictor::Read(std::istream& in)
+{
+    using namespace GoUctPredictorFeatures;
+    GoUctAdditiveKnowledgeParamPredictor param;
+    std::string line;
+    int lineNumber = 0;
+    int nuHeaderLines = 0;
+    while (std::getline(in, line))
+    {
+        ++lineNumber;
+        std::istringstream lineIn(line);
+        std::string key;
+        if (! (lineIn >> key) || key[0] == '#')
+            continue;
+        const int nuValues = std::max(param.m_hiddenSize, 1);
+        bool isValid = true;
+        if (nuHeaderLines == 0)
+        {
+            int version;
+            if (key != "fuego_move_predictor" || ! (lineIn >> version))
+                throw SgException("predictor weights: missing header");
+            if (version != FORMAT_VERSION)
+                throw SgException("predictor weights: unsupported version");
+            ++nuHeaderLines;
+        }
+        else if (nuHeaderLines == 1)
+        {
+            int hiddenSize;
+            if (key != "hidden" || ! (lineIn >> hiddenSize)
+                || hiddenSize < 0 || hiddenSize > MAX_HIDDEN_SIZE)
+            {
+                std::ostringstream msg;
+                msg << "predictor weights line " << lineNumber
+                    << ": expected hidden size 0.." << MAX_HIDDEN_SIZE;
+                throw SgException(msg.str());
+            }
+            param.Init(hiddenSize);
+            ++nuHeaderLines;
+        }
+        else if (key == "large_pattern")
+        {
+            std::string pattern;
+            float value;
+            std::string extra;
+            isValid = (lineIn >> pattern >> value && ! (lineIn >> extra));
+            if (isValid)
+            {
+                try
+                {
+                    param.m_largePatterns.Add(pattern, value);
+                }
+                catch (const SgException&)
+                {
+                    isValid = false;
+                }
+            }
+        }
+        else
+        {
+            float* values = 0;
+            int nuLineValues = nuValues;
+            if (key == "bias" || key == "pass")
+            {
+                values = (key == "bias" ? &param.m_bias : &param.m_passScore);
+                nuLineValues = 1;
+            }
+            else if (  (key == "hidden_bias" || key == "output")
+                    && param.m_hiddenSize > 0
+                    )
+                values = (key == "output" ? &param.m_output[0]
+                                          : &param.m_hiddenBias[0]);
+            else
+            {
+                int group = 0;
+                while (group < NU_GROUPS && key != GROUP_NAME[group])
+                    ++group;
+                int index;
+                if (  group < NU_GROUPS
+                   && lineIn >> index
+                   && index >= 0 && index < GROUP_SIZE[group]
+                   )
+                    values = &param.m_weights[(Offset(Group(group)) + index)
+                                              * param.m_stride];
+            }
+            isValid = (values != 0);
+            for (int k = 0; k < nuLineValues && isValid; ++k)
+                if (! (lineIn >> values[k]))
+                    isValid = false;
+            std::string extra;
+            if (isValid && lineIn >> extra)
+                isValid = false;
+        }
+        if (! isValid)
+        {
+            std::ostringstream msg;
+            msg << "predictor weights line " << lineNumber
+                << ": invalid line '" << line << "'";
+            throw SgException(msg.str());
+        }
+    }
+    if (nuHeaderLines < 2)
+        throw SgException("predictor weights: missing header");
+    *this = param;
+}
+
+void GoUctAdditiveKnowledgeParamPredictor::Read(const std::string& fileName)
+{
+    std::ifstream in(fileName.c_str());
+    if (! in)
+        throw SgException("could not open " + fileName);
+    Read(in);
+}
+
+void GoUctAdditiveKnowledgeParamPredictor::SetDefaultWeights()
+{
+    using namespace GoUctPredictorFeatures;
+    Init(0);
+    m_passScore = -3.f;
+    float* w = &m_weights[0];
+    const float capture[] = { 0.f, 2.5f, 3.f, 3.5f, 4.f };
+    const float liberties[] = { -2.f, -2.f, 0.f, 0.1f, 0.2f };
+    const float atari[] = { 0.f, 0.5f, 0.8f };
+    const float distLast[] = { 0.f, 0.f, 1.2f, 0.9f, 0.6f, 0.3f };
+    const float dist2ndLast[] = { 0.f, 0.f, 0.5f, 0.3f, 0.2f };
+    const float line[] = { -1.f, -0.3f, 0.2f, 0.2f, 0.f };
+    const float ladder[] = { 0.f, 1.5f, 1.f, -2.f };
+    std::copy(capture, capture + 5, w + Offset(CAPTURE));
+    std::copy(liberties, liberties + 5, w + Offset(LIBERTIES));
+    std::copy(atari, atari + 3, w + Offset(ATARI));
+    w[Offset(ESCAPE) + 1] = 1.5f;
+    std::copy(distLast, distLast + 6, w + Offset(DIST_LAST));
+    std::copy(dist2ndLast, dist2ndLast + 5, w + Offset(DIST_2ND_LAST));
+    std::copy(line, line + 5, w + Offset(LINE));
+    std::copy(ladder, ladder + 4, w + Offset(LADDER));
+}
+
+void GoUctAdditiveKnowledgeParamPredictor::Write(std::ostream& out) const
+{
+    using namespace GoUctPredictorFeatures;
+    boost::io::ios_all_saver saver(out);
+    out.precision(std::numeric_limits<float>::digits10 + 3);
+    out << "fuego_move_predictor " << FORMAT_VERSION << '\n'
+        << "hidden " << m_hiddenSize << '\n'
+        << "bias " << m_bias << '\n'
+        << "pass " << m_passScore << '\n';
+    const int nuValues = std::max(m_hiddenSize, 1);
+    if (m_hiddenSize > 0)
+    {
+        out << "hidden_bias";
+        for (int k = 0; k < nuValues; ++k)
+            out << ' ' << m_hiddenBias[k];
+        out << "\noutput";
+        for (int k = 0; k < nuValues; ++k)
+            out << ' ' << m_output[k];
+        out << '\n';
+    }
+    for (int group = 0; group < NU_GROUPS; ++group)
+        for (int index = 0; index < GROUP_SIZE[group]; ++index)
+        {
+            const float* values =
+                &m_weights[(Offset(Group(group)) + index) * m_stride];
+            if (std::count(values, values + nuValues, 0.f) == nuValues)
+                continue;
+            out << GROUP_NAME[group] << ' ' << index;
+            for (int k = 0; k < nuValues; ++k)
+                out << ' ' << values[k];
+            out << '\n';
+        }
+    const std::vector<std::pair<std::string,float> >& patterns =
+        m_largePatterns.Patterns();
+    for (std::size_t i = 0; i < patterns.size(); ++i)
+        out << "large_pattern " << patterns[i].first << ' '
+            << patterns[i].second << '\n';
+}
+
+//----------------------------------------------------------------------------
+
+GoUctAdditiveKnowledgePredictor::GoUctAdditiveKnowledgePredictor(
+                            const GoBoard& bd,
+                            const GoUctAdditiveKnowledgeParamPredictor& param)
+    : GoUctAdditiveKnowledgeStdProb(bd),
+      m_param(param)
+{
+    // Knowledge applies to all moves
+    SetMoveRange(0, 10000);
+}
+
+void
+GoUctAdditiveKnowledgePredictor::ProcessPosition(std::vector<SgUctMoveInfo>&
+                                                 moves)
+{
+    if (moves.empty())
+        return;
+    GoUctPredictorFeatures::Compute(Board(), moves, m_ladderCache,
+                                    m_features);
+    m_scores.resize(moves.size());
+    m_param.Evaluate(&m_features[0], moves.size(), &m_scores[0]);
+    const GoUctNeighborhoodPatterns& largePatterns = m_param.LargePatterns();
+    if (! largePatterns.IsEmpty())
+        for (std::size_t i = 0; i < moves.size(); ++i)
+            if (moves[i].m_move != SG_PASS)
+                m_scores[i] += largePatterns.Value(Board(), moves[i].m_move);
+    float maxScore = -std::numeric_limits<float>::max();
+    for (std::size_t i = 0; i < moves.size(); ++i)
+    {
+        if (moves[i].m_move == SG_PASS)
+            m_scores[i] = m_param.PassScore();
+        maxScore = std::max(maxScore, m_scores[i]);
+    }
+    float sum = 0;
+    for (std::size_t i = 0; i < moves.size(); ++i)
+    {
+        m_scores[i] = std::exp(m_scores[i] - maxScore);
+        sum += m_scores[i];
+    }
+    for (std::size_t i = 0; i < moves.size(); ++i)
+        moves[i].m_predictorValue = m_scores[i] / sum;
+}
+
+//----------------------------------------------------------------------------
@@ -0,0 +1,244 @@
+//----------------------------------------------------------------------------
+/** @file GoUctAdditiveKnowledgePredictor.h
+    Additive knowledge from a feature-based move predictor. */
+//----------------------------------------------------------------------------
+
+#ifndef GOUCT_ADDITIVEKNOWLEDGEPREDICTOR_H
+#define GOUCT_ADDITIVEKNOWLEDGEPREDICTOR_H
+
+#include <iosfwd>
+#include <string>
+#include <vector>
+#include "GoLadderCache.h"
+#include "GoUctAdditiveKnowledge.h"
+#include "GoUctNeighborhoodPatterns.h"
+
+//----------------------------------------------------------------------------
+
+/** Features of a move used by GoUctAdditiveKnowledgePredictor.
+    Each move has exactly one active feature in each group. The features
+    are numbered consecutively over all groups, see Offset(). */
+namespace GoUctPredictorFeatures
+{
+    enum Group
+    {
+        /** Colors of the 8 neighbors relative to the color to play
+            (2 bits each: empty, own, opponent, border). */
+        PATTERN,
+
+        /** Number of opponent stones captured: 0, 1, 2, 3-5, 6+ */
+        CAPTURE,
+
+        /** Liberties of the own block after the move: 0, 1, 2, 3, 4+ */
+        LIBERTIES,
+
+        /** Puts an opponent block into atari: none, single stone, larger
+            block */
+        ATARI,
+
+        /** Extends an own block in atari: no, yes */
+        ESCAPE,
+
+        /** Distance to the last move (dx + dy + max(dx, dy), capped at
+            17), 0 if there is no last move or it was a pass */
+        DIST_LAST,
+
+        /** Distance to the second last move, see DIST_LAST */
+        DIST_2ND_LAST,
+
+        /** Line of the move: 1, 2, 3, 4, 5+ */
+        LINE,
+
+        /** Ladder status: none, ladder capture of the block of the last
+            move, working ladder escape of an own block in atari adjacent
+            to the last move, escape of such a block that is captured in a
+            ladder */
+        LADDER,
+
+        NU_GROUPS
+    };
+
+    /** Number of features in a group. */
+    int GroupSize(Group group);
+
+    /** Name of a group used in the weights file. */
+    const char* GroupName(Group group);
+
+    /** Index of the first feature of a group. */
+    int Offset(Group group);
+
+    /** Total number of features. */
+    int NuFeatures();
+
+    /** Compute the features of moves.
+        @param bd The position
+        @param moves The moves (empty points or pass)
+        @param ladderCache Used for the LADDER group
+        @param[out] features For each move NU_GROUPS feature indices (see
+        Offset()). Unused (zero) for the pass move. */
+    void Compute(const GoBoard& bd, const std::vector<SgUctMoveInfo>& moves,
+                 GoLadderCache& ladderCache, std::vector<int>& features);
+}
+
+//----------------------------------------------------------------------------
+
+/** Weights of the move predictor; loaded once and shared by the threads.
+    The model is either linear or a small MLP with one hidden layer:
+    - linear (hidden size 0): the score of a move is the bias plus the sum
+      of the weights of its active features.
+    - MLP: each feature has a weight vector of the hidden size. The hidden
+      layer is the ReLU of the hidden bias plus the sum of the weight
+      vectors of the active features. The score is the bias plus the dot
+      product of the hidden layer with the output weights.
+
+    Independent of the model, the value of the largest matching large
+    pattern (see GoUctNeighborhoodPatterns) is added to the score.
+    The probability of a move is the softmax of the scores of all moves.
+    The pass move has a fixed score.
+
+    The default weights are a hand-tuned linear model. Other weights are
+    read from a text file:
+    @verbatim
+    # comment
+    fuego_move_predictor 1
+    hidden <size>
+    bias <value>
+    pass <value>
+    hidden_bias <size values>
+    output <size values>
+    <group> <index> <values>
+    large_pattern <pattern> <value>
+    @endverbatim
+    The first two lines are required and must be in this order. The
+    other lines are optional and in any order; missing weights are zero.
+    The lines @c hidden_bias and @c output are only allowed with a nonzero
+    hidden size. A feature line contains the name of the group (see
+    GoUctPredictorFeatures::GroupName()), the index of the feature within
+    the group and one value (linear) or as many values as the hidden
+    size. A large pattern line contains a pattern in the format of
+    GoUctNeighborhoodPatterns and one value. */
+class GoUctAdditiveKnowledgeParamPredictor
+    : public GoUctAdditiveKnowledgeParam
+{
+public:
+    /** Version of the file format */
+    static const int FORMAT_VERSION = 1;
+
+    /** Maximum size of the hidden layer */
+    static const int MAX_HIDDEN_SIZE = 256;
+
+    /** Constructor with the default weights. */
+    GoUctAdditiveKnowledgeParamPredictor();
+
+    /** Size of the hidden layer, 0 for a linear model. */
+    int HiddenSize() const;
+
+    float PassScore() const;
+
+    /** Values of large patterns; empty with the default weights. */
+    const GoUctNeighborhoodPatterns& LargePatterns() const;
+
+    /** Read weights.
+        @throws SgException on errors; the weights are unchanged then. */
+    void Read(std::istream& in);
+
+    /** Read weights from a file.
+        @see Read(std::istream&) */
+    void Read(const std::string& fileName);
+
+    /** Write the weights in the format of Read().
+        Only features with nonzero weights are written. */
+    void Write(std::ostream& out) const;
+
+    /** Compute the scores of moves.
+        @param features The features of the moves as computed by
+        GoUctPredictorFeatures::Compute(), NU_GROUPS per move
+        @param nuMoves The number of moves
+        @param[out] scores The scores of the moves */
+    void Evaluate(const int* features, std::size_t nuMoves,
+                  float* scores) const;
+
+private:
+    int m_hiddenSize;
+
+    /** m_hiddenSize rounded up to a multiple of the vector width; the
+        padding weights are zero. Weights per feature, 1 for linear. */
+    int m_stride;
+
+    float m_bias;
+
+    float m_passScore;
+
+    /** Weights of the features, m_stride per feature. */
+    std::vector<float> m_weights;
+
+    /** m_stride values */
+    std::vector<float> m_hiddenBias;
+
+    /** m_stride values */
+    std::vector<float> m_output;
+
+    GoUctNeighborhoodPatterns m_largePatterns;
+
+    void Init(int hiddenSize);
+
+    void SetDefaultWeights();
+};
+
+inline int GoUctAdditiveKnowledgeParamPredictor::HiddenSize() const
+{
+    return m_hiddenSize;
+}
+
+inline const GoUctNeighborhoodPatterns&
+GoUctAdditiveKnowledgeParamPredictor::LargePatterns() const
+{
+    return m_largePatterns;
+}
+
+inline float GoUctAdditiveKnowledgeParamPredictor::PassScore() const
+{
+    return m_passScore;
+}
+
+//----------------------------------------------------------------------------
+
+/** Additive knowledge from a feature-based move predictor.
+    The features of all moves are computed first, then all moves are
+    scored at once by GoUctAdditiveKnowledgeParamPredictor::Evaluate(),
+    which uses vector instructions for the MLP layers.
+    @see GoUctPredictorFeatures, GoUctAdditiveKnowledgeParamPredictor */
+class GoUctAdditiveKnowledgePredictor
+    : public GoUctAdditiveKnowledgeStdProb
+{
+public:
+    GoUctAdditiveKnowledgePredictor(const GoBoard& bd,
+                            const GoUctAdditiveKnowledgeParamPredictor& param);
+
+    void ProcessPosition(std::vector<SgUctMoveInfo>& moves);
+
+    /** The features of a move in the last call of ProcessPosition().
+        @param i The index of the move in the move list
+        @return NU_GROUPS feature indices */
+    const int* Features(std::size_t i) const;
+
+private:
+    const GoUctAdditiveKnowledgeParamPredictor& m_param;
+
+    /** Reuses the ladder features between the positions of the search. */
+    GoLadderCache m_ladderCache;
+
+    std::vector<int> m_features;
+
+    std::vector<float> m_scores;
+};
+
+inline const int* GoUctAdditiveKnowledgePredictor::Features(std::size_t i)
+    const
+{
+    return &m_features[i * GoUctPredictorFeatures::NU_GROUPS];
+}
+
+//----------------------------------------------------------------------------
+
+#endif // GOUCT_ADDITIVEKNOWLEDGEPREDICTOR_H
@@ -9,6 +9,7 @@
 #include <boost/static_assert.hpp>
 #include <algorithm>
 #include "GoBoardUtil.h"
+#include "GoNeighborhoodHash.h"
 #include "SgNbIterator.h"
 #include "SgStack.h"
 
@@ -250,10 +251,13 @@ void GoUctBoard::Init(const GoBoard& bd)
     {
         SgPoint p = *it;
         SgBoardColor c = bd.GetColor(p);
-        m_color[p] = c;
-        m_nuNeighbors[SG_BLACK][p] = bd.NumNeighbors(p, SG_BLACK);
-        m_nuNeighbors[SG_WHITE][p] = bd.NumNeighbors(p, SG_WHITE);
-        m_nuNeighborsEmpty[p] = bd.NumEmptyNeighbors(p);
+        m_color[p] = static_cast<unsigned char>(c);
+        m_nuNeighbors[SG_BLACK][p] =
+            static_cast<unsigned char>(bd.NumNeighbors(p, SG_BLACK));
+        m_nuNeighbors[SG_WHITE][p] =
+            static_cast<unsigned char>(bd.NumNeighbors(p, SG_WHITE));
+        m_nuNeighborsEmpty[p] =
+            static_cast<unsigned char>(bd.NumEmptyNeighbors(p));
         if (bd.IsEmpty(p))
             m_block[p] = 0;
         else if (bd.Anchor(p) == p)
@@ -270,6 +274,13 @@ void GoUctBoard::Init(const GoBoard& bd)
                 block.m_liberties.PushBack(*it2);
         }
     }
+    if (m_neighborhoodHash)
+    {
+        if (bd.NeighborhoodHash() != 0)
+            *m_neighborhoodHash = *bd.NeighborhoodHash();
+        else
+            m_neighborhoodHash->Init(bd);
+    }
     CheckConsistency();
 }
 
@@ -319,16 +330,18 @@ void GoUctBoard::AddStone(SgPoint p, SgBlackWhite c)
 {
     SG_ASSERT(IsEmpty(p));
     SG_ASSERT_BW(c);
-    m_color[p] = c;
+    m_color[p] = static_cast<unsigned char>(c);
     --m_nuNeighborsEmpty[p - SG_NS];
     --m_nuNeighborsEmpty[p - SG_WE];
     --m_nuNeighborsEmpty[p + SG_WE];
     --m_nuNeighborsEmpty[p + SG_NS];
-    SgArray<int,SG_MAXPOINT>& nuNeighbors = m_nuNeighbors[c];
+    SgArray<unsigned char,SG_MAXPOINT>& nuNeighbors = m_nuNeighbors[c];
     ++nuNeighbors[p - SG_NS];
     ++nuNeighbors[p - SG_WE];
     ++nuNeighbors[p + SG_WE];
     ++nuNeighbors[p + SG_NS];
+    if (m_neighborhoodHash)
+        m_neighborhoodHash->XorStone(p, c);
 }
 
 /** Remove liberty from adjacent blocks and kill opponent blocks without
@@ -392,7 +405,7 @@ void GoUctBoard::KillBlock(const Block* block)
 {
     SgBlackWhite c = block->m_color;
     SgBlackWhite opp = SgOppBW(c);
-    SgArray<int,SG_MAXPOINT>& nuNeighbors = m_nuNeighbors[c];
+    SgArray<unsigned char,SG_MAXPOINT>& nuNeighbors = m_nuNeighbors[c];
     for (Block::StoneIterator it(block->m_stones); it; ++it)
     {
         SgPoint p = *it;
@@ -406,6 +419,8 @@ void GoUctBoard::KillBlock(const Block* block)
         --nuNeighbors[p - SG_WE];
         --nuNeighbors[p + SG_WE];
         --nuNeighbors[p + SG_NS];
+        if (m_neighborhoodHash)
+            m_neighborhoodHash->XorStone(p, c);
         m_capturedStones.PushBack(p);
         m_block[p] = 0;
     }
@@ -443,4 +458,15 @@ void GoUctBoard::Play(SgPoint p)
     CheckConsistency();
 }
 
+void GoUctBoard::SetNeighborhoodHash(bool enable)
+{
+    if (! enable)
+        m_neighborhoodHash.reset();
+    else if (! m_neighborhoodHash)
+    {
+        m_neighborhoodHash.reset(new GoNeighborhoodHash());
+        m_neighborhoodHash->Init(*this);
+    }
+}
+
 //----------------------------------------------------------------------------
@@ -8,6 +8,7 @@
 
 #include <bitset>
 #include <cstring>
+#include <memory>
 #include <stdint.h>
 #include <boost/static_assert.hpp>
 #include "GoBoard.h"
@@ -61,9 +62,21 @@ public:
 
     const SgBoardConst& BoardConst() const;
 
-    /** Re-initializes the board from GoBoard position. */
+    /** Re-initializes the board from GoBoard position.
+        If the neighborhood hash codes are enabled, they are copied from
+        the GoBoard, if enabled there, or computed. */
     void Init(const GoBoard& bd);
 
+    /** Enable or disable incremental hash codes of the neighborhoods of
+        the points.
+        @see GoBoard::SetNeighborhoodHash() */
+    void SetNeighborhoodHash(bool enable);
+
+    /** The hash codes of the neighborhoods of the points.
+        @return The hash codes or 0, if not enabled with
+        SetNeighborhoodHash() */
+    const GoNeighborhoodHash* NeighborhoodHash() const;
+
     /** Return the size of this board. */
     SgGrid Size() const;
 
@@ -328,14 +341,17 @@ private:
     /** Number of prisoners of each color */
     SgBWArray<int> m_prisoners;
 
-    /** The current board position. */
-    SgArray<int,SG_MAXPOINT> m_color;
+    /** The current board position.
+        The per-point arrays use single bytes instead of int, so that the
+        data touched by a playout on a small board fits in a few cache lines
+        even if the code was compiled for a larger SG_MAX_SIZE. */
+    SgArray<unsigned char,SG_MAXPOINT> m_color;
 
-    /** Number of black and white neighbors. */
-    SgArray<int,SG_MAXPOINT> m_nuNeighborsEmpty;
+    /** Number of empty neighbors. */
+    SgArray<unsigned char,SG_MAXPOINT> m_nuNeighborsEmpty;
 
     /** Number of black and white neighbors. */
-    SgBWArray<SgArray<int,SG_MAXPOINT> > m_nuNeighbors;
+    SgBWArray<SgArray<unsigned char,SG_MAXPOINT> > m_nuNeighbors;
 
     /** Data that's constant for this board size. */
     SgBoardConst m_const;
@@ -353,6 +369,9 @@ private:
 
     SgArray<bool,SG_MAXPOINT> m_isBorder;
 
+    /** See SetNeighborhoodHash() */
+    std::unique_ptr<GoNeighborhoodHash> m_neighborhoodHash;
+
     /** Not implemented. */
     GoUctBoard(const GoUctBoard&);
 
@@ -809,6 +828,11 @@ inline void GoUctBoard::NeighborBlocks(SgPoint p, SgBlackWhite c, int maxLib,
     anchors[i] = SG_ENDPOINT;
 }
 
+inline const GoNeighborhoodHash* GoUctBoard::NeighborhoodHash() const
+{
+    return m_neighborhoodHash.get();
+}
+
 inline int GoUctBoard::Num8Neighbors(SgPoint p, SgBlackWhite c) const
 {
     return NumNeighbors(p, c) + NumDiagonals(p, c);
@@ -12,6 +12,7 @@
 #include "GoGtpCommandUtil.h"
 #include "GoBoardUtil.h"
 #include "GoSafetySolver.h"
+#include "GoUctAdditiveKnowledgePredictor.h"
 #include "GoUctDefaultPriorKnowledge.h"
 #include "GoUctDefaultMoveFilter.h"
 #include "GoUctEstimatorStat.h"
@@ -204,6 +205,8 @@ std::string KnowledgeTypeToString(KnowledgeType type)
             return "rulebased";
         case KNOWLEDGE_BOTH:
             return "both";
+        case KNOWLEDGE_PREDICTOR:
+            return "predictor";
         default:
             SG_ASSERT(false);
             return "?";
@@ -221,6 +224,8 @@ KnowledgeType KnowledgeTypeArg(const GtpCommand& cmd, size_t number)
         return KNOWLEDGE_RULEBASED;
     if (arg == "both")
         return KNOWLEDGE_BOTH;
+    if (arg == "predictor")
+        return KNOWLEDGE_PREDICTOR;
     throw GtpFailure() << "unknown KnowledgeType argument \"" << arg << '"';
 }
 
@@ -553,6 +558,7 @@ void GoUctCommands::CmdMoves(GtpCommand& cmd)
     @arg @c mercy_rule See GoUctGlobalSearchStateParam::m_mercyRule
     @arg @c territory_statistics See
         GoUctGlobalSearchStateParam::m_territoryStatistics
+    @arg @c knowledge_cache_size See GoUctGlobalSearch::KnowledgeCacheSize
     @arg @c length_modification See
         GoUctGlobalSearchStateParam::m_langthModification
     @arg @c score_modification See
@@ -573,6 +579,8 @@ void GoUctCommands::CmdParamGlobalSearch(GtpCommand& cmd)
             << "[bool] territory_statistics " << p.m_territoryStatistics
             << '\n'
             << "[bool] use_tree_filter " << p.m_useTreeFilter << '\n'
+            << "[string] knowledge_cache_size " << s.KnowledgeCacheSize()
+            << '\n'
             << "[string] length_modification " << p.m_lengthModification
             << '\n'
             << "[string] score_modification " << p.m_scoreModification
@@ -586,9 +594,14 @@ void GoUctCommands::CmdParamGlobalSearch(GtpCommand& cmd)
         else if (name == "mercy_rule")
             p.m_mercyRule = cmd.Arg<bool>(1);
         else if (name == "use_tree_filter")
+        {
             p.m_useTreeFilter = cmd.BoolArg(1);
+            s.ClearKnowledgeCache();
+        }
         else if (name == "territory_statistics")
             p.m_territoryStatistics = cmd.Arg<bool>(1);
+        else if (name == "knowledge_cache_size")
+            s.SetKnowledgeCacheSize(cmd.Arg<size_t>(1));
         else if (name == "length_modification")
             p.m_lengthModification = cmd.Arg<SgUctValue>(1);
         else if (name == "score_modification")
@@ -692,7 +705,11 @@ void GoUctCommands::CmdParamPlayer(GtpCommand& cmd)
     @arg @c nakade_heuristic
         See GoUctPlayoutPolicyParam::m_useNakadeHeuristic
     @arg @c fillboard_tries
-        See GoUctPlayoutPolicyParam::m_fillboardTries */
+        See GoUctPlayoutPolicyParam::m_fillboardTries
+    @arg @c predictor_weights
+        See GoUctPlayoutPolicyParam::m_predictorWeights. The file is read
+        when the parameter is set; @c default selects the default
+        weights. */
 void GoUctCommands::CmdParamPolicy(GtpCommand& cmd)
 {
     cmd.CheckNuArgLessEqual(2);
@@ -708,12 +725,15 @@ void GoUctCommands::CmdParamPolicy(GtpCommand& cmd)
             << "[bool] use_patterns_in_prior_knowledge " 
             << p.m_usePatternsInPriorKnowledge << '\n'
             << "[int] fillboard_tries " << p.m_fillboardTries << '\n'
-            << "[list/none/greenpeep/rulebased/both] knowledge_type "
+            << "[list/none/greenpeep/rulebased/both/predictor] knowledge_type "
             << KnowledgeTypeToString(p.m_knowledgeType) << '\n'
             << "[list/multiply/geometric_mean/add/average/max] combination_type "
             << CombinationTypeToString(p.m_combinationType) << '\n'
             << "[float] pattern_gamma_threshold "
             << p.m_patternGammaThreshold << '\n'
+            << "[string] predictor_weights "
+            << (p.m_predictorWeights.empty() ? "default"
+                                             : p.m_predictorWeights) << '\n'
             ;
     }
     else if (cmd.NuArg() == 2)
@@ -741,8 +761,31 @@ void GoUctCommands::CmdParamPolicy(GtpCommand& cmd)
         }
         else if (name == "pattern_gamma_threshold")
             p.m_patternGammaThreshold = cmd.Arg<float>(1);
+        else if (name == "predictor_weights")
+        {
+            string fileName = cmd.Arg(1);
+            if (fileName == "default")
+                fileName = "";
+            else
+            {
+                // Check the file now rather than when creating the threads
+                GoUctAdditiveKnowledgeParamPredictor weights;
+                try
+                {
+                    weights.Read(fileName);
+                }
+                catch (const SgException& e)
+                {
+                    throw GtpFailure(e.what());
+                }
+            }
+            p.m_predictorWeights = fileName;
+            Search().CreateThreads(); // need to regenerate all search states
+        }
         else
             throw GtpFailure() << "unknown parameter: " << name;
+        // Cached move lists of node expansions may depend on the parameter
+        GlobalSearch().ClearKnowledgeCache();
     }
     else
         throw GtpFailure() << "need 0 or 2 arguments";
@@ -828,6 +871,7 @@ void GoUctCommands::CmdParamTreeFilter(GtpCommand& cmd)
             p.SetFilterFirstLine(cmd.Arg<bool>(1));
         else
             throw GtpFailure() << "unknown parameter: " << name;
+        GlobalSearch().ClearKnowledgeCache();
     }
     else
         throw GtpFailure() << "need 0 or 2 arguments";
@@ -840,6 +884,7 @@ void GoUctCommands::CmdParamTreeFilter(GtpCommand& cmd)
     @arg @c check_float_precision See GoUctSearch::CheckFloatPrecision
     @arg @c keep_games See GoUctSearch::KeepGames
     @arg @c lock_free See SgUctSearch::LockFree
+    @arg @c lockstep_playouts See SgUctSearch::LockstepPlayouts
     @arg @c log_games See SgUctSearch::LogGames
     @arg @c prune_full_tree See SgUctSearch::PruneFullTree
     @arg @c rave See SgUctSearch::Rave
@@ -870,6 +915,7 @@ void GoUctCommands::CmdParamSearch(GtpCommand& cmd)
             << '\n'
             << "[bool] keep_games " << s.KeepGames() << '\n'
             << "[bool] lock_free " << s.LockFree() << '\n'
+            << "[bool] lockstep_playouts " << s.LockstepPlayouts() << '\n'
             << "[bool] log_games " << s.LogGames() << '\n'
             << "[bool] prune_full_tree " << s.PruneFullTree() << '\n'
             << "[bool] rave " << s.Rave() << '\n'
@@ -942,6 +988,8 @@ void GoUctCommands::CmdParamSearch(GtpCommand& cmd)
             s.SetLiveGfxInterval(cmd.ArgMin<SgUctValue>(1, 1));
         else if (name == "lock_free")
             s.SetLockFree(cmd.Arg<bool>(1));
+        else if (name == "lockstep_playouts")
+            s.SetLockstepPlayouts(cmd.Arg<bool>(1));
         else if (name == "log_games")
             s.SetLogGames(cmd.Arg<bool>(1));
         else if (name == "max_knowledge_threads")
@@ -1177,6 +1225,8 @@ void GoUctCommands::CmdStatPlayerClear(GtpCommand& cmd)
     Needs enabling the statistics with
     <code>uct_param_policy statistics_enabled</code>
     Only the statistics of the first thread's policy used.
+    The cost of the single heuristics is only written if Fuego was compiled
+    with GOUCT_POLICY_COST.
     @see GoUctPlayoutPolicyStat */
 void GoUctCommands::CmdStatPolicy(GtpCommand& cmd)
 {
@@ -1252,8 +1302,8 @@ SgUctValue GoUctCommands::DisplayTerritory(GtpCommand& cmd,
                                            MeanMapperFunction f)
 {
     cmd.CheckArgNone();
-    SgPointArray<SgUctStatistics> territoryStatistics
-        = ThreadState(0).m_territoryStatistics;
+    SgPointArray<SgUctStatistics> territoryStatistics;
+    GlobalSearch().GetTerritoryStatistics(territoryStatistics);
     SgPointArray<SgUctValue> array;
     SgUctValue sum = SgUctValue(0);
     for (GoBoard::Iterator it(m_bd); it; ++it)
@@ -1274,7 +1324,7 @@ SgUctValue GoUctCommands::DisplayTerritory(GtpCommand& cmd,
  Statistics are only collected, if enabled with
  <code>uct_param_global_search territory_statistics 1</code>. <br>
  Arguments: none
- @see GoUctGlobalSearchState::m_territoryStatistics */
+ @see GoUctGlobalSearch::GetTerritoryStatistics() */
 void GoUctCommands::CmdStatTerritory(GtpCommand& cmd)
 {
     DisplayTerritory(cmd, MapMeanToTerritoryEstimate);
@@ -1439,8 +1489,8 @@ SgPointSet GoUctCommands::DoFinalStatusSearch()
     }
     m_player->UpdateSubscriber();
 
-    SgPointArray<SgUctStatistics> territoryStatistics =
-        ThreadState(0).m_territoryStatistics;
+    SgPointArray<SgUctStatistics> territoryStatistics;
+    search.GetTerritoryStatistics(territoryStatistics);
     GoSafetySolver safetySolver(bd);
     SgBWSet safe;
     safetySolver.FindSafePoints(&safe);
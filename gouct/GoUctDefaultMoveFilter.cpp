@@ -6,6 +6,7 @@
 #include "SgSystem.h"
 #include "GoUctDefaultMoveFilter.h"
 
+#include <algorithm>
 #include "GoBensonSolver.h"
 #include "GoBoard.h"
 #include "GoBoardUtil.h"
@@ -71,15 +72,84 @@ GoUctDefaultMoveFilterParam::GoUctDefaultMoveFilterParam()
 
 GoUctDefaultMoveFilter::GoUctDefaultMoveFilter(const GoBoard& bd, const GoUctDefaultMoveFilterParam &param)
     : m_bd(bd),
-      m_param(param)
+      m_param(param),
+      m_isTracking(false),
+      m_isValid(false)
 { }
 
+void GoUctDefaultMoveFilter::AddChanged(SgPoint p)
+{
+    if (! m_isValid)
+        return;
+    if (m_changedPoints.size() >= static_cast<size_t>(SG_MAXPOINT))
+    {
+        // Get() was not called for a long time, compute everything again
+        m_isValid = false;
+        m_changed.Clear();
+        m_changedPoints.clear();
+        return;
+    }
+    m_changed.Include(p);
+    m_changedPoints.push_back(p);
+}
+
+void GoUctDefaultMoveFilter::AddLadderCandidate(SgPoint p)
+{
+    if (m_bd.Occupied(p))
+    {
+        const SgPoint anchor = m_bd.Anchor(p);
+        if (m_bd.NumLiberties(anchor) <= 2 && m_marker.NewMark(anchor))
+            m_ladderCandidates.push_back(anchor);
+    }
+}
+
+SgPointSet GoUctDefaultMoveFilter::ComputeFirstLine() const
+{
+    SgPointSet firstLine;
+    const SgBoardConst& bc = m_bd.BoardConst();
+    for (SgLineIterator it(bc, 1); it; ++it)
+    {
+        const SgPoint p = *it;
+        if (m_bd.IsEmpty(p) && IsEmptyEdge(m_bd, p))
+            firstLine.Include(p);
+    }
+    return firstLine;
+}
+
 vector<SgPoint> GoUctDefaultMoveFilter::Get()
 {
     vector<SgPoint> rootFilter;
+    m_ladderCache.StartPosition();
     SgBlackWhite toPlay = m_bd.ToPlay();
     SgBlackWhite opp = SgOppBW(toPlay);
 
+    // Results of the last call that are still valid. They are also updated
+    // if the corresponding check is disabled, the parameters can change
+    // between calls
+    if (m_isTracking && m_isValid)
+    {
+        UpdateFirstLine();
+        UpdateLadderCandidates();
+        for (vector<LadderEntry>::iterator it = m_ladderEntries.begin();
+             it != m_ladderEntries.end(); )
+            if (it->m_region.Overlaps(m_changed))
+                it = m_ladderEntries.erase(it);
+            else
+                ++it;
+    }
+    else
+    {
+        m_firstLine = ComputeFirstLine();
+        m_ladderCandidates.clear();
+        for (GoBlockIterator it(m_bd); it; ++it)
+            if (m_bd.NumLiberties(*it) <= 2)
+                m_ladderCandidates.push_back(*it);
+        m_ladderEntries.clear();
+    }
+    m_changed.Clear();
+    m_changedPoints.clear();
+    m_isValid = m_isTracking;
+
     // Safe territory
     if (m_param.m_checkSafety)
     {
@@ -129,17 +199,15 @@ vector<SgPoint> GoUctDefaultMoveFilter::Get()
     // Loosing ladder defense moves
     if (m_param.m_checkLadders)
     {
-        for (GoBlockIterator it(m_bd); it; ++it)
+        for (vector<SgPoint>::const_iterator it = m_ladderCandidates.begin();
+             it != m_ladderCandidates.end(); ++it)
         {
             SgPoint p = *it;
             if (m_bd.GetStone(p) == toPlay && m_bd.InAtari(p))
             {
-                if (m_ladder.Ladder(m_bd, p, toPlay, &m_ladderSequence,
-                                    false/*twoLibIsEscape*/) < 0)
-                {
-                    if (m_ladderSequence.Length() >= m_param.m_minLadderLength)
-                        rootFilter.push_back(m_bd.TheLiberty(p));
-                }
+                SgPoint move = LadderMove(p, true);
+                if (move != SG_NULLMOVE)
+                    rootFilter.push_back(move);
             }
 
         }
@@ -147,17 +215,15 @@ vector<SgPoint> GoUctDefaultMoveFilter::Get()
 
     if (m_param.m_checkOffensiveLadders)
     {
-        for (GoBlockIterator it(m_bd); it; ++it)
+        for (vector<SgPoint>::const_iterator it = m_ladderCandidates.begin();
+             it != m_ladderCandidates.end(); ++it)
         {
             SgPoint p = *it;
             if (m_bd.GetStone(p) == opp && m_bd.NumStones(p) >= 5 && m_bd.NumLiberties(p) == 2)
             {
-                if (m_ladder.Ladder(m_bd, p, toPlay, &m_ladderSequence,
-                                    false/*twoLibIsEscape*/) > 0)
-                {
-                    if (m_ladderSequence.Length() >= m_param.m_minLadderLength) 
-                        rootFilter.push_back(m_ladderSequence[0]);
-                }
+                SgPoint move = LadderMove(p, false);
+                if (move != SG_NULLMOVE)
+                    rootFilter.push_back(move);
             }
         }
     }
@@ -165,16 +231,167 @@ vector<SgPoint> GoUctDefaultMoveFilter::Get()
     if (m_param.m_filterFirstLine)
     {
         // Moves on edge of board, if no stone is near
+        SG_ASSERT(! m_isTracking || m_firstLine == ComputeFirstLine());
         const SgBoardConst& bc = m_bd.BoardConst();
         for (SgLineIterator it(bc, 1); it; ++it)
-        {
-            const SgPoint p = *it;
-            if (m_bd.IsEmpty(p) && IsEmptyEdge(m_bd, p))
-                rootFilter.push_back(p);
-        }
+            if (m_firstLine.Contains(*it))
+                rootFilter.push_back(*it);
     }
 
     return rootFilter;
 }
 
+SgPoint GoUctDefaultMoveFilter::LadderMove(SgPoint anchor, bool isDefense)
+{
+    const SgBlackWhite toPlay = m_bd.ToPlay();
+    const SgPoint koPoint = m_bd.KoPoint();
+    vector<LadderEntry>::const_iterator it = m_ladderEntries.begin();
+    for ( ; it != m_ladderEntries.end(); ++it)
+        if (  it->m_anchor == anchor
+           && it->m_toPlay == toPlay
+           && it->m_koPoint == koPoint
+           )
+            break;
+    LadderEntry entry;
+    if (it != m_ladderEntries.end())
+        entry = *it;
+    else
+    {
+        entry.m_anchor = anchor;
+        entry.m_toPlay = toPlay;
+        entry.m_koPoint = koPoint;
+        entry.m_result = m_ladderCache.Ladder(m_bd, anchor, toPlay,
+                                              &m_ladderSequence,
+                                              false/*twoLibIsEscape*/,
+                                              m_isTracking ?
+                                              &entry.m_region : 0);
+        entry.m_length = m_ladderSequence.Length();
+        entry.m_firstMove = (m_ladderSequence.IsEmpty() ?
+                             SG_NULLMOVE : m_ladderSequence[0]);
+        if (m_isTracking)
+            m_ladderEntries.push_back(entry);
+    }
+    if (entry.m_length < m_param.m_minLadderLength)
+        return SG_NULLMOVE;
+    if (isDefense && entry.m_result < 0)
+        return m_bd.TheLiberty(anchor);
+    if (! isDefense && entry.m_result > 0)
+        return entry.m_firstMove;
+    return SG_NULLMOVE;
+}
+
+void GoUctDefaultMoveFilter::OnBoardChange()
+{
+    m_isTracking = true;
+    m_isValid = false;
+    m_changed.Clear();
+    m_changedPoints.clear();
+    m_movePoints.clear();
+    m_moveBegin.clear();
+}
+
+void GoUctDefaultMoveFilter::OnPlay()
+{
+    if (! m_isTracking)
+        return;
+    m_moveBegin.push_back(static_cast<int>(m_movePoints.size()));
+    const SgPoint p = m_bd.Move(m_bd.MoveNumber() - 1).Point();
+    if (! SgIsSpecialMove(p))
+        m_movePoints.push_back(p);
+    for (GoPointList::Iterator it(m_bd.CapturedStones()); it; ++it)
+        m_movePoints.push_back(*it);
+    for (size_t i = m_moveBegin.back(); i < m_movePoints.size(); ++i)
+        AddChanged(m_movePoints[i]);
+}
+
+void GoUctDefaultMoveFilter::PreUndo()
+{
+    if (! m_isTracking)
+        return;
+    if (m_moveBegin.empty())
+    {
+        // Move was played before the changes were reported
+        m_isValid = false;
+        return;
+    }
+    const size_t begin = m_moveBegin.back();
+    m_moveBegin.pop_back();
+    for (size_t i = begin; i < m_movePoints.size(); ++i)
+        AddChanged(m_movePoints[i]);
+    m_movePoints.resize(begin);
+}
+
+void GoUctDefaultMoveFilter::UpdateFirstLine()
+{
+    const int size = m_bd.Size();
+    if (7 * m_changedPoints.size() >= 4 * static_cast<size_t>(size - 1))
+    {
+        // Not fewer than the number of edge points, e.g. on small boards
+        m_firstLine = ComputeFirstLine();
+        return;
+    }
+    m_marker.Clear();
+    for (vector<SgPoint>::const_iterator it = m_changedPoints.begin();
+         it != m_changedPoints.end(); ++it)
+    {
+        // IsEmptyEdge() looks at points up to the third line and up to a
+        // distance of 3 along the edge
+        const int col = SgPointUtil::Col(*it);
+        const int row = SgPointUtil::Row(*it);
+        const int minCol = std::max(1, col - 3);
+        const int maxCol = std::min(size, col + 3);
+        const int minRow = std::max(1, row - 3);
+        const int maxRow = std::min(size, row + 3);
+        if (row <= 3)
+            for (int x = minCol; x <= maxCol; ++x)
+                UpdateFirstLine(SgPointUtil::Pt(x, 1));
+        if (row >= size - 2)
+            for (int x = minCol; x <= maxCol; ++x)
+                UpdateFirstLine(SgPointUtil::Pt(x, size));
+        if (col <= 3)
+            for (int y = minRow; y <= maxRow; ++y)
+                UpdateFirstLine(SgPointUtil::Pt(1, y));
+        if (col >= size - 2)
+            for (int y = minRow; y <= maxRow; ++y)
+                UpdateFirstLine(SgPointUtil::Pt(size, y));
+    }
+}
+
+inline void GoUctDefaultMoveFilter::UpdateFirstLine(SgPoint p)
+{
+    if (! m_marker.NewMark(p))
+        return;
+    if (m_bd.IsEmpty(p) && IsEmptyEdge(m_bd, p))
+        m_firstLine.Include(p);
+    else
+        m_firstLine.Exclude(p);
+}
+
+void GoUctDefaultMoveFilter::UpdateLadderCandidates()
+{
+    m_marker.Clear();
+    size_t nuCandidates = 0;
+    for (vector<SgPoint>::const_iterator it = m_ladderCandidates.begin();
+         it != m_ladderCandidates.end(); ++it)
+    {
+        const SgPoint p = *it;
+        if (  m_bd.Occupied(p)
+           && m_bd.Anchor(p) == p
+           && m_bd.NumLiberties(p) <= 2
+           && m_marker.NewMark(p)
+           )
+            m_ladderCandidates[nuCandidates++] = p;
+    }
+    m_ladderCandidates.resize(nuCandidates);
+    for (vector<SgPoint>::const_iterator it = m_changedPoints.begin();
+         it != m_changedPoints.end(); ++it)
+    {
+        AddLadderCandidate(*it);
+        AddLadderCandidate(*it + SG_NS);
+        AddLadderCandidate(*it - SG_NS);
+        AddLadderCandidate(*it + SG_WE);
+        AddLadderCandidate(*it - SG_WE);
+    }
+}
+
 //----------------------------------------------------------------------------
@@ -5,8 +5,10 @@
 #ifndef GOUCT_DEFAULTROOTFILTER_H
 #define GOUCT_DEFAULTROOTFILTER_H
 
-#include "GoLadder.h"
+#include "GoLadderCache.h"
 #include "GoUctMoveFilter.h"
+#include "SgMarker.h"
+#include "SgPointSet.h"
 
 class GoBoard;
 
@@ -120,7 +122,19 @@ inline void GoUctDefaultMoveFilterParam::SetMinLadderLength(int length)
 
 //----------------------------------------------------------------------------
 
-/** Default root filter used by GoUctPlayer. */
+/** Default root filter used by GoUctPlayer.
+    Also used as tree filter by GoUctGlobalSearchState.
+
+    The results of the first line filter and of the ladder checks are kept
+    between calls of Get(), if the owner reports the changes of the board
+    (see GoUctMoveFilter::OnBoardChange()). Only the results that depend on
+    a point that changed since they were computed are computed again: for
+    the first line filter, the edge points within distance 3 of a changed
+    point; for a ladder, the ones with a changed point in the region of the
+    ladder search (see GoLadderCache). Before the first call of
+    OnBoardChange(), all results are computed at every call of Get().
+    The safety analysis depends on the whole board and is always done
+    from scratch. */
 class GoUctDefaultMoveFilter
     : public GoUctMoveFilter
 {
@@ -137,18 +151,124 @@ public:
 
     // @} // @name
 
+    /** @name Virtual functions of GoUctMoveFilter */
+    // @{
+
+    void OnBoardChange();
+
+    void OnPlay();
+
+    void PreUndo();
+
+    // @} // @name
+
+    /** Ladder results reused between calls of Get().
+        Mainly for statistics. */
+    GoLadderCache& LadderCache();
+
 private:
+    /** Result of a ladder check, valid as long as no point in the region
+        of the ladder changes. */
+    struct LadderEntry
+    {
+        /** Anchor of the prey block. */
+        SgPoint m_anchor;
+
+        SgBlackWhite m_toPlay;
+
+        SgPoint m_koPoint;
+
+        /** Return value of GoLadderCache::Ladder() */
+        int m_result;
+
+        /** Length of the ladder sequence. */
+        int m_length;
+
+        /** First move of the ladder sequence or SG_NULLMOVE */
+        SgPoint m_firstMove;
+
+        /** Points that the result depends on. */
+        SgPointSet m_region;
+    };
+
     const GoBoard& m_bd;
 
     const GoUctDefaultMoveFilterParam &m_param;
 
-    GoLadder m_ladder;
+    /** Ladders of positions, in which the filter was used before, are not
+        searched again, if the stones near the ladder did not change. */
+    GoLadderCache m_ladderCache;
 
     /** Local variable in Get().
         Reused for efficiency. */
     mutable SgVector<SgPoint> m_ladderSequence;
+
+    /** Changes of the board are reported by the owner. */
+    bool m_isTracking;
+
+    /** The stored results are valid for the position of the last call of
+        Get(), apart from the points in m_changed. */
+    bool m_isValid;
+
+    /** Points that changed since the last call of Get(). */
+    SgPointSet m_changed;
+
+    /** The points of m_changed as a list (can contain duplicates). */
+    std::vector<SgPoint> m_changedPoints;
+
+    /** Points changed by the reported moves, i.e. the point of the move
+        and the captured stones, for each move in m_moveBegin. */
+    std::vector<SgPoint> m_movePoints;
+
+    /** Start index of the points of each reported move in m_movePoints. */
+    std::vector<int> m_moveBegin;
+
+    /** Edge points filtered by the first line filter. */
+    SgPointSet m_firstLine;
+
+    /** Anchors of the blocks with at most two liberties.
+        Candidates for the ladder checks. */
+    std::vector<SgPoint> m_ladderCandidates;
+
+    /** Local variable in UpdateFirstLine() and UpdateLadderCandidates().
+        Reused for efficiency. */
+    SgMarker m_marker;
+
+    /** See LadderEntry */
+    std::vector<LadderEntry> m_ladderEntries;
+
+    void AddChanged(SgPoint p);
+
+    void AddLadderCandidate(SgPoint p);
+
+    SgPointSet ComputeFirstLine() const;
+
+    /** Filtered move of the ladder check for a block.
+        @param anchor The block
+        @param isDefense Check for a loosing ladder defense (block in atari
+        of the color to play), otherwise for an offensive ladder (block of
+        the opponent with two liberties).
+        @return The move to filter or SG_NULLMOVE */
+    SgPoint LadderMove(SgPoint anchor, bool isDefense);
+
+    /** Update m_firstLine for the points in m_changedPoints. */
+    void UpdateFirstLine();
+
+    /** Update m_firstLine for an edge point, if not already done in the
+        current call of UpdateFirstLine(). */
+    void UpdateFirstLine(SgPoint p);
+
+    /** Update m_ladderCandidates for the points in m_changedPoints.
+        Only blocks that contain or are adjacent to a changed point can
+        have a different number of liberties. */
+    void UpdateLadderCandidates();
 };
 
+inline GoLadderCache& GoUctDefaultMoveFilter::LadderCache()
+{
+    return m_ladderCache;
+}
+
 //----------------------------------------------------------------------------
 
 #endif // GOUCT_DEFAULTROOTFILTER_H
@@ -12,12 +12,13 @@
 namespace {
 
 /** Test if playing on p puts any opponent block into atari */
-bool SetsAtari(const GoBoard& bd, SgPoint p)
+template<class BOARD>
+bool SetsAtari(const BOARD& bd, SgPoint p)
 {
     SG_ASSERT(bd.IsEmpty(p)); // Already checked
     SgBlackWhite opp = SgOppBW(bd.ToPlay());
     if (bd.NumNeighbors(p, opp) > 0)
-        for (GoNbIterator it(bd, p); it; ++it)
+        for (GoNb4Iterator<BOARD> it(bd, p); it; ++it)
             if (   bd.IsColor(*it, opp)
                 && bd.NumLiberties(*it) == 2
                )
@@ -25,23 +26,25 @@ bool SetsAtari(const GoBoard& bd, SgPoint p)
     return false;
 }
 
-bool HasMinNuOfAdjBlocks(const GoBoard& bd, SgPoint p,
+template<class BOARD>
+bool HasMinNuOfAdjBlocks(const BOARD& bd, SgPoint p,
                          int minNuBlocks)
 {
     static const int MANY_LIBS = SG_MAX_SIZE * SG_MAX_SIZE;
     SG_ASSERT(bd.IsSingleStone(p));
     int nuBlocks = 0;
-    for (GoAdjBlockIterator<GoBoard> it(bd, p, MANY_LIBS); it; ++it)
+    for (GoAdjBlockIterator<BOARD> it(bd, p, MANY_LIBS); it; ++it)
         if (++nuBlocks >= minNuBlocks)
             return true;
     return false;
 }
 
 // @todo write test cases
-inline SgPoint OtherLiberty(const GoBoard& bd, SgPoint ourStone, SgPoint p)
+template<class BOARD>
+inline SgPoint OtherLiberty(const BOARD& bd, SgPoint ourStone, SgPoint p)
 {
     SG_ASSERT(bd.NumLiberties(ourStone) == 2);
-    GoBoard::LibertyIterator it(bd, ourStone);
+    typename BOARD::LibertyIterator it(bd, ourStone);
     SG_ASSERT(it);
     if (*it == p) // get next
     {
@@ -57,10 +60,11 @@ inline SgPoint OtherLiberty(const GoBoard& bd, SgPoint ourStone, SgPoint p)
     }
 }
 
-inline SgPoint FindNeighborNotInColor(const GoBoard& bd, SgPoint p,
+template<class BOARD>
+inline SgPoint FindNeighborNotInColor(const BOARD& bd, SgPoint p,
                                          SgEmptyBlackWhite c)
 {
-    for (GoNbIterator it(bd, p); it; ++it)
+    for (GoNb4Iterator<BOARD> it(bd, p); it; ++it)
         if (! bd.IsColor(*it, c))
             return *it;
     SG_ASSERT(false);
@@ -68,13 +72,15 @@ inline SgPoint FindNeighborNotInColor(const GoBoard& bd, SgPoint p,
 }
 
 
-inline bool IsCorridorEndPoint(const GoBoard& bd, SgPoint p,
+template<class BOARD>
+inline bool IsCorridorEndPoint(const BOARD& bd, SgPoint p,
                                SgBlackWhite oppColor)
 {
     return bd.NumNeighbors(p, oppColor) + bd.NumEmptyNeighbors(p) == 1;
 }
 
-inline bool Is2PointEye(const GoBoard& bd, SgPoint p,
+template<class BOARD>
+inline bool Is2PointEye(const BOARD& bd, SgPoint p,
                         SgBlackWhite eyeColor, SgPoint& other)
 {
     const SgBlackWhite oppColor = SgOppBW(eyeColor);
@@ -85,7 +91,8 @@ inline bool Is2PointEye(const GoBoard& bd, SgPoint p,
     return IsCorridorEndPoint(bd, other, oppColor);
 }
 
-bool Is3PointEye(const GoBoard& bd, SgPoint p, SgBlackWhite eyeColor,
+template<class BOARD>
+bool Is3PointEye(const BOARD& bd, SgPoint p, SgBlackWhite eyeColor,
                  SgPoint* other)
 {
     const SgBlackWhite oppColor = SgOppBW(eyeColor);
@@ -94,7 +101,7 @@ bool Is3PointEye(const GoBoard& bd, SgPoint p, SgBlackWhite eyeColor,
     if (nuInsideNb == 2) // check if center point
     {
         int index = 0;
-        for (GoNbIterator it(bd, p); it; ++it)
+        for (GoNb4Iterator<BOARD> it(bd, p); it; ++it)
             if (bd.GetColor(*it) != eyeColor)
             {
                 SG_ASSERT(bd.GetColor(*it) != SG_BORDER);
@@ -114,7 +121,7 @@ bool Is3PointEye(const GoBoard& bd, SgPoint p, SgBlackWhite eyeColor,
                                  + bd.NumEmptyNeighbors(mid);
         if (midNuInsideNb != 2)
             return false;
-        for (GoNbIterator it(bd, mid); it; ++it)
+        for (GoNb4Iterator<BOARD> it(bd, mid); it; ++it)
             // find endpoint other than p. It must exist.
             if (*it != p && bd.GetColor(*it) != eyeColor)
             {
@@ -126,7 +133,8 @@ bool Is3PointEye(const GoBoard& bd, SgPoint p, SgBlackWhite eyeColor,
     return false; // nuInsideNb has other value
 }
 
-inline bool IsKoStone(const GoBoard& bd, SgPoint block)
+template<class BOARD>
+inline bool IsKoStone(const BOARD& bd, SgPoint block)
 {
     SG_ASSERT(bd.InAtari(block));
     SG_ASSERT(bd.NumStones(block) == 1);
@@ -136,13 +144,14 @@ inline bool IsKoStone(const GoBoard& bd, SgPoint block)
     if (bd.NumEmptyNeighbors(lib) + bd.NumNeighbors(lib, oppColor) > 0)
         return false;
     int nuInAtari = 0;
-    for (GoNbIterator it(bd, lib); it; ++it)
+    for (GoNb4Iterator<BOARD> it(bd, lib); it; ++it)
         if (bd.InAtari(*it) && ++nuInAtari > 1)
             return false;
     return true;
 }
 
-inline bool CanBeCapturedCleanly(const GoBoard& bd, SgPoint block)
+template<class BOARD>
+inline bool CanBeCapturedCleanly(const BOARD& bd, SgPoint block)
 {
     return   bd.InAtari(block)
           && (bd.NumStones(block) > 1 || ! IsKoStone(bd, block));
@@ -151,7 +160,8 @@ inline bool CanBeCapturedCleanly(const GoBoard& bd, SgPoint block)
 //  recognize simple one point false eyes:
 //  center        : >= 2 diagonal points occupied by non-dead opponent stones
 //  corner, edge  : >= 1 diagonal points occupied by non-dead opponent stones
-bool IsFalseEyePoint(const GoBoard& bd,
+template<class BOARD>
+bool IsFalseEyePoint(const BOARD& bd,
                      SgPoint p,
                      SgBlackWhite eyeColor)
 {
@@ -178,7 +188,8 @@ bool IsFalseEyePoint(const GoBoard& bd,
     @todo program cases 4, 5, 6.
     @todo add test cases.
 */
-bool MayMakeFalseEye(const GoBoard& bd,
+template<class BOARD>
+bool MayMakeFalseEye(const BOARD& bd,
                      SgPoint p,
                      SgBlackWhite eyeColor)
 {
@@ -279,7 +290,8 @@ bool MayMakeFalseEye(const GoBoard& bd,
 /** Heuristic for bad selfatari moves
 	@todo: should eliminate useless moves, but allow play in nakade.
 */
-bool BadSelfAtari(const GoBoard& bd, SgPoint p)
+template<class BOARD>
+bool BadSelfAtari(const BOARD& bd, SgPoint p)
 {
     int numStones;
     SgBlackWhite opp = bd.Opponent();
@@ -301,7 +313,10 @@ bool BadSelfAtari(const GoBoard& bd, SgPoint p)
 GoUctDefaultPriorKnowledge::GoUctDefaultPriorKnowledge(const GoBoard& bd,
                               const GoUctPlayoutPolicyParam& param)
     : GoUctKnowledge(bd),
-      m_policy(bd, param)
+      m_useUctBoard(false),
+      m_uctBd(bd),
+      m_policy(bd, param),
+      m_uctPolicy(m_uctBd, param)
 { }
 
 void GoUctDefaultPriorKnowledge::AddBonusNearPoint(GoPointList& emptyPoints,
@@ -316,13 +331,12 @@ void GoUctDefaultPriorKnowledge::AddBonusNearPoint(GoPointList& emptyPoints,
     if (focus == SG_NULLMOVE || focus == SG_PASS)
         return;
     
-    const GoBoard& bd = Board();
-    SgPointArray<int> dist = GoBoardUtil::CfgDistance(bd, focus, 3);
+    m_cfgDistance.Compute(Board(), focus, 3);
     for (GoPointList::Iterator it(emptyPoints); it; ++it)
     {
         const SgPoint p = *it;
         SgUctValue v;
-        switch (dist[p])
+        switch (m_cfgDistance.Distance(p))
         {
             case 1:  v = v1;
                 break;
@@ -370,15 +384,31 @@ bool GoUctDefaultPriorKnowledge::FindGlobalPatternAndAtariMoves(
                                                      SgPointSet& pattern,
                                                      SgPointSet& atari,
                                                      GoPointList& empty)
+{
+    if (! m_useUctBoard)
+        return FindGlobalPatternAndAtariMoves(Board(),
+                                              m_policy.GlobalPatterns(),
+                                              pattern, atari, empty);
+    m_uctBd.Init(Board());
+    return FindGlobalPatternAndAtariMoves(m_uctBd,
+                                          m_uctPolicy.GlobalPatterns(),
+                                          pattern, atari, empty);
+}
+
+template<class BOARD>
+bool GoUctDefaultPriorKnowledge::FindGlobalPatternAndAtariMoves(
+                                          const BOARD& bd,
+                                          const GoUctPatterns<BOARD>& patterns,
+                                          SgPointSet& pattern,
+                                          SgPointSet& atari,
+                                          GoPointList& empty)
 {
 	// Minimum value for pattern gamma to be used.
     static const float EPSILON = 0.00000000001;
-    const GoBoard& bd = Board();
     SG_ASSERT(empty.IsEmpty());
-    const GoUctPatterns<GoBoard>& patterns = m_policy.GlobalPatterns();
     bool result = false;
     m_maxPatternGamma = -1.f;
-    for (GoBoard::Iterator it(bd); it; ++it)
+    for (typename BOARD::Iterator it(bd); it; ++it)
         if (bd.IsEmpty(*it))
         {
             empty.PushBack(*it);
@@ -400,14 +430,15 @@ bool GoUctDefaultPriorKnowledge::FindGlobalPatternAndAtariMoves(
     return result;
 }
 
+template<class BOARD>
 void 
 GoUctDefaultPriorKnowledge::InitializeForGlobalHeuristic(
+    const BOARD& bd,
 	const GoPointList& empty,
     const SgPointSet& pattern,
     const SgPointSet& atari,
     int nuSimulations)
 {
-    const GoBoard& bd = Board();
     for (GoPointList::Iterator it(empty); it; ++it)
     {
         const SgPoint p = *it;
@@ -425,14 +456,16 @@ GoUctDefaultPriorKnowledge::InitializeForGlobalHeuristic(
     }
 }
 
+template<class BOARD>
 void 
 GoUctDefaultPriorKnowledge::InitializeForNonRandomPolicyMove(
+    const BOARD& bd,
+    GoUctPlayoutPolicy<BOARD>& policy,
 	const GoPointList& empty,
     const SgPointSet& pattern,
     const SgPointSet& atari,
     int nuSimulations)
 {
-    const GoBoard& bd = Board();
     for (GoPointList::Iterator it(empty); it; ++it)
     {
         const SgPoint p = *it;
@@ -448,18 +481,19 @@ GoUctDefaultPriorKnowledge::InitializeForNonRandomPolicyMove(
         else
             Initialize(p, 0.4f, nuSimulations);
     }
-    const GoPointList moves = m_policy.GetEquivalentBestMoves();
+    const GoPointList moves = policy.GetEquivalentBestMoves();
     for (GoPointList::Iterator it(moves); it; ++it)
         Initialize(*it, 1.0, nuSimulations);
 }
 
 
+template<class BOARD>
 void 
 GoUctDefaultPriorKnowledge::InitializeForRandomPolicyMove(
+    const BOARD& bd,
 	const GoPointList& empty,
     int nuSimulations)
 {
-    const GoBoard& bd = Board();
     for (GoPointList::Iterator it(empty); it; ++it)
     {
         const SgPoint p = *it;
@@ -473,13 +507,15 @@ GoUctDefaultPriorKnowledge::InitializeForRandomPolicyMove(
 
 namespace
 {
-    bool IsEmpty3x3Box(const GoBoard& bd, SgPoint p)
+    template<class BOARD>
+    bool IsEmpty3x3Box(const BOARD& bd, SgPoint p)
     {
         return bd.IsEmpty(p)
             && bd.Num8EmptyNeighbors(p) == 8;
     }
     
-    int ScanSide(const GoBoard& bd, SgPoint start, int direction)
+    template<class BOARD>
+    int ScanSide(const BOARD& bd, SgPoint start, int direction)
     {
         int dist = 0;
         for (SgPoint p = start + direction;
@@ -491,10 +527,10 @@ namespace
     }
 }
 
+template<class BOARD>
 void
-GoUctDefaultPriorKnowledge::AddOpeningBonus()
+GoUctDefaultPriorKnowledge::AddOpeningBonus(const BOARD& bd)
 {
-    const GoBoard& bd = Board();
     const SgBoardConst& bc = bd.BoardConst();
     // skipping corners for now, we have forced 4-4 moves
     for (SgLineIterator it(bc, 3); it; ++it)
@@ -524,41 +560,59 @@ void
 GoUctDefaultPriorKnowledge::ProcessPosition(std::vector<SgUctMoveInfo>&
                                             outmoves)
 {
-    m_policy.StartPlayout();
-    m_policy.GenerateMove();
-    GoUctPlayoutPolicyType type = m_policy.MoveType();
+    if (m_useUctBoard)
+    {
+        m_uctBd.Init(Board());
+        ProcessPosition(m_uctBd, m_uctPolicy, outmoves);
+    }
+    else
+        ProcessPosition(Board(), m_policy, outmoves);
+}
+
+template<class BOARD>
+void
+GoUctDefaultPriorKnowledge::ProcessPosition(const BOARD& bd,
+                                            GoUctPlayoutPolicy<BOARD>& policy,
+                                            std::vector<SgUctMoveInfo>&
+                                            outmoves)
+{
+    policy.StartPlayout();
+    policy.GenerateMove();
+    GoUctPlayoutPolicyType type = policy.MoveType();
     bool isFullBoardRandom =
         (type == GOUCT_RANDOM || type == GOUCT_FILLBOARD);
     SgPointSet pattern;
     SgPointSet atari;
     GoPointList empty;
-    bool anyHeuristic = FindGlobalPatternAndAtariMoves(pattern, atari, empty);
+    bool anyHeuristic = FindGlobalPatternAndAtariMoves(bd,
+                                                       policy.GlobalPatterns(),
+                                                       pattern, atari, empty);
 
     // The initialization values/counts are mainly tuned by selfplay
     // experiments and games vs MoGo Rel 3 and GNU Go 3.6 on 9x9 and 19x19.
     // If different values are used for the small and large board, the ones
     // from the 9x9 experiments are used for board sizes < 15, the ones from
     // 19x19 otherwise.
-    const bool isSmallBoard = (Board().Size() < 15);
+    const bool isSmallBoard = (bd.Size() < 15);
     const int defaultNuSimulations = isSmallBoard ? 9 : 18;
 
     Initialize(SG_PASS, 0.1f, defaultNuSimulations);
     if (isFullBoardRandom && ! anyHeuristic)
-    	InitializeForRandomPolicyMove(empty, defaultNuSimulations);
+    	InitializeForRandomPolicyMove(bd, empty, defaultNuSimulations);
     else if (isFullBoardRandom && anyHeuristic)
-    	InitializeForGlobalHeuristic(empty, pattern, atari,
+    	InitializeForGlobalHeuristic(bd, empty, pattern, atari,
                                      defaultNuSimulations);
     else
-    	InitializeForNonRandomPolicyMove(empty, pattern, atari,
+    	InitializeForNonRandomPolicyMove(bd, policy, empty, pattern, atari,
                                          defaultNuSimulations);
 
     AddLocalityBonus(empty, isSmallBoard);
     if (! isSmallBoard)
-        AddOpeningBonus();
-    GoUctLadderKnowledge ladderKnowledge(Board(), *this);
+        AddOpeningBonus(bd);
+    GoUctLadderKnowledge ladderKnowledge(Board(), *this, &m_ladderCache);
     ladderKnowledge.ProcessPosition();
 
-    m_policy.EndPlayout();
+    policy.EndPlayout();
     TransferValues(outmoves);
 }
 
@@ -6,6 +6,9 @@
 #define GOUCT_DEFAULTPRIORKNOWLEDGE_H
 
 #include "GoBoard.h"
+#include "GoCfgDistance.h"
+#include "GoLadderCache.h"
+#include "GoUctBoard.h"
 #include "GoUctKnowledge.h"
 #include "GoUctPlayoutPolicy.h"
 
@@ -17,6 +20,11 @@
     2. Global pattern gammas
     3. bonus near block of last move - nearness measured by cfg metric
     4. bonus for large sideextensions in the opening
+
+    The playout policy and the scans of the empty points can optionally run
+    on a GoUctBoard copy of the position, see SetUseUctBoard(). The ladder
+    knowledge and the CFG distances of the locality bonus always use the
+    GoBoard.
 */
 class GoUctDefaultPriorKnowledge
 : public GoUctKnowledge
@@ -30,10 +38,39 @@ public:
     bool FindGlobalPatternAndAtariMoves(SgPointSet& pattern,
                                         SgPointSet& atari,
                                         GoPointList& empty);
+
+    /** Ladder results reused between the positions of ProcessPosition().
+        Mainly for statistics. */
+    GoLadderCache& LadderCache();
+
+    /** Run the playout policy and the scans on a GoUctBoard copy of the
+        position.
+        If disabled, they run directly on the GoBoard. The priors are the
+        same. Default is false: the liberty and neighbor queries of the
+        scans are not faster on GoUctBoard, so the copy does not pay off
+        (see benchmark GoUctDefaultPriorKnowledge.ProcessPosition in
+        fuegobench). */
+    void SetUseUctBoard(bool enable);
+
 private:
+    /** See SetUseUctBoard() */
+    bool m_useUctBoard;
+
+    /** Copy of Board() for m_uctPolicy, initialized in ProcessPosition()
+        and FindGlobalPatternAndAtariMoves() */
+    GoUctBoard m_uctBd;
 
     GoUctPlayoutPolicy<GoBoard> m_policy;
 
+    GoUctPlayoutPolicy<GoUctBoard> m_uctPolicy;
+
+    /** Used by the ladder knowledge, see GoUctLadderKnowledge */
+    GoLadderCache m_ladderCache;
+
+    /** Distances from the focus point of AddBonusNearPoint(), reused
+        between positions */
+    GoCfgDistance m_cfgDistance;
+
     void AddBonusNearPoint(GoPointList& emptyPoints,
                            SgUctValue count,
                            SgPoint focus,
@@ -45,21 +82,40 @@ private:
     
     void AddLocalityBonus(GoPointList& emptyPoints, bool isSmallBoard);
 
-    void AddOpeningBonus();
-    
-    void InitializeForRandomPolicyMove(const GoPointList& empty,
+    template<class BOARD>
+    void AddOpeningBonus(const BOARD& bd);
+
+    template<class BOARD>
+    bool FindGlobalPatternAndAtariMoves(const BOARD& bd,
+                                        const GoUctPatterns<BOARD>& patterns,
+                                        SgPointSet& pattern,
+                                        SgPointSet& atari,
+                                        GoPointList& empty);
+
+    template<class BOARD>
+    void InitializeForRandomPolicyMove(const BOARD& bd,
+                                       const GoPointList& empty,
                                        int nuSimulations);
-                                       
-    void InitializeForGlobalHeuristic(const GoPointList& empty,
+
+    template<class BOARD>
+    void InitializeForGlobalHeuristic(const BOARD& bd,
+                                      const GoPointList& empty,
                                       const SgPointSet& pattern,
                                       const SgPointSet& atari,
                                       int nuSimulations);
 
-	void InitializeForNonRandomPolicyMove(const GoPointList& empty,
+    template<class BOARD>
+    void InitializeForNonRandomPolicyMove(const BOARD& bd,
+                                          GoUctPlayoutPolicy<BOARD>& policy,
+                                          const GoPointList& empty,
                                           const SgPointSet& pattern,
                                           const SgPointSet& atari,
                                           int nuSimulations);
 
+    template<class BOARD>
+    void ProcessPosition(const BOARD& bd, GoUctPlayoutPolicy<BOARD>& policy,
+                         std::vector<SgUctMoveInfo>& moves);
+
 	/** Temporary variable to hold max. of m_patternGammas for current move */
 	float m_maxPatternGamma;
 
@@ -67,6 +123,16 @@ private:
 	SgArray<float,SG_MAXPOINT> m_patternGammas;
 };
 
+inline GoLadderCache& GoUctDefaultPriorKnowledge::LadderCache()
+{
+    return m_ladderCache;
+}
+
+inline void GoUctDefaultPriorKnowledge::SetUseUctBoard(bool enable)
+{
+    m_useUctBoard = enable;
+}
+
 //----------------------------------------------------------------------------
 
 #endif // GOUCT_DEFAULTPRIORKNOWLEDGE_H
@@ -21,9 +21,13 @@
 #include "GoUctAdditiveKnowledge.h"
 #include "GoUctDefaultMoveFilter.h"
 #include "GoUctDefaultPriorKnowledge.h"
+#include "GoUctKnowledgeCache.h"
 #include "GoUctKnowledgeFactory.h"
+#include "GoUctOwnership.h"
+#include "GoUctPlayoutBatch.h"
 #include "GoUctSearch.h"
 #include "GoUctUtil.h"
+#include "SgWrite.h"
 
 #define BOOST_VERSION_MAJOR (BOOST_VERSION / 100000)
 #define BOOST_VERSION_MINOR (BOOST_VERSION / 100 % 1000)
@@ -120,9 +124,10 @@ public:
 
     const SgPointArray<bool>& m_allSafe;
 
-    /** Probabilities that a point belongs to Black in a terminal position.
-        Only computed if GoUctGlobalSearchStateParam::m_territoryStatistics. */
-    SgPointArray<SgUctStatistics> m_territoryStatistics;
+    /** Owners of the points in the terminal positions of this thread.
+        Only computed if GoUctGlobalSearchStateParam::m_territoryStatistics.
+        @see GoUctGlobalSearch::GetTerritoryStatistics() */
+    GoUctOwnership m_ownership;
 
     /** Constructor.
         @param threadId The number of the thread. Needed for passing to
@@ -167,6 +172,12 @@ public:
 
     void EndPlayout();
 
+    /** Play the playouts of a game with the playout batch.
+        Returns @c false, if no playout batch was set.
+        See SgUctThreadState::PlayoutGames() */
+    bool PlayoutGames(std::size_t nuPlayouts, std::size_t maxLength,
+                      SgUctGameInfo& info);
+
     void StartPlayout();
 
     void StartPlayouts();
@@ -175,12 +186,44 @@ public:
 
     POLICY* Policy();
 
+    /** The playout batch used by PlayoutGames().
+        Null, if no playout batch was set. */
+    GoUctPlayoutBatch* PlayoutBatch();
+
+    /** Set the playout batch used by PlayoutGames().
+        Takes ownership. */
+    void SetPlayoutBatch(GoUctPlayoutBatch* batch);
+
     /** Set random policy.
         Sets a new random policy and deletes the old one, if it existed. */
     void SetPolicy(POLICY* policy);
 
+    /** Set the cache for the move lists of GenerateAllMoves().
+        @param cache The cache (does not take ownership), null for not using
+        a cache. */
+    void SetKnowledgeCache(GoUctKnowledgeCache* cache);
+
     void ClearTerritoryStatistics();
 
+    /** Add the statistics of the ladder searches of the prior knowledge and
+        of the tree filter. */
+    void AddLadderStatistics(GoLadderCacheStatistics& knowledge,
+                             GoLadderCacheStatistics& treeFilter);
+
+    void ClearLadderStatistics();
+
+protected:
+    /** @name Virtual functions of GoUctState */
+    // @{
+
+    void OnBoardChange();
+
+    void OnPlay();
+
+    void PreUndo();
+
+    // @} // @name
+
 private:
     const GoUctGlobalSearchStateParam& m_param;
 
@@ -210,6 +253,11 @@ private:
     /** See SetMercyRule() */
     SgUctValue m_mercyRuleResult;
 
+    /** Owners of the points of the last evaluated position.
+        Only used with territory statistics. Initialized for the points off
+        the board, as needed by GoUctOwnership::Add(). */
+    SgPointArray<SgEmptyBlackWhite> m_scoreBoard;
+
     /** Inverse of maximum score one can reach on a board of the current
         size. */
     SgUctValue m_invMaxScore;
@@ -222,6 +270,17 @@ private:
 
     boost::scoped_ptr<POLICY> m_policy;
 
+    /** See SetPlayoutBatch() */
+    boost::scoped_ptr<GoUctPlayoutBatch> m_playoutBatch;
+
+    /** See SetKnowledgeCache() */
+    GoUctKnowledgeCache* m_knowledgeCache;
+
+    /** Filter applied at node expansions, if
+        GoUctGlobalSearchStateParam::m_useTreeFilter.
+        The changes of Board() are reported to the filter, so that it only
+        recomputes the results near the moves played and taken back since
+        the last node expansion of this thread. */
     GoUctDefaultMoveFilter m_treeFilter;
 
     /** Not implemented */
@@ -234,10 +293,19 @@ private:
 
     void ApplyAdditivePredictors(std::vector<SgUctMoveInfo>& moves);
 
+    /** Remove moves that are illegal in Board() from a cached move list. */
+    void RemoveIllegalMoves(std::vector<SgUctMoveInfo>& moves) const;
+
     bool CheckMercyRule();
 
+    /** Evaluate a terminal position.
+        @param bd The board
+        @param komi The komi
+        @param gameLength The length of the game from the root position of
+        the search (see GoUctState::GameLength()) */
     template<class BOARD>
-    SgUctValue EvaluateBoard(const BOARD& bd, float komi);
+    SgUctValue EvaluateBoard(const BOARD& bd, float komi,
+                             std::size_t gameLength);
 
     float GetKomi() const;
 };
@@ -258,9 +326,13 @@ GoUctGlobalSearchState<POLICY>::GoUctGlobalSearchState(unsigned int threadId,
       m_priorKnowledge(Board(), m_policyParam),
       m_additivePredictor(0),
       m_policy(policy),
+      m_knowledgeCache(0),
       m_treeFilter(Board(), m_treeFilterParam)
 {
+    m_random.SetStream(threadId);
+    m_scoreBoard.Fill(SG_EMPTY);
     ClearTerritoryStatistics();
+    m_treeFilter.OnBoardChange();
 }
 
 template<class POLICY>
@@ -309,12 +381,28 @@ void GoUctGlobalSearchState<POLICY>::ApplyFilter(std::vector<SgUctMoveInfo>& mov
     }
 }
 
+template<class POLICY>
+void GoUctGlobalSearchState<POLICY>::OnBoardChange()
+{
+    m_treeFilter.OnBoardChange();
+}
+
+template<class POLICY>
+void GoUctGlobalSearchState<POLICY>::OnPlay()
+{
+    m_treeFilter.OnPlay();
+}
+
+template<class POLICY>
+void GoUctGlobalSearchState<POLICY>::PreUndo()
+{
+    m_treeFilter.PreUndo();
+}
+
 template<class POLICY>
 void GoUctGlobalSearchState<POLICY>::ClearTerritoryStatistics()
 {
-    for (SgPointArray<SgUctStatistics>::NonConstIterator
-             it(m_territoryStatistics); it; ++it)
-        (*it).Clear();
+    m_ownership.Clear(Board().Size());
 }
 
 template<class POLICY>
@@ -329,21 +417,21 @@ SgUctValue GoUctGlobalSearchState<POLICY>::Evaluate()
 {
     float komi = GetKomi();
     if (IsInPlayout())
-        return EvaluateBoard(UctBoard(), komi);
+        return EvaluateBoard(UctBoard(), komi, GameLength());
     else
-        return EvaluateBoard(Board(), komi);
+        return EvaluateBoard(Board(), komi, GameLength());
 }
 
 template<class POLICY>
 template<class BOARD>
 SgUctValue GoUctGlobalSearchState<POLICY>::EvaluateBoard(const BOARD& bd,
-                                                         float komi)
+                                                      float komi,
+                                                      std::size_t gameLength)
 {
     SgUctValue score;
-    SgPointArray<SgEmptyBlackWhite> scoreBoard;
     SgPointArray<SgEmptyBlackWhite>* scoreBoardPtr;
     if (m_param.m_territoryStatistics)
-        scoreBoardPtr = &scoreBoard;
+        scoreBoardPtr = &m_scoreBoard;
     else
         scoreBoardPtr = 0;
     if (m_param.m_mercyRule && m_mercyRuleTriggered)
@@ -360,23 +448,11 @@ SgUctValue GoUctGlobalSearchState<POLICY>::EvaluateBoard(const BOARD& bd,
                                                         scoreBoardPtr));
     }
     if (m_param.m_territoryStatistics)
-        for (typename BOARD::Iterator it(bd); it; ++it)
-            switch (scoreBoard[*it])
-            {
-            case SG_BLACK:
-                m_territoryStatistics[*it].Add(1);
-                break;
-            case SG_WHITE:
-                m_territoryStatistics[*it].Add(0);
-                break;
-            case SG_EMPTY:
-                m_territoryStatistics[*it].Add(0.5);
-                break;
-            }
+        m_ownership.Add(m_scoreBoard);
     if (bd.ToPlay() != SG_BLACK)
         score *= -1;
     SgUctValue lengthMod =
-        SgUctValue(GameLength()) * m_param.m_lengthModification;
+        SgUctValue(gameLength) * m_param.m_lengthModification;
     if (lengthMod > 0.5)
         lengthMod = 0.5;
     if (score > std::numeric_limits<SgUctValue>::epsilon())
@@ -512,6 +588,28 @@ bool GoUctGlobalSearchState<POLICY>::GenerateAllMoves(SgUctValue count,
 {
     provenType = SG_NOT_PROVEN;
     moves.clear();  // FIXME: needed?
+    const GoBoard& bd = Board();
+    // The move generation after two passes depends on the position of the
+    // root of the search, see GenerateLegalMoves()
+    const bool useCache = (count == 0 && m_knowledgeCache != 0
+                           && m_knowledgeCache->IsEnabled()
+                           && ! GoBoardUtil::TwoPasses(bd));
+    SgHashCode key;
+    if (useCache)
+    {
+        GoUctAdditiveKnowledge* kn = GetAdditiveKnowledge();
+        const bool inMoveRange =
+            (kn != 0 && kn->InMoveRange(bd.MoveNumber()));
+        key = m_knowledgeCache->Key(bd, inMoveRange ? 1 : 0);
+        if (m_knowledgeCache->Lookup(key, moves))
+        {
+            // The key does not contain the history of the position, which
+            // decides about full board repetitions in superko rules
+            if (bd.Rules().GetKoRule() != GoRules::SIMPLEKO)
+                RemoveIllegalMoves(moves);
+            return false;
+        }
+    }
     GenerateLegalMoves(moves);
     if (! moves.empty() && count == 0) 
     {
@@ -519,6 +617,8 @@ bool GoUctGlobalSearchState<POLICY>::GenerateAllMoves(SgUctValue count,
             ApplyFilter(moves);
         m_priorKnowledge.ProcessPosition(moves);
         ApplyAdditivePredictors(moves);
+        if (useCache)
+            m_knowledgeCache->Store(key, moves);
     }
     return false;
 }
@@ -582,6 +682,93 @@ inline POLICY* GoUctGlobalSearchState<POLICY>::Policy()
     return m_policy.get();
 }
 
+template<class POLICY>
+bool GoUctGlobalSearchState<POLICY>::PlayoutGames(std::size_t nuPlayouts,
+                                                  std::size_t maxLength,
+                                                  SgUctGameInfo& info)
+{
+    if (! m_playoutBatch)
+        return false;
+    GoUctPlayoutBatch& batch = *m_playoutBatch;
+    batch.SetMercyRuleThreshold(m_param.m_mercyRule ?
+                                m_mercyRuleThreshold : 0);
+    batch.Run(Board(), nuPlayouts, maxLength);
+    const float komi = GetKomi();
+    for (std::size_t i = 0; i < nuPlayouts; ++i)
+    {
+        const std::vector<SgMove>& sequence = batch.Sequence(i);
+        const std::vector<bool>& skipRaveUpdate = batch.SkipRaveUpdate(i);
+        info.m_sequence[i].insert(info.m_sequence[i].end(),
+                                  sequence.begin(), sequence.end());
+        info.m_skipRaveUpdate[i].insert(info.m_skipRaveUpdate[i].end(),
+                                        skipRaveUpdate.begin(),
+                                        skipRaveUpdate.end());
+        info.m_aborted[i] = batch.Aborted(i);
+        if (batch.Aborted(i))
+            // Replaced by SgUctSearch::UnknownEval()
+            info.m_eval[i] = 0;
+        else
+        {
+            // EvaluateBoard() uses the playout state of the current game
+            m_passMovesPlayoutPhase = batch.NuPassMoves(i);
+            m_mercyRuleTriggered = batch.MercyRuleTriggered(i);
+            m_mercyRuleResult = batch.MercyRuleResult(i);
+            info.m_eval[i] = EvaluateBoard(batch.Board(i), komi,
+                                           GameLength() + sequence.size());
+        }
+    }
+    m_passMovesPlayoutPhase = 0;
+    m_mercyRuleTriggered = false;
+    return true;
+}
+
+template<class POLICY>
+inline GoUctPlayoutBatch* GoUctGlobalSearchState<POLICY>::PlayoutBatch()
+{
+    return m_playoutBatch.get();
+}
+
+template<class POLICY>
+void GoUctGlobalSearchState<POLICY>::RemoveIllegalMoves(
+                                     std::vector<SgUctMoveInfo>& moves) const
+{
+    const GoBoard& bd = Board();
+    std::size_t nuMoves = 0;
+    for (std::size_t i = 0; i < moves.size(); ++i)
+        if (moves[i].m_move == SG_PASS || bd.IsLegal(moves[i].m_move))
+            moves[nuMoves++] = moves[i];
+    moves.resize(nuMoves);
+}
+
+template<class POLICY>
+void GoUctGlobalSearchState<POLICY>::SetPlayoutBatch(GoUctPlayoutBatch* batch)
+{
+    m_playoutBatch.reset(batch);
+}
+
+template<class POLICY>
+void GoUctGlobalSearchState<POLICY>::AddLadderStatistics(
+                                      GoLadderCacheStatistics& knowledge,
+                                      GoLadderCacheStatistics& treeFilter)
+{
+    knowledge.Add(m_priorKnowledge.LadderCache().Statistics());
+    treeFilter.Add(m_treeFilter.LadderCache().Statistics());
+}
+
+template<class POLICY>
+void GoUctGlobalSearchState<POLICY>::ClearLadderStatistics()
+{
+    m_priorKnowledge.LadderCache().ClearStatistics();
+    m_treeFilter.LadderCache().ClearStatistics();
+}
+
+template<class POLICY>
+void GoUctGlobalSearchState<POLICY>::SetKnowledgeCache(
+                                                   GoUctKnowledgeCache* cache)
+{
+    m_knowledgeCache = cache;
+}
+
 template<class POLICY>
 void GoUctGlobalSearchState<POLICY>::SetPolicy(POLICY* policy)
 {
@@ -636,13 +823,15 @@ public:
         Stores a reference. Lifetime of parameter must exceed the lifetime of
         this instance.
         @param safe
-        @param allSafe */
+        @param allSafe
+        @param knowledgeCache The cache shared by the created states */
     GoUctGlobalSearchStateFactory(GoBoard& bd,
                           FACTORY& playoutPolicyFactory,
                           const GoUctPlayoutPolicyParam& policyParam,
                           const GoUctDefaultMoveFilterParam& treeFilterParam,
                           const SgBWSet& safe,
-                          const SgPointArray<bool>& allSafe);
+                          const SgPointArray<bool>& allSafe,
+                          GoUctKnowledgeCache& knowledgeCache);
 
     SgUctThreadState* Create(unsigned int threadId, 
                              const SgUctSearch& search);
@@ -661,6 +850,8 @@ private:
     const SgBWSet& m_safe;
 
     const SgPointArray<bool>& m_allSafe;
+
+    GoUctKnowledgeCache& m_knowledgeCache;
 };
 
 template<class POLICY, class FACTORY>
@@ -670,14 +861,16 @@ GoUctGlobalSearchStateFactory<POLICY,FACTORY>
                   const GoUctPlayoutPolicyParam& policyParam,
                   const GoUctDefaultMoveFilterParam& treeFilterParam,
                   const SgBWSet& safe,
-                  const SgPointArray<bool>& allSafe)
+                  const SgPointArray<bool>& allSafe,
+                  GoUctKnowledgeCache& knowledgeCache)
     : m_bd(bd),
       m_playoutPolicyFactory(playoutPolicyFactory),
       m_knowledgeFactory(policyParam),
       m_policyParam(policyParam),
       m_treeFilterParam(treeFilterParam),
       m_safe(safe),
-      m_allSafe(allSafe)
+      m_allSafe(allSafe),
+      m_knowledgeCache(knowledgeCache)
 { }
 
 //----------------------------------------------------------------------------
@@ -719,6 +912,8 @@ public:
 
     void DisplayGfx();
 
+    void WriteStatistics(std::ostream& out) const;
+
     // @} // @name
 
 
@@ -736,11 +931,45 @@ public:
     /** See GlobalSearchLiveGfx() */
     void SetGlobalSearchLiveGfx(bool enable);
 
+    /** Probabilities that the points belong to Black in the terminal
+        positions of the last search, merged over all threads.
+        Neutral points count as one half. The statistics of a point have
+        count zero, if territory statistics were not enabled
+        (GoUctGlobalSearchStateParam::m_territoryStatistics). Does not lock
+        the threads and can be called during a search, e.g. for live
+        graphics; the result is exact after the search.
+        @see GoUctOwnership */
+    void GetTerritoryStatistics(SgPointArray<SgUctStatistics>& statistics)
+        const;
+
+    /** Number of entries of the cache for the move lists of node
+        expansions.
+        The cache is shared by all threads and kept between searches. It is
+        cleared if the safe points found at the root change, if the board
+        size changes, or with ClearKnowledgeCache(). Zero disables the
+        cache. Default is 4096.
+        @see GoUctKnowledgeCache */
+    std::size_t KnowledgeCacheSize() const;
+
+    /** See KnowledgeCacheSize() */
+    void SetKnowledgeCacheSize(std::size_t nuEntries);
+
+    /** Clear the cache for the move lists of node expansions.
+        Needs to be called after changing parameters that affect the prior
+        knowledge, the tree filter or the additive knowledge. */
+    void ClearKnowledgeCache();
+
 private:
     SgBWSet m_safe;
 
     SgPointArray<bool> m_allSafe;
 
+    /** See KnowledgeCacheSize() */
+    std::size_t m_knowledgeCacheSize;
+
+    /** See KnowledgeCacheSize() */
+    GoUctKnowledgeCache m_knowledgeCache;
+
     boost::scoped_ptr<FACTORY> m_playoutPolicyFactory;
 
     GoRegionBoard m_regions;
@@ -755,6 +984,7 @@ GoUctGlobalSearch<POLICY,FACTORY>::GoUctGlobalSearch(GoBoard& bd,
                          const GoUctPlayoutPolicyParam& policyParam,
                          const GoUctDefaultMoveFilterParam& rootFilterParam)
     : GoUctSearch(bd, 0),
+      m_knowledgeCacheSize(4096),
       m_playoutPolicyFactory(playoutFactory),
       m_regions(bd),
       m_globalSearchLiveGfx(GOUCT_LIVEGFX_NONE)
@@ -764,7 +994,8 @@ GoUctGlobalSearch<POLICY,FACTORY>::GoUctGlobalSearch(GoBoard& bd,
                                                           *playoutFactory,
                                                           policyParam,
                                                           rootFilterParam,
-                                                          m_safe, m_allSafe);
+                                                          m_safe, m_allSafe,
+                                                          m_knowledgeCache);
     SetThreadStateFactory(stateFactory);
     SetDefaultParameters(bd.Size());
 
@@ -800,17 +1031,44 @@ void GoUctGlobalSearch<POLICY,FACTORY>::DisplayGfx()
     GoUctSearch::DisplayGfx();
     if (m_globalSearchLiveGfx)
     {
-        const GoUctGlobalSearchState<POLICY>& state =
-            dynamic_cast<GoUctGlobalSearchState<POLICY>&>(ThreadState(0));
+        SgPointArray<SgUctStatistics> territoryStatistics;
+        GetTerritoryStatistics(territoryStatistics);
         SgDebug() << "gogui-gfx:\n";
         GoUctUtil::GfxBestMove(*this, ToPlay(), SgDebug());
-        GoUctUtil::GfxTerritoryStatistics(state.m_territoryStatistics,
-                                          Board(), SgDebug());
+        GoUctUtil::GfxTerritoryStatistics(territoryStatistics, Board(),
+                                          SgDebug());
         GoUctUtil::GfxStatus(*this, SgDebug());
         SgDebug() << '\n';
     }
 }
 
+template<class POLICY, class FACTORY>
+void GoUctGlobalSearch<POLICY,FACTORY>::ClearKnowledgeCache()
+{
+    m_knowledgeCache.Clear();
+}
+
+template<class POLICY, class FACTORY>
+void GoUctGlobalSearch<POLICY,FACTORY>::GetTerritoryStatistics(
+                         SgPointArray<SgUctStatistics>& statistics) const
+{
+    const GoBoard& bd = Board();
+    GoUctOwnership ownership;
+    ownership.Clear(bd.Size());
+    for (unsigned int i = 0; i < NumberThreads(); ++i)
+        ownership.Merge(
+            dynamic_cast<const GoUctGlobalSearchState<POLICY>&>(ThreadState(i))
+            .m_ownership);
+    ownership.GetStatistics(bd, statistics);
+}
+
+template<class POLICY, class FACTORY>
+inline std::size_t GoUctGlobalSearch<POLICY,FACTORY>::KnowledgeCacheSize()
+    const
+{
+    return m_knowledgeCacheSize;
+}
+
 template<class POLICY, class FACTORY>
 void GoUctGlobalSearch<POLICY,FACTORY>::OnStartSearch()
 {
@@ -825,6 +1083,25 @@ void GoUctGlobalSearch<POLICY,FACTORY>::OnStartSearch()
         for (GoBoard::Iterator it(bd); it; ++it)
             m_allSafe[*it] = m_safe.OneContains(*it);
     }
+    const GoBoard& bd = Board();
+    m_knowledgeCache.Resize(m_knowledgeCacheSize, bd.Size() * bd.Size() + 1);
+    m_knowledgeCache.SetContext(m_knowledgeCache.SafetyCode(m_safe));
+    m_knowledgeCache.ClearStatistics();
+    for (unsigned int i = 0; i < NumberThreads(); ++i)
+        dynamic_cast<GoUctGlobalSearchState<POLICY>&>(ThreadState(i))
+            .ClearLadderStatistics();
+    if (LockstepPlayouts())
+        // Create the playout policies of the lockstep batches now, because
+        // the thread states would create them unsynchronized during the
+        // search
+        for (unsigned int i = 0; i < NumberThreads(); ++i)
+        {
+            GoUctGlobalSearchState<POLICY>& state =
+                dynamic_cast<GoUctGlobalSearchState<POLICY>&>(ThreadState(i));
+            GoUctPlayoutBatch* batch = state.PlayoutBatch();
+            if (batch != 0)
+                batch->Reserve(NumberPlayouts(), Board());
+        }
     if (m_globalSearchLiveGfx && ! m_param.m_territoryStatistics)
         SgWarning() <<
             "GoUctGlobalSearch: "
@@ -868,6 +1145,33 @@ inline void GoUctGlobalSearch<POLICY,FACTORY>::SetGlobalSearchLiveGfx(
     m_globalSearchLiveGfx = enable;
 }
 
+template<class POLICY, class FACTORY>
+inline void GoUctGlobalSearch<POLICY,FACTORY>::SetKnowledgeCacheSize(
+                                                         std::size_t nuEntries)
+{
+    m_knowledgeCacheSize = nuEntries;
+}
+
+template<class POLICY, class FACTORY>
+void GoUctGlobalSearch<POLICY,FACTORY>::WriteStatistics(std::ostream& out)
+    const
+{
+    GoUctSearch::WriteStatistics(out);
+    m_knowledgeCache.WriteStatistics(out);
+    if (! ThreadsCreated())
+        return;
+    GoLadderCacheStatistics knowledge;
+    GoLadderCacheStatistics treeFilter;
+    for (unsigned int i = 0; i < NumberThreads(); ++i)
+        dynamic_cast<GoUctGlobalSearchState<POLICY>&>(ThreadState(i))
+            .AddLadderStatistics(knowledge, treeFilter);
+    out << SgWriteLabel("LadderKn");
+    knowledge.Write(out);
+    out << '\n' << SgWriteLabel("LadderFilter");
+    treeFilter.Write(out);
+    out << '\n';
+}
+
 template<class POLICY, class FACTORY>
 SgUctValue GoUctGlobalSearch<POLICY,FACTORY>::UnknownEval() const
 {
@@ -907,10 +1211,18 @@ SgUctThreadState* GoUctGlobalSearchStateFactory<POLICY,FACTORY>::Create(
                                            m_treeFilterParam,
                                            m_safe, m_allSafe);
     POLICY* policy = m_playoutPolicyFactory.Create(state->UctBoard());
+    // Each thread uses its own random stream, derived from the global seed
+    policy->SetRandomStream(threadId);
     state->SetPolicy(policy);
+    state->SetPlayoutBatch(
+           new GoUctPolicyPlayoutBatch<POLICY,FACTORY>(m_playoutPolicyFactory,
+                                                       threadId));
     GoUctAdditiveKnowledge* knowledge = 
     	m_knowledgeFactory.Create(state->Board());
     state->SetAdditiveKnowledge(knowledge);
+    if (m_knowledgeFactory.NeedsNeighborhoodHash())
+        state->SetNeighborhoodHash(true);
+    state->SetKnowledgeCache(&m_knowledgeCache);
     return state;
 }
 
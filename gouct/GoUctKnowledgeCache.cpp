@@ -0,0 +1,176 @@
+//----------------------------------------------------------------------------
+/** @file GoUctKnowledgeCache.cpp
+    See GoUctKnowledgeCache.h */
+//----------------------------------------------------------------------------
+
+#include "SgSystem.h"
+#include "GoUctKnowledgeCache.h"
+
+#include <iomanip>
+#include <iostream>
+#include <boost/io/ios_state.hpp>
+#include "SgWrite.h"
+
+using namespace std;
+
+//----------------------------------------------------------------------------
+
+GoUctKnowledgeCache::GoUctKnowledgeCache()
+    : m_nuEntries(0),
+      m_maxMoves(0),
+      m_nuLookups(0),
+      m_nuHits(0),
+      m_nuStores(0)
+{
+    m_context.Clear();
+}
+
+void GoUctKnowledgeCache::Clear()
+{
+    for (size_t i = 0; i < m_nuEntries; ++i)
+    {
+        m_entries[i].m_version.store(0, memory_order_relaxed);
+        m_entries[i].m_nuMoves = 0;
+        m_entries[i].m_key.Clear();
+    }
+}
+
+void GoUctKnowledgeCache::ClearStatistics()
+{
+    m_nuLookups.store(0, memory_order_relaxed);
+    m_nuHits.store(0, memory_order_relaxed);
+    m_nuStores.store(0, memory_order_relaxed);
+}
+
+SgHashCode GoUctKnowledgeCache::Code(SgMove move, int part) const
+{
+    SG_ASSERT(move + 1 >= 0);
+    SG_ASSERT(move + 1 < SgHashZobrist<64>::MAX_HASH_INDEX);
+    SgHashCode code = m_zobrist.Get(move + 1);
+    code.RollLeft(11 * part);
+    return code;
+}
+
+SgHashCode GoUctKnowledgeCache::Key(const GoBoard& bd, int variant) const
+{
+    SgHashCode key = bd.GetHashCodeInclToPlay();
+    key.Xor(Code(variant, 5));
+    key.Xor(Code(bd.KoPoint(), 0));
+    key.Xor(Code(bd.GetLastMove(), 1));
+    key.Xor(Code(bd.Get2ndLastMove(), 2));
+    return key;
+}
+
+bool GoUctKnowledgeCache::Lookup(const SgHashCode& key,
+                                 vector<SgUctMoveInfo>& moves)
+{
+    if (m_nuEntries == 0)
+        return false;
+    m_nuLookups.fetch_add(1, memory_order_relaxed);
+    const Entry& entry = m_entries[key.Hash(static_cast<int>(m_nuEntries))];
+    const uint32_t version = entry.m_version.load(memory_order_acquire);
+    if ((version & 1) != 0)
+        return false;
+    const int nuMoves = entry.m_nuMoves;
+    if (nuMoves <= 0 || nuMoves > m_maxMoves || entry.m_key != key)
+        return false;
+    const size_t index = (&entry - m_entries.get());
+    const MoveData* data = &m_moves[index * m_maxMoves];
+    vector<SgUctMoveInfo> result(nuMoves);
+    for (int i = 0; i < nuMoves; ++i)
+    {
+        SgUctMoveInfo& info = result[i];
+        info.m_move = data[i].m_move;
+        info.m_value = data[i].m_value;
+        info.m_count = data[i].m_count;
+        info.m_raveValue = data[i].m_raveValue;
+        info.m_raveCount = data[i].m_raveCount;
+        info.m_predictorValue = data[i].m_predictorValue;
+    }
+    atomic_thread_fence(memory_order_acquire);
+    if (entry.m_version.load(memory_order_relaxed) != version)
+        // Entry was overwritten while reading
+        return false;
+    moves.swap(result);
+    m_nuHits.fetch_add(1, memory_order_relaxed);
+    return true;
+}
+
+void GoUctKnowledgeCache::Resize(size_t nuEntries, int maxMoves)
+{
+    if (nuEntries == m_nuEntries && maxMoves == m_maxMoves)
+        return;
+    m_nuEntries = nuEntries;
+    m_maxMoves = maxMoves;
+    m_entries.reset(nuEntries > 0 ? new Entry[nuEntries] : 0);
+    vector<MoveData>(nuEntries * maxMoves).swap(m_moves);
+    Clear();
+}
+
+SgHashCode GoUctKnowledgeCache::SafetyCode(const SgBWSet& safe) const
+{
+    SgHashCode code;
+    code.Clear();
+    for (SgSetIterator it(safe[SG_BLACK]); it; ++it)
+        code.Xor(Code(*it, 3));
+    for (SgSetIterator it(safe[SG_WHITE]); it; ++it)
+        code.Xor(Code(*it, 4));
+    return code;
+}
+
+void GoUctKnowledgeCache::SetContext(const SgHashCode& context)
+{
+    if (context == m_context)
+        return;
+    m_context = context;
+    Clear();
+}
+
+void GoUctKnowledgeCache::Store(const SgHashCode& key,
+                                const vector<SgUctMoveInfo>& moves)
+{
+    const int nuMoves = static_cast<int>(moves.size());
+    if (m_nuEntries == 0 || nuMoves == 0 || nuMoves > m_maxMoves)
+        return;
+    Entry& entry = m_entries[key.Hash(static_cast<int>(m_nuEntries))];
+    uint32_t version = entry.m_version.load(memory_order_relaxed);
+    if ((version & 1) != 0
+        || ! entry.m_version.compare_exchange_strong(version, version + 1,
+                                                     memory_order_acquire))
+        // Another thread is writing this entry
+        return;
+    atomic_thread_fence(memory_order_release);
+    const size_t index = (&entry - m_entries.get());
+    MoveData* data = &m_moves[index * m_maxMoves];
+    for (int i = 0; i < nuMoves; ++i)
+    {
+        const SgUctMoveInfo& info = moves[i];
+        data[i].m_move = info.m_move;
+        data[i].m_value = static_cast<float>(info.m_value);
+        data[i].m_count = static_cast<float>(info.m_count);
+        data[i].m_raveValue = static_cast<float>(info.m_raveValue);
+        data[i].m_raveCount = static_cast<float>(info.m_raveCount);
+        data[i].m_predictorValue = info.m_predictorValue;
+    }
+    entry.m_nuMoves = nuMoves;
+    entry.m_key = key;
+    entry.m_version.store(version + 2, memory_order_release);
+    m_nuStores.fetch_add(1, memory_order_relaxed);
+}
+
+void GoUctKnowledgeCache::WriteStatistics(ostream& out) const
+{
+    boost::io::ios_all_saver saver(out);
+    const size_t nuLookups = m_nuLookups.load(memory_order_relaxed);
+    const size_t nuHits = m_nuHits.load(memory_order_relaxed);
+    out << SgWriteLabel("KnCacheSize") << m_nuEntries << '\n'
+        << SgWriteLabel("KnCacheLookups") << nuLookups << '\n'
+        << SgWriteLabel("KnCacheHits") << nuHits << " ("
+        << fixed << setprecision(1)
+        << (nuLookups > 0 ? nuHits * 100.0 / double(nuLookups) : 0.0)
+        << "%)\n"
+        << SgWriteLabel("KnCacheStores")
+        << m_nuStores.load(memory_order_relaxed) << '\n';
+}
+
+//----------------------------------------------------------------------------
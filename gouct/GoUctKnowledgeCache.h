@@ -0,0 +1,172 @@
+//----------------------------------------------------------------------------
+/** @file GoUctKnowledgeCache.h
+    Cache for the move lists with knowledge of expanded nodes. */
+//----------------------------------------------------------------------------
+
+#ifndef GOUCT_KNOWLEDGECACHE_H
+#define GOUCT_KNOWLEDGECACHE_H
+
+#include <atomic>
+#include <iosfwd>
+#include <vector>
+#include <stdint.h>
+#include <boost/scoped_array.hpp>
+#include "GoBoard.h"
+#include "SgBWSet.h"
+#include "SgHash.h"
+#include "SgUctTree.h"
+
+//----------------------------------------------------------------------------
+
+/** Fixed-size hash table of the move lists generated for node expansion.
+    Stores the final move lists of
+    GoUctGlobalSearchState::GenerateAllMoves() (legal moves after the tree
+    filter, with the values of the prior knowledge and the additive
+    predictors), so that positions, which are expanded again (after reusing
+    the subtree of the last search, on transpositions, or after pruning the
+    tree), do not need the expensive knowledge computations again.
+
+    The cache is shared by all threads of a search and is lock-free. Each
+    entry is protected by a version counter (sequence lock): a writer
+    increments it to an odd value before writing and to the next even value
+    after writing. A reader does not retry; it reports a miss if the
+    counter was odd or changed during reading. Writers do not wait either:
+    if another thread is writing the same entry, the store is skipped.
+    Entries are replaced always.
+
+    The knowledge values are stored with float precision. */
+class GoUctKnowledgeCache
+{
+public:
+    GoUctKnowledgeCache();
+
+    /** Set the size of the cache.
+        Clears the cache if the size changes. Not thread-safe.
+        @param nuEntries The number of entries, zero disables the cache
+        @param maxMoves The maximum length of a move list (e.g. the number of
+        points on the board plus one for the pass move) */
+    void Resize(std::size_t nuEntries, int maxMoves);
+
+    /** Remove all entries. Not thread-safe. */
+    void Clear();
+
+    /** Clear the cache if the context of the stored knowledge changed.
+        Not thread-safe.
+        @param context Hash code for all information besides the position
+        that the knowledge depends on (e.g. see SafetyCode()) */
+    void SetContext(const SgHashCode& context);
+
+    bool IsEnabled() const;
+
+    std::size_t NuEntries() const;
+
+    /** The key for the current position of a board.
+        Includes the position, the color to play, the ko point and the last
+        two moves (used by the prior knowledge).
+        @param bd The board
+        @param variant Distinguishes move lists of the same position that
+        were computed with different knowledge (e.g. with or without
+        additive knowledge, which is only used in a range of move numbers) */
+    SgHashCode Key(const GoBoard& bd, int variant) const;
+
+    /** A hash code for a set of safe points.
+        Can be used as a context, see SetContext(). */
+    SgHashCode SafetyCode(const SgBWSet& safe) const;
+
+    /** Find a move list.
+        Thread-safe.
+        @param key
+        @param[out] moves The cached move list. Unchanged if not found.
+        @return @c true if found */
+    bool Lookup(const SgHashCode& key, std::vector<SgUctMoveInfo>& moves);
+
+    /** Store a move list.
+        Thread-safe. The list is not stored, if it is empty or too long, or
+        if another thread is currently writing the same entry. */
+    void Store(const SgHashCode& key,
+               const std::vector<SgUctMoveInfo>& moves);
+
+    /** @name Statistics */
+    // @{
+
+    void ClearStatistics();
+
+    void WriteStatistics(std::ostream& out) const;
+
+    // @} // @name
+
+private:
+    struct Entry
+    {
+        /** Sequence lock counter. Odd while the entry is written. */
+        std::atomic<uint32_t> m_version;
+
+        int m_nuMoves;
+
+        SgHashCode m_key;
+    };
+
+    /** Compact storage of SgUctMoveInfo. */
+    struct MoveData
+    {
+        SgMove m_move;
+
+        float m_value;
+
+        float m_count;
+
+        float m_raveValue;
+
+        float m_raveCount;
+
+        float m_predictorValue;
+    };
+
+    std::size_t m_nuEntries;
+
+    int m_maxMoves;
+
+    /** See SetContext() */
+    SgHashCode m_context;
+
+    /** Own Zobrist table for the ko point, the last moves and the safe
+        points. */
+    SgHashZobrist<64> m_zobrist;
+
+    boost::scoped_array<Entry> m_entries;
+
+    /** Move lists, m_maxMoves for each entry. */
+    std::vector<MoveData> m_moves;
+
+    std::atomic<std::size_t> m_nuLookups;
+
+    std::atomic<std::size_t> m_nuHits;
+
+    std::atomic<std::size_t> m_nuStores;
+
+    /** Zobrist code for a move or point.
+        @param move The move or point
+        @param part Distinguishes the codes for different uses of a move
+        (e.g. ko point and last move) by rotating the code */
+    SgHashCode Code(SgMove move, int part) const;
+
+    /** Not implemented */
+    GoUctKnowledgeCache(const GoUctKnowledgeCache&);
+
+    /** Not implemented */
+    GoUctKnowledgeCache& operator=(const GoUctKnowledgeCache&);
+};
+
+inline bool GoUctKnowledgeCache::IsEnabled() const
+{
+    return m_nuEntries > 0;
+}
+
+inline std::size_t GoUctKnowledgeCache::NuEntries() const
+{
+    return m_nuEntries;
+}
+
+//----------------------------------------------------------------------------
+
+#endif // GOUCT_KNOWLEDGECACHE_H
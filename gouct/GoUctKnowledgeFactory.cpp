@@ -16,6 +16,7 @@
 GoUctKnowledgeFactory::GoUctKnowledgeFactory(
     const GoUctPlayoutPolicyParam& param) :
     m_greenpeepParam(0),
+    m_predictorParam(0),
     m_param(param)
 { }
 
@@ -23,6 +24,7 @@ GoUctKnowledgeFactory::~GoUctKnowledgeFactory()
 {
 	if (m_greenpeepParam)
     	delete m_greenpeepParam;
+    delete m_predictorParam;
 }
 
 GoUctAdditiveKnowledgeParamGreenpeep& GoUctKnowledgeFactory::GreenpeepParam()
@@ -32,6 +34,32 @@ GoUctAdditiveKnowledgeParamGreenpeep& GoUctKnowledgeFactory::GreenpeepParam()
     return *m_greenpeepParam;
 }
 
+GoUctAdditiveKnowledgeParamPredictor& GoUctKnowledgeFactory::PredictorParam()
+{
+    if (m_predictorParam && m_predictorWeights == m_param.m_predictorWeights)
+        return *m_predictorParam;
+    GoUctAdditiveKnowledgeParamPredictor* param =
+        new GoUctAdditiveKnowledgeParamPredictor();
+    if (! m_param.m_predictorWeights.empty())
+    {
+        try
+        {
+            param->Read(m_param.m_predictorWeights);
+        }
+        catch (...)
+        {
+            delete param;
+            throw;
+        }
+    }
+    // The search states using the old weights are deleted before the new
+    // ones are created, see SgUctSearch::CreateThreads()
+    delete m_predictorParam;
+    m_predictorParam = param;
+    m_predictorWeights = m_param.m_predictorWeights;
+    return *m_predictorParam;
+}
+
 GoUctAdditiveKnowledge* GoUctKnowledgeFactory::Create(const GoBoard& bd)
 {
 	KnowledgeType type = m_param.m_knowledgeType;
@@ -62,9 +90,17 @@ GoUctAdditiveKnowledge* GoUctKnowledgeFactory::Create(const GoBoard& bd)
         return m;
     }
     break;
+    case KNOWLEDGE_PREDICTOR:
+        return new GoUctAdditiveKnowledgePredictor(bd, PredictorParam());
     default:
     	SG_ASSERT(false);
         return 0;
     }
 }
+
+bool GoUctKnowledgeFactory::NeedsNeighborhoodHash()
+{
+    return m_param.m_knowledgeType == KNOWLEDGE_PREDICTOR
+           && ! PredictorParam().LargePatterns().IsEmpty();
+}
 //----------------------------------------------------------------------------
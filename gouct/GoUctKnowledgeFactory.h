@@ -9,6 +9,7 @@
 
 #include "GoBoard.h"
 #include "GoUctAdditiveKnowledgeGreenpeep.h"
+#include "GoUctAdditiveKnowledgePredictor.h"
 
 //----------------------------------------------------------------------------
 class GoUctKnowledgeFactory
@@ -19,11 +20,26 @@ public:
 
     GoUctAdditiveKnowledge* Create(const GoBoard& bd);
 
+    /** Does the knowledge created by Create() use the neighborhood hash
+        codes of the board?
+        @see GoBoard::SetNeighborhoodHash() */
+    bool NeedsNeighborhoodHash();
+
     GoUctAdditiveKnowledgeParamGreenpeep& GreenpeepParam();
 
+    /** The weights of GoUctPlayoutPolicyParam::m_predictorWeights.
+        Read again if the file name has changed since the last call.
+        @throws SgException if the file cannot be read */
+    GoUctAdditiveKnowledgeParamPredictor& PredictorParam();
+
 private:
     GoUctAdditiveKnowledgeParamGreenpeep* m_greenpeepParam; 
 
+    GoUctAdditiveKnowledgeParamPredictor* m_predictorParam;
+
+    /** The file that m_predictorParam was read from */
+    std::string m_predictorWeights;
+
     /** The param used for additive knowledge */
     const GoUctPlayoutPolicyParam& m_param;
 };
@@ -8,7 +8,6 @@
 
 #include "GoBoardUtil.h"
 
-using GoLadderUtil::IsLadderCaptureMove;
 using namespace GoUctLadderKnowledgeParameters;
 
 //----------------------------------------------------------------------------
@@ -26,33 +25,6 @@ namespace
             liberties.PushBack(*it);
     }
 
-    /** Try liberties of blocks to find which ones can be captured */
-    void CheckLadders(const GoBoard& bd,
-                      const SgVector<SgPoint>& targetBlocks,
-                      SgVector<SgPoint>& ladderCaptureBlocks)
-    {
-        for (SgVectorIterator<SgPoint> it(targetBlocks); it; ++it)
-        {
-            const SgPoint block = *it;
-            if (  bd.NumLiberties(block) == 2
-               && bd.IsColor(block, bd.ToPlay())
-               )
-            {
-                SgVector<SgPoint> liberties;
-                GetLiberties(bd, block, liberties);
-                for (SgVectorIterator<SgPoint> it(liberties);  it; ++it)
-                {
-                    const SgPoint lib = *it;
-                    if (IsLadderCaptureMove(bd, block, lib))
-                    {
-                        ladderCaptureBlocks.PushBack(block);
-                        break;
-                    }
-                }
-            }
-        }
-    }
-
     /** Check if block at p has many adjacent opponent blocks
         @todo: Only a dummy implementation now. This rule is dubious 
         in general, but it recognizes many bad ladders quickly */
@@ -78,10 +50,46 @@ namespace
 } // namespace
 
 GoUctLadderKnowledge::GoUctLadderKnowledge(const GoBoard& bd,
-                           GoUctKnowledge& knowledge)
-                           : m_bd(bd), m_knowledge(knowledge)
+                           GoUctKnowledge& knowledge,
+                           GoLadderCache* ladderCache)
+                           : m_bd(bd), m_knowledge(knowledge),
+                             m_ladderCache(ladderCache)
 { }
 
+void GoUctLadderKnowledge::CheckLadders(const SgVector<SgPoint>& targetBlocks,
+                                        SgVector<SgPoint>& ladderCaptureBlocks)
+{
+    for (SgVectorIterator<SgPoint> it(targetBlocks); it; ++it)
+    {
+        const SgPoint block = *it;
+        if (  m_bd.NumLiberties(block) == 2
+           && m_bd.IsColor(block, m_bd.ToPlay())
+           )
+        {
+            SgVector<SgPoint> liberties;
+            GetLiberties(m_bd, block, liberties);
+            for (SgVectorIterator<SgPoint> it(liberties);  it; ++it)
+            {
+                const SgPoint lib = *it;
+                if (IsLadderCaptureMove(block, lib))
+                {
+                    ladderCaptureBlocks.PushBack(block);
+                    break;
+                }
+            }
+        }
+    }
+}
+
+void GoUctLadderKnowledge::FindLadderEscapeMoves(SgPoint prey,
+                                            SgVector<SgPoint>& escapeMoves)
+{
+    if (m_ladderCache != 0)
+        m_ladderCache->FindLadderEscapeMoves(m_bd, prey, escapeMoves);
+    else
+        GoLadderUtil::FindLadderEscapeMoves(m_bd, prey, escapeMoves);
+}
+
 void GoUctLadderKnowledge::InitializeLadderAttackMoves()
 {
     const SgPoint last = m_bd.GetLastMove();
@@ -113,7 +121,7 @@ void GoUctLadderKnowledge::Initialize2LibTacticsLadderMoves()
     SgVector<SgPoint> atMostTwoLibBlocks; 
 
     GoBoardUtil::AdjacentBlocks(m_bd, last, 2, &atMostTwoLibBlocks);
-    CheckLadders(m_bd, atMostTwoLibBlocks, blocks2LibsLadder);
+    CheckLadders(atMostTwoLibBlocks, blocks2LibsLadder);
 
     SgVector<SgPoint> good2LibTacticMove; // ladder moves to capture opponents
     for (SgVectorIterator<SgPoint> it(blocks2LibsLadder);  it; ++it)
@@ -130,7 +138,7 @@ void GoUctLadderKnowledge::Initialize2LibTacticsLadderMoves()
                 for (SgVectorIterator<SgPoint> it(liberties); it; ++it)
                 {
                     const SgPoint lib = *it;
-                    if (IsLadderCaptureMove(m_bd, oppAnchor, lib))
+                    if (IsLadderCaptureMove(oppAnchor, lib))
                         good2LibTacticMove.PushBack(lib);
                 }
             }
@@ -141,6 +149,14 @@ void GoUctLadderKnowledge::Initialize2LibTacticsLadderMoves()
         m_knowledge.Add(*it, 1.0, GOOD_2_LIB_TACTICS_LADDER_BONUS);
 }
 
+bool GoUctLadderKnowledge::IsLadderCaptureMove(SgPoint prey,
+                                               SgPoint firstMove)
+{
+    if (m_ladderCache != 0)
+        return m_ladderCache->IsLadderCaptureMove(m_bd, prey, firstMove);
+    return GoLadderUtil::IsLadderCaptureMove(m_bd, prey, firstMove);
+}
+
 void GoUctLadderKnowledge::LadderAttack(SgPoint p)
 {
     const SgBlackWhite toPlay = m_bd.ToPlay();
@@ -154,7 +170,7 @@ void GoUctLadderKnowledge::LadderAttack(SgPoint p)
     GetLiberties(m_bd, p, liberties);
     for (SgVectorIterator<SgPoint> it(liberties); it; ++it)
     {
-        if (IsLadderCaptureMove(m_bd, p, *it)) 
+        if (IsLadderCaptureMove(p, *it)) 
             m_knowledge.Add(*it, 1.0, LADDER_CAPTURE_BONUS);
     }
 }
@@ -166,7 +182,7 @@ void GoUctLadderKnowledge::LadderDefense(SgPoint p)
     SG_ASSERT(m_bd.InAtari(p));
 
     SgVector<SgPoint> escapeMoves;
-    GoLadderUtil::FindLadderEscapeMoves(m_bd, p, escapeMoves);
+    FindLadderEscapeMoves(p, escapeMoves);
     if (escapeMoves.IsEmpty()) // Do not try to escape
     {
         if (! MightBeNakadeStones(m_bd, p))
@@ -182,6 +198,8 @@ void GoUctLadderKnowledge::LadderDefense(SgPoint p)
 
 void GoUctLadderKnowledge::ProcessPosition()
 {
+    if (m_ladderCache != 0)
+        m_ladderCache->StartPosition();
 	InitializeLadderDefenseMoves();
 	InitializeLadderAttackMoves();
 	Initialize2LibTacticsLadderMoves();
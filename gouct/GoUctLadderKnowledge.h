@@ -7,6 +7,7 @@
 
 #include "GoBoard.h"
 #include "GoLadder.h"
+#include "GoLadderCache.h"
 #include "GoUctKnowledge.h"
 
 namespace GoUctLadderKnowledgeParameters
@@ -30,8 +31,15 @@ namespace GoUctLadderKnowledgeParameters
 class GoUctLadderKnowledge 
 {
 public:
+    /** Constructor.
+        @param bd
+        @param knowledge
+        @param ladderCache Optional store for ladder results, which is used
+        for reusing ladder searches from previous positions (e.g. the parent
+        nodes in a search tree). If 0, all ladders are searched. */
     GoUctLadderKnowledge(const GoBoard& bd,
-                         GoUctKnowledge& knowledge);
+                         GoUctKnowledge& knowledge,
+                         GoLadderCache* ladderCache = 0);
 
     /** Compute the ladder knowledge */
     void ProcessPosition();
@@ -47,9 +55,19 @@ private:
     /** The knowledge object we are adding to */
     GoUctKnowledge& m_knowledge;
 
-    /** For computing ladders. Kept as a field for efficiency. */
-    GoLadder m_ladder;
-    
+    /** See GoUctLadderKnowledge() */
+    GoLadderCache* m_ladderCache;
+
+    /** Try liberties of blocks to find which ones can be captured */
+    void CheckLadders(const SgVector<SgPoint>& targetBlocks,
+                      SgVector<SgPoint>& ladderCaptureBlocks);
+
+    /** GoLadderUtil::IsLadderCaptureMove(), using m_ladderCache if set */
+    bool IsLadderCaptureMove(SgPoint prey, SgPoint firstMove);
+
+    /** GoLadderUtil::FindLadderEscapeMoves(), using m_ladderCache if set */
+    void FindLadderEscapeMoves(SgPoint prey, SgVector<SgPoint>& escapeMoves);
+
     /** Defend our blocks next to last move */
     void InitializeLadderDefenseMoves();
 
@@ -11,4 +11,13 @@
 GoUctMoveFilter::~GoUctMoveFilter()
 { }
 
+void GoUctMoveFilter::OnBoardChange()
+{ }
+
+void GoUctMoveFilter::OnPlay()
+{ }
+
+void GoUctMoveFilter::PreUndo()
+{ }
+
 //----------------------------------------------------------------------------
@@ -23,6 +23,27 @@ public:
         This function is invoked by the player before the search, it does not
         need to be thread-safe. */
     virtual std::vector<SgPoint> Get() = 0;
+
+    /** @name Notification of board changes
+        Called by the owner of the filter for the changes of the board that
+        the filter was created for, as in the hook functions of
+        GoBoardSynchronizer. Filters can use them to reuse results of Get()
+        for the parts of the board that did not change. The default
+        implementations do nothing. */
+    // @{
+
+    /** Board was initialized or set up.
+        Should also be called once when the owner starts reporting the
+        changes. */
+    virtual void OnBoardChange();
+
+    /** Move was played on the board. */
+    virtual void OnPlay();
+
+    /** Move is about to be taken back on the board. */
+    virtual void PreUndo();
+
+    // @} // @name
 };
 
 //----------------------------------------------------------------------------
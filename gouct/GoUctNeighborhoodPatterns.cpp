@@ -0,0 +1,151 @@
+//----------------------------------------------------------------------------
+/** @file GoUctNeighborhoodPatterns.cpp
+    See GoUctNeighborhoodPatterns.h */
+//----------------------------------------------------------------------------
+
+#include "SgSystem.h"
+#include "GoUctNeighborhoodPatterns.h"
+
+#include "SgException.h"
+
+using namespace std;
+
+//----------------------------------------------------------------------------
+
+namespace {
+
+/** Radius of a pattern with a given length.
+    @return The radius or -1, if there is no such radius */
+int Radius(size_t length)
+{
+    for (int radius = GoNeighborhoodHash::MIN_RADIUS;
+         radius <= GoNeighborhoodHash::MAX_RADIUS; ++radius)
+        if (length == size_t(GoNeighborhoodHash::NuPoints(radius)))
+            return radius;
+    return -1;
+}
+
+/** Index of a point in one of the 8 orientations of a pattern. */
+int TransformedIndex(int index, int symmetry)
+{
+    int deltaCol = GoNeighborhoodHash::DeltaCol(index);
+    int deltaRow = GoNeighborhoodHash::DeltaRow(index);
+    if (symmetry & 1)
+        deltaCol = -deltaCol;
+    if (symmetry & 2)
+        deltaRow = -deltaRow;
+    if (symmetry & 4)
+        swap(deltaCol, deltaRow);
+    return GoNeighborhoodHash::Index(deltaCol, deltaRow);
+}
+
+} // namespace
+
+//----------------------------------------------------------------------------
+
+GoUctNeighborhoodPatterns::GoUctNeighborhoodPatterns()
+{
+    for (int i = 0; i < GoNeighborhoodHash::NU_RADIUS; ++i)
+        for (int c = 0; c < 2; ++c)
+            m_radiusKey[i][c] = SgHashCode(0x4e50u + 2 * i + c);
+    Clear();
+}
+
+void GoUctNeighborhoodPatterns::Add(const string& pattern, float value)
+{
+    const int radius = Radius(pattern.size());
+    if (radius < 0)
+        throw SgException("invalid pattern length: " + pattern);
+    if (pattern[0] != '.')
+        throw SgException("point of pattern not empty: " + pattern);
+    // Hash codes of the 8 orientations with X = black and X = white
+    SgHashCode hash[8][2];
+    for (size_t i = 0; i < pattern.size(); ++i)
+    {
+        SgBoardColor c;
+        switch (pattern[i])
+        {
+        case '.':
+            continue;
+        case 'X':
+            c = SG_BLACK;
+            break;
+        case 'O':
+            c = SG_WHITE;
+            break;
+        case '#':
+            c = SG_BORDER;
+            break;
+        default:
+            throw SgException("invalid character in pattern: " + pattern);
+        }
+        for (int symmetry = 0; symmetry < 8; ++symmetry)
+        {
+            const int j = TransformedIndex(int(i), symmetry);
+            hash[symmetry][SG_BLACK].Xor(GoNeighborhoodHash::Key(j, c));
+            hash[symmetry][SG_WHITE].Xor(GoNeighborhoodHash::Key(j,
+                                         c == SG_BORDER ? c : SgOppBW(c)));
+        }
+    }
+    const int index = radius - GoNeighborhoodHash::MIN_RADIUS;
+    for (int symmetry = 0; symmetry < 8; ++symmetry)
+        for (int toPlay = SG_BLACK; toPlay <= SG_WHITE; ++toPlay)
+        {
+            hash[symmetry][toPlay].Xor(m_radiusKey[index][toPlay]);
+            Insert(hash[symmetry][toPlay], value);
+        }
+    m_hasRadius[index] = true;
+    m_patterns.push_back(make_pair(pattern, value));
+}
+
+void GoUctNeighborhoodPatterns::Clear()
+{
+    m_patterns.clear();
+    m_table.assign(16, Entry());
+    m_nuEntries = 0;
+    for (int i = 0; i < GoNeighborhoodHash::NU_RADIUS; ++i)
+        m_hasRadius[i] = false;
+}
+
+const GoUctNeighborhoodPatterns::Entry*
+GoUctNeighborhoodPatterns::Find(const SgHashCode& hash) const
+{
+    const size_t mask = m_table.size() - 1;
+    for (size_t i = hash.Code1() & mask; ; i = (i + 1) & mask)
+    {
+        const Entry& entry = m_table[i];
+        if (entry.m_hash == hash)
+            return &entry;
+        if (entry.m_hash.IsZero())
+            return 0;
+    }
+}
+
+void GoUctNeighborhoodPatterns::Insert(const SgHashCode& hash, float value)
+{
+    SG_ASSERT(! hash.IsZero());
+    if (2 * (m_nuEntries + 1) > m_table.size())
+    {
+        vector<Entry> old;
+        old.swap(m_table);
+        m_table.assign(2 * old.size(), Entry());
+        m_nuEntries = 0;
+        for (vector<Entry>::const_iterator it = old.begin();
+             it != old.end(); ++it)
+            if (! it->m_hash.IsZero())
+                Insert(it->m_hash, it->m_value);
+    }
+    const size_t mask = m_table.size() - 1;
+    size_t i = hash.Code1() & mask;
+    for ( ; ! m_table[i].m_hash.IsZero(); i = (i + 1) & mask)
+        if (m_table[i].m_hash == hash)
+        {
+            m_table[i].m_value = value;
+            return;
+        }
+    m_table[i].m_hash = hash;
+    m_table[i].m_value = value;
+    ++m_nuEntries;
+}
+
+//----------------------------------------------------------------------------
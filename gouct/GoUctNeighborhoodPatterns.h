@@ -0,0 +1,129 @@
+//----------------------------------------------------------------------------
+/** @file GoUctNeighborhoodPatterns.h
+    Hash table of large patterns for the prior knowledge. */
+//----------------------------------------------------------------------------
+
+#ifndef GOUCT_NEIGHBORHOODPATTERNS_H
+#define GOUCT_NEIGHBORHOODPATTERNS_H
+
+#include <string>
+#include <utility>
+#include <vector>
+#include "GoNeighborhoodHash.h"
+#include "SgHash.h"
+
+//----------------------------------------------------------------------------
+
+/** Values of patterns of the neighborhoods of moves, looked up by
+    GoNeighborhoodHash hash codes.
+    A pattern is a string with one character per point of a neighborhood of
+    radius 2, 3 or 4 (13, 25 or 41 characters) in the order of
+    GoNeighborhoodHash::Index(): by distance, then by row offset, then by
+    column offset, both ascending (rows are numbered from bottom to top as
+    in GTP coordinates). The characters are @c . (empty), @c X (color to
+    play), @c O (opponent) and @c # (off-board). The first character is the
+    point of the move and must be empty.
+
+    A pattern matches in all 8 orientations and with both colors to play.
+    The value of a move is the value of the largest matching pattern, or
+    zero. Uses the incremental hash codes of the board, if enabled with
+    GoBoard::SetNeighborhoodHash(), and computes them otherwise.
+
+    The patterns are stored in an open addressing hash table, so that a
+    lookup costs one hash code comparison in most cases. */
+class GoUctNeighborhoodPatterns
+{
+public:
+    GoUctNeighborhoodPatterns();
+
+    /** Add a pattern.
+        If a pattern matches the same neighborhoods as an earlier pattern
+        (e.g. it is a rotation of it), its value replaces the earlier
+        value.
+        @throws SgException if the pattern is invalid */
+    void Add(const std::string& pattern, float value);
+
+    void Clear();
+
+    bool IsEmpty() const;
+
+    /** The patterns in the order they were added. */
+    const std::vector<std::pair<std::string,float> >& Patterns() const;
+
+    /** The value of the largest pattern matching the neighborhood of a
+        move.
+        @tparam BOARD GoBoard or GoUctBoard
+        @param bd The board
+        @param p An empty point
+        @return The value or 0, if no pattern matches */
+    template<class BOARD>
+    float Value(const BOARD& bd, SgPoint p) const;
+
+private:
+    struct Entry
+    {
+        /** The hash code, including the radius and color to play, see
+            m_radiusKey; zero for unused entries */
+        SgHashCode m_hash;
+
+        float m_value;
+    };
+
+    std::vector<std::pair<std::string,float> > m_patterns;
+
+    /** Size is a power of two, at most half of the entries are used. */
+    std::vector<Entry> m_table;
+
+    std::size_t m_nuEntries;
+
+    /** Is there a pattern of radius MIN_RADIUS + index? */
+    bool m_hasRadius[GoNeighborhoodHash::NU_RADIUS];
+
+    /** Distinguishes the radius and color to play in the hash codes of
+        the table. Needed, because empty points do not change the hash code
+        of a neighborhood. Indexed by radius - MIN_RADIUS and color to
+        play. */
+    SgHashCode m_radiusKey[GoNeighborhoodHash::NU_RADIUS][2];
+
+    const Entry* Find(const SgHashCode& hash) const;
+
+    void Insert(const SgHashCode& hash, float value);
+};
+
+inline bool GoUctNeighborhoodPatterns::IsEmpty() const
+{
+    return m_patterns.empty();
+}
+
+inline const std::vector<std::pair<std::string,float> >&
+GoUctNeighborhoodPatterns::Patterns() const
+{
+    return m_patterns;
+}
+
+template<class BOARD>
+float GoUctNeighborhoodPatterns::Value(const BOARD& bd, SgPoint p) const
+{
+    SG_ASSERT(bd.IsEmpty(p));
+    if (IsEmpty())
+        return 0;
+    const GoNeighborhoodHash* hash = bd.NeighborhoodHash();
+    for (int radius = GoNeighborhoodHash::MAX_RADIUS;
+         radius >= GoNeighborhoodHash::MIN_RADIUS; --radius)
+    {
+        const int index = radius - GoNeighborhoodHash::MIN_RADIUS;
+        if (! m_hasRadius[index])
+            continue;
+        SgHashCode code = (hash != 0 ? hash->Get(p, radius)
+                           : GoNeighborhoodHash::Compute(bd, p, radius));
+        code.Xor(m_radiusKey[index][bd.ToPlay()]);
+        const Entry* entry = Find(code);
+        if (entry != 0)
+            return entry->m_value;
+    }
+    return 0;
+}
+
+//----------------------------------------------------------------------------
+
+#endif // GOUCT_NEIGHBORHOODPATTERNS_H
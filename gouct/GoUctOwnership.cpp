@@ -0,0 +1,73 @@
+//----------------------------------------------------------------------------
+/** @file GoUctOwnership.cpp
+    See GoUctOwnership.h */
+//----------------------------------------------------------------------------
+
+#include "SgSystem.h"
+#include "GoUctOwnership.h"
+
+#include <algorithm>
+
+using SgPointUtil::Pt;
+
+//----------------------------------------------------------------------------
+
+GoUctOwnership::GoUctOwnership()
+{
+    Clear(SG_MAX_SIZE);
+}
+
+void GoUctOwnership::Add(const SgPointArray<SgEmptyBlackWhite>& owner)
+{
+    // The weights 2 (SG_BLACK = 0), 0 (SG_WHITE = 1) and 1 (SG_EMPTY = 2)
+    // are the 2-bit fields of 0x12
+    const SgEmptyBlackWhite* color = &owner[0];
+    unsigned int* sum = &m_sum[0];
+    for (int p = m_begin; p < m_end; ++p)
+        sum[p] += (0x12u >> (2 * color[p])) & 3u;
+    ++m_count;
+}
+
+void GoUctOwnership::Clear(int boardSize)
+{
+    SG_ASSERTRANGE(boardSize, SG_MIN_SIZE, SG_MAX_SIZE);
+    m_boardSize = boardSize;
+    m_begin = Pt(1, 1);
+    m_end = Pt(boardSize, boardSize) + 1;
+    m_count = 0;
+    m_sum.Fill(0);
+}
+
+void GoUctOwnership::GetStatistics(const GoBoard& bd,
+                             SgPointArray<SgUctStatistics>& statistics) const
+{
+    SG_ASSERT(bd.Size() == m_boardSize);
+    for (GoBoard::Iterator it(bd); it; ++it)
+        if (m_count == 0)
+            statistics[*it].Clear();
+        else
+            statistics[*it].Initialize(Mean(*it), SgUctValue(m_count));
+}
+
+SgUctValue GoUctOwnership::Mean(SgPoint p) const
+{
+    SG_ASSERT(m_count > 0);
+    // The counter of the point can include more terminal positions than
+    // m_count, if it was merged during a search
+    return std::min(SgUctValue(m_sum[p]) / SgUctValue(2 * m_count),
+                    SgUctValue(1));
+}
+
+void GoUctOwnership::Merge(const GoUctOwnership& ownership)
+{
+    if (ownership.m_boardSize != m_boardSize)
+        return;
+    // Read the count first, so that the counters of the points are not
+    // from earlier terminal positions
+    const std::size_t count = ownership.m_count;
+    for (int p = m_begin; p < m_end; ++p)
+        m_sum[p] += ownership.m_sum[p];
+    m_count += count;
+}
+
+//----------------------------------------------------------------------------
@@ -0,0 +1,89 @@
+//----------------------------------------------------------------------------
+/** @file GoUctOwnership.h
+    Compact accumulator for the owners of points in terminal positions. */
+//----------------------------------------------------------------------------
+
+#ifndef GOUCT_OWNERSHIP_H
+#define GOUCT_OWNERSHIP_H
+
+#include <cstddef>
+#include "GoBoard.h"
+#include "SgBoardColor.h"
+#include "SgPointArray.h"
+#include "SgUctValue.h"
+
+//----------------------------------------------------------------------------
+
+/** Counts how often the points belonged to Black in the terminal positions
+    of the playouts of a search thread.
+    Used for the territory statistics of GoUctGlobalSearch. Stores an
+    integer per point (2 for Black, 1 for neutral, 0 for White) instead of
+    an SgUctStatistics, so that Add() is one pass over the points without
+    branches or divisions, which the compiler can vectorize.
+
+    The counters are written only by the thread that owns the accumulator.
+    Other threads can read them with Merge() during a search without
+    locking, in the same way as the nodes of SgUctTree in the lock-free mode
+    (see @ref sguctsearchlockfree). The values can then be inconsistent by
+    a few playouts, but they are exact after the search. */
+class GoUctOwnership
+{
+public:
+    GoUctOwnership();
+
+    /** Clear the counters.
+        @param boardSize Size of the board of the terminal positions */
+    void Clear(int boardSize);
+
+    /** Add the owners of the points of a terminal position.
+        @param owner SG_BLACK, SG_WHITE or SG_EMPTY for the points of the
+        board. The update does not skip the points off the board between
+        the first and last point of the board, so their values must be
+        initialized with any SgBoardColor; their counters are not used. */
+    void Add(const SgPointArray<SgEmptyBlackWhite>& owner);
+
+    /** Add the counters of another accumulator.
+        Can be called while the thread of the other accumulator is still
+        adding terminal positions. Ignores accumulators for another board
+        size (e.g. of a search before the board size changed). */
+    void Merge(const GoUctOwnership& ownership);
+
+    /** Number of terminal positions. */
+    std::size_t Count() const;
+
+    /** Fraction of terminal positions in which a point belonged to Black.
+        Neutral points count as one half.
+        @param p A point with Count() > 0 */
+    SgUctValue Mean(SgPoint p) const;
+
+    /** Convert into the statistics format used by GoUctUtil and the
+        commands.
+        The statistics of all points of the board are cleared if Count() is
+        zero. */
+    void GetStatistics(const GoBoard& bd,
+                       SgPointArray<SgUctStatistics>& statistics) const;
+
+private:
+    int m_boardSize;
+
+    /** Range of points updated by Add(): the first and one after the last
+        point of the board. */
+    SgPoint m_begin;
+
+    SgPoint m_end;
+
+    std::size_t m_count;
+
+    /** Twice the number of terminal positions in which the point belonged
+        to Black plus the number of positions in which it was neutral. */
+    SgPointArray<unsigned int> m_sum;
+};
+
+inline std::size_t GoUctOwnership::Count() const
+{
+    return m_count;
+}
+
+//----------------------------------------------------------------------------
+
+#endif // GOUCT_OWNERSHIP_H
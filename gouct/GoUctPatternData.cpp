@@ -0,0 +1,110 @@
+//----------------------------------------------------------------------------
+/** @file GoUctPatternData.cpp
+    See GoUctPatternData.h */
+//----------------------------------------------------------------------------
+
+#include "SgSystem.h"
+#include "GoUctPatternData.h"
+
+#include <string>
+#include "GoUctGlobalPatternData.h"
+#include "GoUctLocalPatternData.h"
+#include "GoUctPatternFile.h"
+#include "SgDebug.h"
+
+using std::string;
+using GoUctPatternData::BWTable;
+using GoUctPatternData::PatternData;
+using GoUctPatternData::PatternTable;
+
+//----------------------------------------------------------------------------
+
+namespace {
+
+/** Name of the section of a table in the pattern file.
+    @param set "local" or "global"
+    @param table "edge" or "center"
+    @param c The color of the table */
+string SectionName(const string& set, const string& table, SgBlackWhite c)
+{
+    return set + '/' + table + '/' + (c == SG_BLACK ? "black" : "white");
+}
+
+void AddTables(GoUctPatternFileWriter& writer, const string& set,
+               const string& table, const BWTable& bwTable)
+{
+    for (SgBWIterator it; it; ++it)
+        writer.AddPatternEntries(SectionName(set, table, *it),
+                                 bwTable[*it].m_patternArray,
+                                 bwTable[*it].m_nuPatterns);
+}
+
+bool FindTables(const GoUctPatternFile& file, const string& set,
+                const string& table, BWTable& bwTable)
+{
+    for (SgBWIterator it; it; ++it)
+    {
+        std::size_t nuElements;
+        const GoUctPatternData::PatternTableEntry* entries =
+            file.FindPatternEntries(SectionName(set, table, *it),
+                                    nuElements);
+        if (entries == 0)
+            return false;
+        PatternTable patternTable = { static_cast<int>(nuElements),
+                                      entries };
+        bwTable[*it] = patternTable;
+    }
+    return true;
+}
+
+/** Pattern data from the loaded pattern file or the compiled-in data, if
+    no pattern file is loaded or it does not contain the tables. */
+PatternData CreatePatterns(const string& set, const PatternData& builtin)
+{
+    const GoUctPatternFile* file = GoUctPatternFile::Loaded();
+    if (file == 0)
+        return builtin;
+    PatternData data = builtin;
+    if (  ! FindTables(*file, set, "edge", data.m_edgePatterns)
+       || ! FindTables(*file, set, "center", data.m_centerPatterns)
+       )
+    {
+        SgWarning() << "Pattern file '" << file->FileName()
+                    << "' has no " << set << " patterns, using compiled-in"
+                    " patterns\n";
+        return builtin;
+    }
+    return data;
+}
+
+} // namespace
+
+//----------------------------------------------------------------------------
+
+void GoUctPatternData::AddToPatternFile(GoUctPatternFileWriter& writer)
+{
+    AddTables(writer, "local", "edge",
+              GoUctLocalPatternData::gData.m_edgePatterns);
+    AddTables(writer, "local", "center",
+              GoUctLocalPatternData::gData.m_centerPatterns);
+    AddTables(writer, "global", "edge",
+              GoUctGlobalPatternData::gData.m_edgePatterns);
+    AddTables(writer, "global", "center",
+              GoUctGlobalPatternData::gData.m_centerPatterns);
+}
+
+const PatternData& GoUctPatternData::GlobalPatterns()
+{
+    static const PatternData data =
+        CreatePatterns("global", GoUctGlobalPatternData::gData);
+    return data;
+}
+
+const PatternData& GoUctPatternData::LocalPatterns()
+{
+    static const PatternData data =
+        CreatePatterns("local", GoUctLocalPatternData::gData);
+    return data;
+}
+
+//----------------------------------------------------------------------------
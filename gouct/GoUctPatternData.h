@@ -9,6 +9,8 @@
 
 #include "SgBWArray.h"
 
+class GoUctPatternFileWriter;
+
 namespace GoUctPatternData {
 
 typedef struct
@@ -31,6 +33,19 @@ typedef struct
 	BWTable m_centerPatterns;
 } PatternData;
 
+/** Pattern data for GoUctPatterns::PATTERN_LOCAL.
+    Uses the tables of the pattern file loaded with GoUctPatternFile::Load()
+    before the first call, if the file contains them, and the compiled-in
+    data otherwise. */
+const PatternData& LocalPatterns();
+
+/** Pattern data for GoUctPatterns::PATTERN_GLOBAL.
+    @see LocalPatterns() */
+const PatternData& GlobalPatterns();
+
+/** Add the compiled-in tables to a pattern file. */
+void AddToPatternFile(GoUctPatternFileWriter& writer);
+
 } // namespace GoUctPatternData
 
 #endif // GOUCT_PATTERNDATA_H
@@ -0,0 +1,276 @@
+//----------------------------------------------------------------------------
+/** @file GoUctPatternFile.cpp
+    See GoUctPatternFile.h */
+//----------------------------------------------------------------------------
+
+#include "SgSystem.h"
+#include "GoUctPatternFile.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <boost/format.hpp>
+#include <boost/interprocess/exceptions.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/static_assert.hpp>
+#include "SgException.h"
+
+using boost::format;
+using boost::interprocess::file_mapping;
+using boost::interprocess::mapped_region;
+using boost::interprocess::read_only;
+using GoUctPatternData::PatternTableEntry;
+
+//----------------------------------------------------------------------------
+
+namespace {
+
+const char MAGIC[8] = { 'F', 'U', 'E', 'G', 'O', 'P', 'A', 'T' };
+
+const uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+const std::size_t MAX_NAME_LENGTH = 32;
+
+/** Alignment of the section data in the file. */
+const std::size_t ALIGNMENT = 16;
+
+struct FileHeader
+{
+    char m_magic[8];
+
+    uint32_t m_version;
+
+    uint32_t m_byteOrder;
+
+    uint32_t m_nuSections;
+
+    uint32_t m_reserved;
+};
+
+struct SectionHeader
+{
+    char m_name[MAX_NAME_LENGTH];
+
+    uint32_t m_type;
+
+    uint32_t m_elementSize;
+
+    uint64_t m_nuElements;
+
+    uint64_t m_offset;
+};
+
+BOOST_STATIC_ASSERT(sizeof(FileHeader) == 24);
+BOOST_STATIC_ASSERT(sizeof(SectionHeader) == 56);
+BOOST_STATIC_ASSERT(sizeof(PatternTableEntry) == 8);
+
+std::size_t ElementSize(GoUctPatternFile::ElementType type)
+{
+    switch (type)
+    {
+    case GoUctPatternFile::ELEMENT_UINT16:
+        return sizeof(uint16_t);
+    case GoUctPatternFile::ELEMENT_PATTERN_ENTRY:
+        return sizeof(PatternTableEntry);
+    }
+    return 0;
+}
+
+/** The file loaded with GoUctPatternFile::Load() */
+boost::scoped_ptr<GoUctPatternFile> g_loaded;
+
+} // namespace
+
+//----------------------------------------------------------------------------
+
+const uint32_t GoUctPatternFile::FORMAT_VERSION;
+
+GoUctPatternFile::GoUctPatternFile(const std::string& fileName)
+    : m_fileName(fileName)
+{
+    try
+    {
+        file_mapping mapping(fileName.c_str(), read_only);
+        m_region.reset(new mapped_region(mapping, read_only));
+    }
+    catch (const boost::interprocess::interprocess_exception& e)
+    {
+        throw SgException(format("Could not map pattern file '%1%': %2%")
+                          % fileName % e.what());
+    }
+    const char* data = static_cast<const char*>(m_region->get_address());
+    const std::size_t size = m_region->get_size();
+    const FileHeader* header = reinterpret_cast<const FileHeader*>(data);
+    if (  size < sizeof(FileHeader)
+       || std::memcmp(header->m_magic, MAGIC, sizeof(MAGIC)) != 0
+       )
+        throw SgException(format("'%1%' is not a pattern file") % fileName);
+    if (header->m_byteOrder != BYTE_ORDER_MARK)
+        throw SgException(format("Pattern file '%1%' has wrong byte order")
+                          % fileName);
+    if (header->m_version != FORMAT_VERSION)
+        throw SgException(format("Pattern file '%1%' has version %2% "
+                                 "(expected %3%)")
+                          % fileName % header->m_version % FORMAT_VERSION);
+    const std::size_t nuSections = header->m_nuSections;
+    if (sizeof(FileHeader) + nuSections * sizeof(SectionHeader) > size)
+        throw SgException(format("Pattern file '%1%' is truncated")
+                          % fileName);
+    const SectionHeader* sectionHeader =
+        reinterpret_cast<const SectionHeader*>(data + sizeof(FileHeader));
+    for (std::size_t i = 0; i < nuSections; ++i, ++sectionHeader)
+    {
+        Section section;
+        const char* name = sectionHeader->m_name;
+        section.m_name.assign(name,
+                              std::find(name, name + MAX_NAME_LENGTH, '\0'));
+        section.m_type = static_cast<ElementType>(sectionHeader->m_type);
+        section.m_nuElements =
+            static_cast<std::size_t>(sectionHeader->m_nuElements);
+        const uint64_t offset = sectionHeader->m_offset;
+        const std::size_t elementSize = ElementSize(section.m_type);
+        if (elementSize == 0 || elementSize != sectionHeader->m_elementSize)
+            throw SgException(format("Pattern file '%1%': section '%2%' has "
+                                     "an unknown element type")
+                              % fileName % section.m_name);
+        if (  offset % ALIGNMENT != 0
+           || offset > size
+           || sectionHeader->m_nuElements > (size - offset) / elementSize
+           )
+            throw SgException(format("Pattern file '%1%': section '%2%' is "
+                                     "truncated")
+                              % fileName % section.m_name);
+        section.m_data = data + offset;
+        m_sections.push_back(section);
+    }
+}
+
+GoUctPatternFile::~GoUctPatternFile()
+{ }
+
+const void* GoUctPatternFile::Find(const std::string& name, ElementType type,
+                                   std::size_t& nuElements) const
+{
+    for (std::vector<Section>::const_iterator it = m_sections.begin();
+         it != m_sections.end(); ++it)
+        if (it->m_name == name && it->m_type == type)
+        {
+            nuElements = it->m_nuElements;
+            return it->m_data;
+        }
+    nuElements = 0;
+    return 0;
+}
+
+const PatternTableEntry*
+GoUctPatternFile::FindPatternEntries(const std::string& name,
+                                     std::size_t& nuElements) const
+{
+    return static_cast<const PatternTableEntry*>(
+                          Find(name, ELEMENT_PATTERN_ENTRY, nuElements));
+}
+
+const uint16_t* GoUctPatternFile::FindUInt16(const std::string& name,
+                                             std::size_t& nuElements) const
+{
+    return static_cast<const uint16_t*>(
+                                 Find(name, ELEMENT_UINT16, nuElements));
+}
+
+void GoUctPatternFile::Load(const std::string& fileName)
+{
+    // Tables created from the data of the loaded file keep pointers to it
+    if (g_loaded)
+        throw SgException("Pattern file already loaded");
+    g_loaded.reset(new GoUctPatternFile(fileName));
+}
+
+const GoUctPatternFile* GoUctPatternFile::Loaded()
+{
+    return g_loaded.get();
+}
+
+//----------------------------------------------------------------------------
+
+void GoUctPatternFileWriter::Add(const std::string& name,
+                                 GoUctPatternFile::ElementType type,
+                                 std::size_t elementSize, const void* data,
+                                 std::size_t nuElements)
+{
+    SG_ASSERT(name.size() <= MAX_NAME_LENGTH);
+    Section section;
+    section.m_name = name;
+    section.m_type = type;
+    section.m_elementSize = elementSize;
+    section.m_nuElements = nuElements;
+    section.m_data = data;
+    m_sections.push_back(section);
+}
+
+void GoUctPatternFileWriter::AddPatternEntries(const std::string& name,
+                                               const PatternTableEntry* data,
+                                               std::size_t nuElements)
+{
+    Add(name, GoUctPatternFile::ELEMENT_PATTERN_ENTRY,
+        sizeof(PatternTableEntry), data, nuElements);
+}
+
+void GoUctPatternFileWriter::AddUInt16(const std::string& name,
+                                       const uint16_t* data,
+                                       std::size_t nuElements)
+{
+    Add(name, GoUctPatternFile::ELEMENT_UINT16, sizeof(uint16_t), data,
+        nuElements);
+}
+
+void GoUctPatternFileWriter::Write(const std::string& fileName) const
+{
+    std::ofstream out(fileName.c_str(), std::ios::binary);
+    if (! out)
+        throw SgException(format("Could not create '%1%'") % fileName);
+    FileHeader header;
+    std::memcpy(header.m_magic, MAGIC, sizeof(MAGIC));
+    header.m_version = GoUctPatternFile::FORMAT_VERSION;
+    header.m_byteOrder = BYTE_ORDER_MARK;
+    header.m_nuSections = static_cast<uint32_t>(m_sections.size());
+    header.m_reserved = 0;
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    uint64_t offset =
+        sizeof(FileHeader) + m_sections.size() * sizeof(SectionHeader);
+    std::vector<uint64_t> offsets;
+    for (std::vector<Section>::const_iterator it = m_sections.begin();
+         it != m_sections.end(); ++it)
+    {
+        offset = (offset + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+        offsets.push_back(offset);
+        SectionHeader sectionHeader;
+        std::memset(&sectionHeader, 0, sizeof(sectionHeader));
+        std::memcpy(sectionHeader.m_name, it->m_name.c_str(),
+                    it->m_name.size());
+        sectionHeader.m_type = it->m_type;
+        sectionHeader.m_elementSize = static_cast<uint32_t>(it->m_elementSize);
+        sectionHeader.m_nuElements = it->m_nuElements;
+        sectionHeader.m_offset = offset;
+        out.write(reinterpret_cast<const char*>(&sectionHeader),
+                  sizeof(sectionHeader));
+        offset += it->m_nuElements * it->m_elementSize;
+    }
+    uint64_t pos =
+        sizeof(FileHeader) + m_sections.size() * sizeof(SectionHeader);
+    for (std::size_t i = 0; i < m_sections.size(); ++i)
+    {
+        const Section& section = m_sections[i];
+        for ( ; pos < offsets[i]; ++pos)
+            out.put('\0');
+        const std::size_t nuBytes =
+            section.m_nuElements * section.m_elementSize;
+        out.write(static_cast<const char*>(section.m_data), nuBytes);
+        pos += nuBytes;
+    }
+    out.close();
+    if (! out)
+        throw SgException(format("Error writing '%1%'") % fileName);
+}
+
+//----------------------------------------------------------------------------
@@ -0,0 +1,176 @@
+//----------------------------------------------------------------------------
+/** @file GoUctPatternFile.h
+    Binary file format for the pattern tables. */
+//----------------------------------------------------------------------------
+
+#ifndef GOUCT_PATTERNFILE_H
+#define GOUCT_PATTERNFILE_H
+
+#include <string>
+#include <vector>
+#include <stdint.h>
+#include <boost/scoped_ptr.hpp>
+#include "GoUctPatternData.h"
+
+namespace boost {
+namespace interprocess {
+    class mapped_region;
+}
+}
+
+//----------------------------------------------------------------------------
+
+/** Read-only, memory-mapped file with pattern tables.
+    The pattern tables (the gamma values of GoUctPatterns and the predictor
+    tables of GoUctAdditiveKnowledgeGreenpeep) are compiled into the
+    programs. Copying them into the tables used at runtime costs startup
+    time and private memory in every process. A pattern file contains the
+    tables in the format used at runtime. The file is mapped into memory
+    read-only, so that only the used pages are read and the pages are
+    shared by all processes using the same file.
+
+    Format (native byte order and alignment; the file is only valid on
+    platforms with the same byte order as the platform that wrote it):
+    - header: magic "FUEGOPAT" (8 bytes), uint32 format version,
+      uint32 byte order mark 0x01020304, uint32 number of sections,
+      uint32 reserved (0)
+    - section directory: for each section a char[32] name (zero-padded),
+      uint32 element type, uint32 element size, uint64 number of
+      elements, uint64 offset of the data from the start of the file
+    - section data, each aligned to 16 bytes
+
+    Files are written with GoUctPatternFileWriter, see the program
+    fuego_patterns in directory fuegopatterns. */
+class GoUctPatternFile
+{
+public:
+    /** Version of the file format. */
+    static const uint32_t FORMAT_VERSION = 1;
+
+    /** Type of the elements of a section. */
+    enum ElementType
+    {
+        /** uint16_t */
+        ELEMENT_UINT16 = 1,
+
+        /** GoUctPatternData::PatternTableEntry */
+        ELEMENT_PATTERN_ENTRY = 2
+    };
+
+    /** Map a file into memory.
+        @throws SgException if the file cannot be mapped or has an invalid
+        header. */
+    explicit GoUctPatternFile(const std::string& fileName);
+
+    ~GoUctPatternFile();
+
+    const std::string& FileName() const;
+
+    /** Find a section with elements of type uint16_t.
+        @param name The name of the section
+        @param[out] nuElements The number of elements
+        @return The elements or 0, if no section with this name and element
+        type exists */
+    const uint16_t* FindUInt16(const std::string& name,
+                               std::size_t& nuElements) const;
+
+    /** Find a section with elements of type
+        GoUctPatternData::PatternTableEntry.
+        @see FindUInt16() */
+    const GoUctPatternData::PatternTableEntry*
+    FindPatternEntries(const std::string& name,
+                       std::size_t& nuElements) const;
+
+    /** @name Pattern file of the program */
+    // @{
+
+    /** Load the pattern file used by the pattern tables.
+        Should be called at program start before any pattern tables are
+        created. Tables created afterwards use the data of the file (if
+        the file contains it) instead of the compiled-in data.
+        @throws SgException if the file cannot be loaded */
+    static void Load(const std::string& fileName);
+
+    /** The file loaded with Load() or 0, if none was loaded. */
+    static const GoUctPatternFile* Loaded();
+
+    // @} // @name
+
+private:
+    struct Section
+    {
+        std::string m_name;
+
+        ElementType m_type;
+
+        std::size_t m_nuElements;
+
+        const void* m_data;
+    };
+
+    std::string m_fileName;
+
+    boost::scoped_ptr<boost::interprocess::mapped_region> m_region;
+
+    std::vector<Section> m_sections;
+
+    const void* Find(const std::string& name, ElementType type,
+                     std::size_t& nuElements) const;
+
+    /** Not implemented */
+    GoUctPatternFile(const GoUctPatternFile&);
+
+    /** Not implemented */
+    GoUctPatternFile& operator=(const GoUctPatternFile&);
+};
+
+inline const std::string& GoUctPatternFile::FileName() const
+{
+    return m_fileName;
+}
+
+//----------------------------------------------------------------------------
+
+/** Writes a file in the format of GoUctPatternFile. */
+class GoUctPatternFileWriter
+{
+public:
+    /** Add a section.
+        The data is not copied and must exist until Write() is called. */
+    void AddUInt16(const std::string& name, const uint16_t* data,
+                   std::size_t nuElements);
+
+    /** Add a section.
+        @see AddUInt16() */
+    void AddPatternEntries(const std::string& name,
+                           const GoUctPatternData::PatternTableEntry* data,
+                           std::size_t nuElements);
+
+    /** Write the file.
+        @throws SgException if the file cannot be written */
+    void Write(const std::string& fileName) const;
+
+private:
+    struct Section
+    {
+        std::string m_name;
+
+        GoUctPatternFile::ElementType m_type;
+
+        std::size_t m_elementSize;
+
+        std::size_t m_nuElements;
+
+        const void* m_data;
+    };
+
+    std::vector<Section> m_sections;
+
+    void Add(const std::string& name, GoUctPatternFile::ElementType type,
+             std::size_t elementSize, const void* data,
+             std::size_t nuElements);
+};
+
+//----------------------------------------------------------------------------
+
+#endif // GOUCT_PATTERNFILE_H
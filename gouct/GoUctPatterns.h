@@ -7,8 +7,6 @@
 
 #include "GoBoard.h"
 #include "GoBoardUtil.h"
-#include "GoUctGlobalPatternData.h"
-#include "GoUctLocalPatternData.h"
 #include "GoUctPatternData.h"
 #include "SgBoardColor.h"
 #include "SgBWArray.h"
@@ -728,8 +726,8 @@ void GoUctPatterns<BOARD>
     m_edgeTable[SG_WHITE].Fill(PatternInfo());
 
     const GoUctPatternData::PatternData& pt = patternType == PATTERN_LOCAL ?
-                                              GoUctLocalPatternData::gData :
-                                              GoUctGlobalPatternData::gData;
+                                          GoUctPatternData::LocalPatterns() :
+                                          GoUctPatternData::GlobalPatterns();
     SetGammaValues(pt.m_edgePatterns, m_edgeTable);
     SetGammaValues(pt.m_centerPatterns, m_table);
 }
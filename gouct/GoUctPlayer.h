@@ -91,6 +91,10 @@ public:
 
     void OnBoardChange();
 
+    void OnPlay(GoPlayerMove move);
+
+    void PreUndo();
+
     // @} // @name
 
 
@@ -482,6 +486,8 @@ inline void GoUctPlayer<SEARCH, THREAD>::SetRootFilter(GoUctMoveFilter*
                                                        filter)
 {
     m_rootFilter.reset(filter);
+    if (filter != 0)
+        filter->OnBoardChange();
 }
 
 template <class SEARCH, class THREAD>
@@ -572,6 +578,7 @@ GoUctPlayer<SEARCH, THREAD>::GoUctPlayer(const GoBoard& bd)
     SetDefaultParameters(Board().Size());
     m_search.SetMpiSynchronizer(m_mpiSynchronizer);
     m_treeFilterParam.SetCheckSafety(false);
+    m_rootFilter->OnBoardChange();
 }
 
 template <class SEARCH, class THREAD>
@@ -701,8 +708,8 @@ bool GoUctPlayer<SEARCH, THREAD>::DoEarlyPassSearch(SgUctValue maxGames,
         earlyPassPossible = false;
     }
     move = SG_PASS;
-    THREAD& threadState = dynamic_cast<THREAD&>(m_search.ThreadState(0));
-    const TerrArray territory = threadState.m_territoryStatistics;
+    TerrArray territory;
+    m_search.GetTerritoryStatistics(territory);
     if (earlyPassPossible && ! HasStatsForAllMoves(bd, territory))
     {
         earlyPassPossible = false;
@@ -1036,6 +1043,20 @@ void GoUctPlayer<SEARCH, THREAD>::OnBoardChange()
         m_search.SetDefaultParameters(size);
         m_lastBoardSize = size;
     }
+    m_rootFilter->OnBoardChange();
+}
+
+template <class SEARCH, class THREAD>
+void GoUctPlayer<SEARCH, THREAD>::OnPlay(GoPlayerMove move)
+{
+    SG_UNUSED(move);
+    m_rootFilter->OnPlay();
+}
+
+template <class SEARCH, class THREAD>
+void GoUctPlayer<SEARCH, THREAD>::PreUndo()
+{
+    m_rootFilter->PreUndo();
 }
 
 template <class SEARCH, class THREAD>
@@ -0,0 +1,142 @@
+//----------------------------------------------------------------------------
+/** @file GoUctPlayoutBatch.cpp
+    See GoUctPlayoutBatch.h */
+//----------------------------------------------------------------------------
+
+#include "SgSystem.h"
+#include "GoUctPlayoutBatch.h"
+
+using namespace std;
+
+//----------------------------------------------------------------------------
+
+void GoUctPlayoutBatch::Game::Clear(int stoneDiff)
+{
+    m_isRunning = true;
+    m_aborted = false;
+    m_mercyRuleTriggered = false;
+    m_nuPassMoves = 0;
+    m_stoneDiff = stoneDiff;
+    m_mercyRuleResult = 0;
+    m_sequence.clear();
+    m_skipRaveUpdate.clear();
+}
+
+//----------------------------------------------------------------------------
+
+GoUctPlayoutBatch::GoUctPlayoutBatch()
+    : m_mercyRuleThreshold(0),
+      m_nuGames(0)
+{ }
+
+GoUctPlayoutBatch::~GoUctPlayoutBatch()
+{ }
+
+/** See GoUctGlobalSearchState::CheckMercyRule() */
+bool GoUctPlayoutBatch::CheckMercyRule(Game& game,
+                                       const GoUctBoard& bd) const
+{
+    if (game.m_stoneDiff >= m_mercyRuleThreshold)
+    {
+        game.m_mercyRuleTriggered = true;
+        game.m_mercyRuleResult = (bd.ToPlay() == SG_BLACK ? 1 : 0);
+    }
+    else if (game.m_stoneDiff <= -m_mercyRuleThreshold)
+    {
+        game.m_mercyRuleTriggered = true;
+        game.m_mercyRuleResult = (bd.ToPlay() == SG_WHITE ? 1 : 0);
+    }
+    return game.m_mercyRuleTriggered;
+}
+
+void GoUctPlayoutBatch::Reserve(size_t nuGames, const GoBoard& bd)
+{
+    while (m_boards.size() < nuGames)
+    {
+        boost::shared_ptr<GoUctBoard> uctBd(new GoUctBoard(bd));
+        m_boards.push_back(uctBd);
+        AddPolicy(*uctBd);
+    }
+    if (m_games.size() < nuGames)
+        m_games.resize(nuGames);
+}
+
+void GoUctPlayoutBatch::Run(const GoBoard& start, size_t nuGames,
+                            size_t maxLength)
+{
+    m_start.assign(nuGames, &start);
+    Run(m_start, maxLength);
+}
+
+void GoUctPlayoutBatch::Run(const vector<const GoBoard*>& start,
+                            size_t maxLength)
+{
+    m_nuGames = start.size();
+    if (m_nuGames == 0)
+        return;
+    Reserve(m_nuGames, *start[0]);
+    for (size_t i = 0; i < m_nuGames; ++i)
+    {
+        const GoBoard& bd = *start[i];
+        m_boards[i]->Init(bd);
+        m_games[i].Clear(bd.All(SG_BLACK).Size() - bd.All(SG_WHITE).Size());
+        StartPlayout(i);
+    }
+    size_t nuRunning = m_nuGames;
+    while (nuRunning > 0)
+    {
+        for (size_t i = 0; i < m_nuGames; ++i)
+        {
+            Game& game = m_games[i];
+            if (! game.m_isRunning)
+                continue;
+            GoUctBoard& bd = *m_boards[i];
+            // Same order of checks as in SgUctSearch::PlayoutGame() and
+            // GoUctGlobalSearchState::GeneratePlayoutMove()
+            bool isFinished = false;
+            if (game.m_sequence.size() == maxLength)
+            {
+                game.m_aborted = true;
+                isFinished = true;
+            }
+            else if (m_mercyRuleThreshold > 0 && CheckMercyRule(game, bd))
+                isFinished = true;
+            else
+            {
+                SgPoint move = GenerateMove(i);
+                SG_ASSERT(move != SG_NULLMOVE);
+                bool skipRaveUpdate = false;
+                if (move == SG_PASS)
+                {
+                    skipRaveUpdate = true;
+                    if (game.m_nuPassMoves < 2)
+                        ++game.m_nuPassMoves;
+                    else
+                        isFinished = true;
+                }
+                else
+                    game.m_nuPassMoves = 0;
+                if (! isFinished)
+                {
+                    SG_ASSERT(move == SG_PASS || ! bd.Occupied(move));
+                    bd.Play(move);
+                    if (bd.ToPlay() == SG_BLACK)
+                        game.m_stoneDiff -= bd.NuCapturedStones();
+                    else
+                        game.m_stoneDiff += bd.NuCapturedStones();
+                    OnPlay(i);
+                    game.m_sequence.push_back(move);
+                    game.m_skipRaveUpdate.push_back(skipRaveUpdate);
+                }
+            }
+            if (isFinished)
+            {
+                game.m_isRunning = false;
+                EndPlayout(i);
+                --nuRunning;
+            }
+        }
+    }
+}
+
+//----------------------------------------------------------------------------
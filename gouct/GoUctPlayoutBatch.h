@@ -0,0 +1,299 @@
+//----------------------------------------------------------------------------
+/** @file GoUctPlayoutBatch.h
+    Playouts on several independent games advanced in lockstep. */
+//----------------------------------------------------------------------------
+
+#ifndef GOUCT_PLAYOUTBATCH_H
+#define GOUCT_PLAYOUTBATCH_H
+
+#include <vector>
+#include <boost/shared_ptr.hpp>
+#include "GoBoard.h"
+#include "GoUctBoard.h"
+#include "SgMove.h"
+#include "SgUctValue.h"
+
+//----------------------------------------------------------------------------
+
+/** Plays several independent playouts in an interleaved loop.
+    Each game has its own GoUctBoard. In every round of the loop, each game
+    that is not finished yet generates and plays one move. Since the games
+    are independent, the memory accesses of one game can overlap with the
+    computations of the others, which hides some of the cache latency of a
+    single branchy playout.
+
+    The termination rules are the same as in
+    GoUctGlobalSearchState::GeneratePlayoutMove(): a game ends after the
+    third pass in a row or if the mercy rule is triggered, and it is aborted
+    if it exceeds the maximum length.
+
+    Subclasses provide the playout policy for each game, see
+    GoUctPolicyPlayoutBatch. */
+class GoUctPlayoutBatch
+{
+public:
+    GoUctPlayoutBatch();
+
+    virtual ~GoUctPlayoutBatch();
+
+    /** Run playouts from several start positions to completion.
+        @param start The start positions. All must have the same size.
+        @param maxLength Maximum number of moves in a playout. Longer games
+        are aborted. */
+    void Run(const std::vector<const GoBoard*>& start, std::size_t maxLength);
+
+    /** Run several playouts from the same start position.
+        @see Run(const std::vector<const GoBoard*>&, std::size_t) */
+    void Run(const GoBoard& start, std::size_t nuGames,
+             std::size_t maxLength);
+
+    /** Number of games of the last Run(). */
+    std::size_t NuGames() const;
+
+    /** The final position of game @c i. */
+    const GoUctBoard& Board(std::size_t i) const;
+
+    /** The moves played in game @c i. */
+    const std::vector<SgMove>& Sequence(std::size_t i) const;
+
+    /** Flags for excluding moves of game @c i from RAVE updates.
+        Set for pass moves. */
+    const std::vector<bool>& SkipRaveUpdate(std::size_t i) const;
+
+    /** Was game @c i aborted because it exceeded the maximum length? */
+    bool Aborted(std::size_t i) const;
+
+    /** Number of pass moves in a row at the end of game @c i. */
+    int NuPassMoves(std::size_t i) const;
+
+    /** Was game @c i ended by the mercy rule? */
+    bool MercyRuleTriggered(std::size_t i) const;
+
+    /** Result of game @c i if ended by the mercy rule.
+        1 if the player to move at the end of the game wins, 0 otherwise. */
+    SgUctValue MercyRuleResult(std::size_t i) const;
+
+    /** Make sure there are at least @c nuGames game slots.
+        Creates the boards and policies of missing slots. Run() calls this
+        function automatically, but creating policies is not thread-safe in
+        general (e.g. because of the registration of SgRandom instances), so
+        multi-threaded users should call it before the threads are running.
+        @param nuGames The number of game slots
+        @param bd A board with the size of the games */
+    void Reserve(std::size_t nuGames, const GoBoard& bd);
+
+    /** Threshold for the stone difference of the mercy rule.
+        Zero disables the mercy rule (the default).
+        @see GoUctGlobalSearchStateParam::m_mercyRule */
+    void SetMercyRuleThreshold(int threshold);
+
+protected:
+    /** Create the playout policy for a new game.
+        Called once for each new game slot. The policy must generate moves
+        for the board @c bd. The policies of different slots should use
+        different random number streams, since all games of a batch can
+        start in the same position. */
+    virtual void AddPolicy(const GoUctBoard& bd) = 0;
+
+    /** See GoUctPlayoutPolicy::StartPlayout() */
+    virtual void StartPlayout(std::size_t i) = 0;
+
+    /** See GoUctPlayoutPolicy::GenerateMove() */
+    virtual SgPoint GenerateMove(std::size_t i) = 0;
+
+    /** See GoUctPlayoutPolicy::OnPlay() */
+    virtual void OnPlay(std::size_t i) = 0;
+
+    /** See GoUctPlayoutPolicy::EndPlayout() */
+    virtual void EndPlayout(std::size_t i) = 0;
+
+private:
+    /** State of a single game. */
+    struct Game
+    {
+        bool m_isRunning;
+
+        bool m_aborted;
+
+        bool m_mercyRuleTriggered;
+
+        int m_nuPassMoves;
+
+        /** Difference of captured stones, see
+            GoUctGlobalSearchState::m_stoneDiff. */
+        int m_stoneDiff;
+
+        SgUctValue m_mercyRuleResult;
+
+        std::vector<SgMove> m_sequence;
+
+        std::vector<bool> m_skipRaveUpdate;
+
+        void Clear(int stoneDiff);
+    };
+
+    int m_mercyRuleThreshold;
+
+    std::size_t m_nuGames;
+
+    std::vector<boost::shared_ptr<GoUctBoard> > m_boards;
+
+    std::vector<Game> m_games;
+
+    /** Local variable in Run(). Reused for efficiency. */
+    std::vector<const GoBoard*> m_start;
+
+    bool CheckMercyRule(Game& game, const GoUctBoard& bd) const;
+
+    /** Not implemented */
+    GoUctPlayoutBatch(const GoUctPlayoutBatch&);
+
+    /** Not implemented */
+    GoUctPlayoutBatch& operator=(const GoUctPlayoutBatch&);
+};
+
+inline bool GoUctPlayoutBatch::Aborted(std::size_t i) const
+{
+    SG_ASSERT(i < m_nuGames);
+    return m_games[i].m_aborted;
+}
+
+inline const GoUctBoard& GoUctPlayoutBatch::Board(std::size_t i) const
+{
+    SG_ASSERT(i < m_nuGames);
+    return *m_boards[i];
+}
+
+inline bool GoUctPlayoutBatch::MercyRuleTriggered(std::size_t i) const
+{
+    SG_ASSERT(i < m_nuGames);
+    return m_games[i].m_mercyRuleTriggered;
+}
+
+inline SgUctValue GoUctPlayoutBatch::MercyRuleResult(std::size_t i) const
+{
+    SG_ASSERT(i < m_nuGames);
+    return m_games[i].m_mercyRuleResult;
+}
+
+inline std::size_t GoUctPlayoutBatch::NuGames() const
+{
+    return m_nuGames;
+}
+
+inline int GoUctPlayoutBatch::NuPassMoves(std::size_t i) const
+{
+    SG_ASSERT(i < m_nuGames);
+    return m_games[i].m_nuPassMoves;
+}
+
+inline const std::vector<SgMove>&
+GoUctPlayoutBatch::Sequence(std::size_t i) const
+{
+    SG_ASSERT(i < m_nuGames);
+    return m_games[i].m_sequence;
+}
+
+inline void GoUctPlayoutBatch::SetMercyRuleThreshold(int threshold)
+{
+    m_mercyRuleThreshold = threshold;
+}
+
+inline const std::vector<bool>&
+GoUctPlayoutBatch::SkipRaveUpdate(std::size_t i) const
+{
+    SG_ASSERT(i < m_nuGames);
+    return m_games[i].m_skipRaveUpdate;
+}
+
+//----------------------------------------------------------------------------
+
+/** GoUctPlayoutBatch using playout policies created by a factory.
+    The policy of game slot @c i uses the sub-stream <tt>i + 1</tt> of the
+    random stream of the batch, see GoUctPlayoutPolicy::SetRandomStream().
+    @tparam POLICY The playout policy (e.g. GoUctPlayoutPolicy<GoUctBoard>)
+    @tparam FACTORY The factory for the playout policy */
+template<class POLICY, class FACTORY>
+class GoUctPolicyPlayoutBatch
+    : public GoUctPlayoutBatch
+{
+public:
+    /** Constructor.
+        @param factory Stores a reference. The lifetime of the factory must
+        exceed the lifetime of this object.
+        @param randomStream The random stream for the policies (e.g. the
+        thread ID of the search thread using the batch) */
+    GoUctPolicyPlayoutBatch(FACTORY& factory, unsigned int randomStream = 0);
+
+    /** The playout policy of game @c i. */
+    POLICY& Policy(std::size_t i);
+
+protected:
+    void AddPolicy(const GoUctBoard& bd);
+
+    void StartPlayout(std::size_t i);
+
+    SgPoint GenerateMove(std::size_t i);
+
+    void OnPlay(std::size_t i);
+
+    void EndPlayout(std::size_t i);
+
+private:
+    FACTORY& m_factory;
+
+    unsigned int m_randomStream;
+
+    std::vector<boost::shared_ptr<POLICY> > m_policies;
+};
+
+template<class POLICY, class FACTORY>
+GoUctPolicyPlayoutBatch<POLICY,FACTORY>
+::GoUctPolicyPlayoutBatch(FACTORY& factory, unsigned int randomStream)
+    : m_factory(factory),
+      m_randomStream(randomStream)
+{ }
+
+template<class POLICY, class FACTORY>
+void GoUctPolicyPlayoutBatch<POLICY,FACTORY>::AddPolicy(const GoUctBoard& bd)
+{
+    boost::shared_ptr<POLICY> policy(m_factory.Create(bd));
+    policy->SetRandomStream(m_randomStream,
+                       static_cast<unsigned int>(m_policies.size() + 1));
+    m_policies.push_back(policy);
+}
+
+template<class POLICY, class FACTORY>
+void GoUctPolicyPlayoutBatch<POLICY,FACTORY>::EndPlayout(std::size_t i)
+{
+    m_policies[i]->EndPlayout();
+}
+
+template<class POLICY, class FACTORY>
+SgPoint GoUctPolicyPlayoutBatch<POLICY,FACTORY>::GenerateMove(std::size_t i)
+{
+    return m_policies[i]->GenerateMove();
+}
+
+template<class POLICY, class FACTORY>
+void GoUctPolicyPlayoutBatch<POLICY,FACTORY>::OnPlay(std::size_t i)
+{
+    m_policies[i]->OnPlay();
+}
+
+template<class POLICY, class FACTORY>
+inline POLICY& GoUctPolicyPlayoutBatch<POLICY,FACTORY>::Policy(std::size_t i)
+{
+    SG_ASSERT(i < m_policies.size());
+    return *m_policies[i];
+}
+
+template<class POLICY, class FACTORY>
+void GoUctPolicyPlayoutBatch<POLICY,FACTORY>::StartPlayout(std::size_t i)
+{
+    m_policies[i]->StartPlayout();
+}
+
+//----------------------------------------------------------------------------
+
+#endif // GOUCT_PLAYOUTBATCH_H
@@ -18,7 +18,8 @@ GoUctPlayoutPolicyParam::GoUctPlayoutPolicyParam()
       m_fillboardTries(0),
       m_patternGammaThreshold(50.f),
       m_knowledgeType(KNOWLEDGE_GREENPEEP),
-      m_combinationType(COMBINE_MULTIPLY)
+      m_combinationType(COMBINE_MULTIPLY),
+      m_predictorWeights()
 { }
 
 //----------------------------------------------------------------------------
@@ -67,6 +68,10 @@ void GoUctPlayoutPolicyStat::Clear()
     m_nonRandLen.Clear();
     m_moveListLen.Clear();
     std::fill(m_nuMoveType.begin(), m_nuMoveType.end(), 0);
+#if GOUCT_POLICY_COST
+    std::fill(m_nuCalls.begin(), m_nuCalls.end(), 0);
+    std::fill(m_cost.begin(), m_cost.end(), 0.);
+#endif
 }
 
 void GoUctPlayoutPolicyStat::Write(std::ostream& out) const
@@ -87,6 +92,27 @@ void GoUctPlayoutPolicyStat::Write(std::ostream& out) const
         << SgWriteLabel("MoveListLen");
     m_moveListLen.Write(out);
     out << '\n';
+#if GOUCT_POLICY_COST
+    // Cost per heuristic: number of tries, nanoseconds per try, percentage
+    // of the total time of the heuristics
+    double totalCost = 0;
+    for (int i = 0; i < _GOUCT_NU_DEFAULT_PLAYOUT_TYPE; ++i)
+        totalCost += m_cost[i];
+    out << SgWriteLabel("CostPerMove")
+        << (m_nuMoves > 0 ? totalCost / double(m_nuMoves) : 0) << " ns\n"
+        << "Cost (tries, ns/try, % of time):\n";
+    for (int i = 0; i < _GOUCT_NU_DEFAULT_PLAYOUT_TYPE; ++i)
+    {
+        GoUctPlayoutPolicyType type = static_cast<GoUctPlayoutPolicyType>(i);
+        size_t n = m_nuCalls[type];
+        if (n == 0)
+            continue;
+        out << SgWriteLabel(GoUctPlayoutPolicyTypeStr(type))
+            << n << ' ' << m_cost[type] / double(n) << ' '
+            << (totalCost > 0 ? m_cost[type] * 100.0 / totalCost : 0)
+            << "%\n";
+    }
+#endif
 }
 
 //----------------------------------------------------------------------------
@@ -6,7 +6,11 @@
 #define GOUCT_PLAYOUTPOLICY_H
 
 #include <iostream>
+#include <string>
 #include <boost/array.hpp>
+#if GOUCT_POLICY_COST
+#include <chrono>
+#endif
 #include "GoBoardUtil.h"
 #include "GoEyeUtil.h"
 #include "GoUctPatterns.h"
@@ -25,7 +29,8 @@ enum KnowledgeType
     KNOWLEDGE_NONE,
     KNOWLEDGE_GREENPEEP,
     KNOWLEDGE_RULEBASED,
-    KNOWLEDGE_BOTH
+    KNOWLEDGE_BOTH,
+    KNOWLEDGE_PREDICTOR
 };
 
 /** Combination Type is used for combining multiple additive knowledge. */
@@ -40,6 +45,18 @@ enum GoUctKnowledgeCombinationType
 
 //----------------------------------------------------------------------------
 
+/** @def GOUCT_POLICY_COST
+    Enable cost accounting of the heuristics in GoUctPlayoutPolicy.
+    If set to 1 (configure option <code>--enable-policy-cost</code>), the
+    playout policy measures the time spent in each heuristic while
+    statistics are enabled (GoUctPlayoutPolicyParam::m_statisticsEnabled).
+    If set to 0 (default), the measurement code is not compiled.
+    @see GoUctPlayoutPolicyCost */
+#ifndef GOUCT_POLICY_COST
+#define GOUCT_POLICY_COST 0
+#endif
+
+//----------------------------------------------------------------------------
 
 /** Parameters for GoUctPlayoutPolicy. */
 class GoUctPlayoutPolicyParam
@@ -81,6 +98,11 @@ public:
     /** How to combine multiple additive knowledge */
     GoUctKnowledgeCombinationType m_combinationType;
 
+    /** File with the weights for KNOWLEDGE_PREDICTOR.
+        Empty for the default weights.
+        @see GoUctAdditiveKnowledgeParamPredictor */
+    std::string m_predictorWeights;
+
     GoUctPlayoutPolicyParam();
 };
 
@@ -138,6 +160,15 @@ struct GoUctPlayoutPolicyStat
     /** Number of moves of a certain type. */
     boost::array<std::size_t,_GOUCT_NU_DEFAULT_PLAYOUT_TYPE> m_nuMoveType;
 
+#if GOUCT_POLICY_COST
+    /** Number of times the heuristic of a move type was tried.
+        Includes tries that did not generate a move. */
+    boost::array<std::size_t,_GOUCT_NU_DEFAULT_PLAYOUT_TYPE> m_nuCalls;
+
+    /** Total time in nanoseconds spent in the heuristic of a move type. */
+    boost::array<double,_GOUCT_NU_DEFAULT_PLAYOUT_TYPE> m_cost;
+#endif
+
     void Clear();
 
     void Write(std::ostream& out) const;
@@ -145,6 +176,67 @@ struct GoUctPlayoutPolicyStat
 
 //----------------------------------------------------------------------------
 
+/** Measures the cost of the heuristics in one move generation of
+    GoUctPlayoutPolicy.
+    Each call of Lap() adds the time since the previous call (or since the
+    construction) to the cost of a move type in the statistics.
+    Does nothing if constructed with a null statistics pointer. If
+    GOUCT_POLICY_COST is 0, all functions are empty and are optimized away. */
+class GoUctPlayoutPolicyCost
+{
+public:
+    GoUctPlayoutPolicyCost(GoUctPlayoutPolicyStat* statistics);
+
+    void Lap(GoUctPlayoutPolicyType type);
+
+#if GOUCT_POLICY_COST
+private:
+    typedef std::chrono::steady_clock Clock;
+
+    GoUctPlayoutPolicyStat* m_statistics;
+
+    Clock::time_point m_last;
+#endif
+};
+
+#if GOUCT_POLICY_COST
+
+inline GoUctPlayoutPolicyCost::GoUctPlayoutPolicyCost(
+                                           GoUctPlayoutPolicyStat* statistics)
+    : m_statistics(statistics)
+{
+    if (m_statistics != 0)
+        m_last = Clock::now();
+}
+
+inline void GoUctPlayoutPolicyCost::Lap(GoUctPlayoutPolicyType type)
+{
+    if (m_statistics == 0)
+        return;
+    const Clock::time_point now = Clock::now();
+    ++m_statistics->m_nuCalls[type];
+    m_statistics->m_cost[type] +=
+        std::chrono::duration<double,std::nano>(now - m_last).count();
+    m_last = now;
+}
+
+#else
+
+inline GoUctPlayoutPolicyCost::GoUctPlayoutPolicyCost(
+                                           GoUctPlayoutPolicyStat* statistics)
+{
+    SG_UNUSED(statistics);
+}
+
+inline void GoUctPlayoutPolicyCost::Lap(GoUctPlayoutPolicyType type)
+{
+    SG_UNUSED(type);
+}
+
+#endif // GOUCT_POLICY_COST
+
+//----------------------------------------------------------------------------
+
 /** Default playout policy for usage in GoUctGlobalSearch.
     Parameterized by the board class to make it usable with both GoBoard
     and GoUctBoard.
@@ -187,6 +279,10 @@ public:
 
     // @} // @name
 
+    /** Select the random number stream of the policy.
+        See SgRandom::SetStream() */
+    void SetRandomStream(unsigned int stream, unsigned int subStream = 0);
+
     /** @name Statistics */
     // @{
 
@@ -541,6 +637,8 @@ bool GoUctPlayoutPolicy<BOARD>::GenerateLowLibMove(SgPoint lastMove)
 template<class BOARD>
 SG_ATTR_FLATTEN SgPoint GoUctPlayoutPolicy<BOARD>::GenerateMove()
 {
+    GoUctPlayoutPolicyCost cost(m_param.m_statisticsEnabled ?
+                                &m_statistics[m_bd.ToPlay()] : 0);
     m_moves.Clear();
     m_checked = false;
     SgPoint mv = SG_NULLMOVE;
@@ -550,6 +648,7 @@ SG_ATTR_FLATTEN SgPoint GoUctPlayoutPolicy<BOARD>::GenerateMove()
         m_moveType = GOUCT_FILLBOARD;
         mv = m_pureRandomGenerator.
              GenerateFillboardMove(m_param.m_fillboardTries);
+        cost.Lap(GOUCT_FILLBOARD);
     }
 
     m_lastMove = m_bd.GetLastMove();
@@ -559,25 +658,41 @@ SG_ATTR_FLATTEN SgPoint GoUctPlayoutPolicy<BOARD>::GenerateMove()
        && ! m_bd.IsEmpty(m_lastMove) // skip if move was suicide
        )
     {
-        if (m_param.m_useNakadeHeuristic && GenerateNakadeMove())
+        if (m_param.m_useNakadeHeuristic)
         {
-            m_moveType = GOUCT_NAKADE;
-            mv = SelectRandom();
+            if (GenerateNakadeMove())
+            {
+                m_moveType = GOUCT_NAKADE;
+                mv = SelectRandom();
+            }
+            cost.Lap(GOUCT_NAKADE);
         }
-        if (mv == SG_NULLMOVE && GenerateAtariCaptureMove())
+        if (mv == SG_NULLMOVE)
         {
-            m_moveType = GOUCT_ATARI_CAPTURE;
-            mv = SelectRandom();
+            if (GenerateAtariCaptureMove())
+            {
+                m_moveType = GOUCT_ATARI_CAPTURE;
+                mv = SelectRandom();
+            }
+            cost.Lap(GOUCT_ATARI_CAPTURE);
         }
-        if (mv == SG_NULLMOVE && GenerateAtariDefenseMove())
+        if (mv == SG_NULLMOVE)
         {
-            m_moveType = GOUCT_ATARI_DEFEND;
-            mv = SelectRandom();
+            if (GenerateAtariDefenseMove())
+            {
+                m_moveType = GOUCT_ATARI_DEFEND;
+                mv = SelectRandom();
+            }
+            cost.Lap(GOUCT_ATARI_DEFEND);
         }
-        if (mv == SG_NULLMOVE && GenerateLowLibMove(m_lastMove))
+        if (mv == SG_NULLMOVE)
         {
-            m_moveType = GOUCT_LOWLIB;
-            mv = SelectRandom();
+            if (GenerateLowLibMove(m_lastMove))
+            {
+                m_moveType = GOUCT_LOWLIB;
+                mv = SelectRandom();
+            }
+            cost.Lap(GOUCT_LOWLIB);
         }
         if (mv == SG_NULLMOVE)
         {
@@ -585,28 +700,38 @@ SG_ATTR_FLATTEN SgPoint GoUctPlayoutPolicy<BOARD>::GenerateMove()
             {
                 m_moveType = GOUCT_GAMMA_PATTERN;
                 mv = m_gammaGenerator.GenerateBiasedPatternMove();
+                cost.Lap(GOUCT_GAMMA_PATTERN);
             }
-            else if (GeneratePatternMove())
+            else
             {
-                m_moveType = GOUCT_PATTERN;
-                mv = SelectRandom();
+                if (GeneratePatternMove())
+                {
+                    m_moveType = GOUCT_PATTERN;
+                    mv = SelectRandom();
+                }
+                cost.Lap(GOUCT_PATTERN);
             }
         }
     }
 
     if (mv != SG_NULLMOVE)
+    {
         CorrectMove(GoUctUtil::DoFalseEyeToCaptureCorrection, mv,
                         GOUCT_REPLACE_CAPTURE);
+        cost.Lap(GOUCT_REPLACE_CAPTURE);
+    }
     if (mv == SG_NULLMOVE)
     {
         m_moveType = GOUCT_CAPTURE;
         m_captureGenerator.Generate(m_moves);
         mv = SelectRandom();
+        cost.Lap(GOUCT_CAPTURE);
     }
     if (mv == SG_NULLMOVE)
     {
         m_moveType = GOUCT_RANDOM;
         mv = m_pureRandomGenerator.Generate();
+        cost.Lap(GOUCT_RANDOM);
     }
     if (mv == SG_NULLMOVE)
     {
@@ -619,9 +744,13 @@ SG_ATTR_FLATTEN SgPoint GoUctPlayoutPolicy<BOARD>::GenerateMove()
         SG_ASSERT(m_bd.IsLegal(mv));
         m_checked = CorrectMove(GoUctUtil::DoSelfAtariCorrection, mv,
                                 GOUCT_SELFATARI_CORRECTION);
+        cost.Lap(GOUCT_SELFATARI_CORRECTION);
         if (USE_CLUMP_CORRECTION && ! m_checked)
+        {
             CorrectMove(GoUctUtil::DoClumpCorrection, mv,
                         GOUCT_CLUMP_CORRECTION);
+            cost.Lap(GOUCT_CLUMP_CORRECTION);
+        }
     }
     SG_ASSERT(m_bd.IsLegal(mv));
     SG_ASSERT(mv == SG_PASS || ! m_bd.IsSuicide(mv));
@@ -836,6 +965,13 @@ GoUctPlayoutPolicy<BOARD>::Statistics(SgBlackWhite color) const
     return m_statistics[color];
 }
 
+template<class BOARD>
+inline void GoUctPlayoutPolicy<BOARD>::SetRandomStream(unsigned int stream,
+                                                       unsigned int subStream)
+{
+    m_random.SetStream(stream, subStream);
+}
+
 template<class BOARD>
 void GoUctPlayoutPolicy<BOARD>::StartPlayout()
 {
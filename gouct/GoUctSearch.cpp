@@ -92,11 +92,35 @@ void GoUctState::AssertionHandler::Run()
 
 //----------------------------------------------------------------------------
 
+GoUctState::Synchronizer::Synchronizer(GoUctState& state,
+                                       const GoBoard& publisher)
+    : GoBoardSynchronizer(publisher),
+      m_state(state)
+{ }
+
+void GoUctState::Synchronizer::OnBoardChange()
+{
+    m_state.OnBoardChange();
+}
+
+void GoUctState::Synchronizer::OnPlay(GoPlayerMove move)
+{
+    SG_UNUSED(move);
+    m_state.OnPlay();
+}
+
+void GoUctState::Synchronizer::PreUndo()
+{
+    m_state.PreUndo();
+}
+
+//----------------------------------------------------------------------------
+
 GoUctState::GoUctState(unsigned int threadId, const GoBoard& bd)
     : SgUctThreadState(threadId, MOVERANGE),
       m_assertionHandler(*this),
       m_uctBd(bd),
-      m_synchronizer(bd)
+      m_synchronizer(*this, bd)
 {
     m_synchronizer.SetSubscriber(m_bd);
     m_isInPlayout = false;
@@ -115,13 +139,12 @@ void GoUctState::Execute(SgMove move)
 {
     SG_ASSERT(! m_isInPlayout);
     SG_ASSERT(move == SG_PASS || ! m_bd.Occupied(move));
-    // Temporarily switch ko rule to SIMPLEKO to avoid slow full board
-    // repetition test in GoBoard::Play()
-    GoRestoreKoRule restoreKoRule(m_bd);
-    m_bd.Rules().SetKoRule(GoRules::SIMPLEKO);
+    // Uses the ko rule of the game, the full board repetition check of
+    // GoBoard::Play() is fast (see GoHashHistory)
     m_bd.Play(move);
     SG_ASSERT(! m_bd.LastMoveInfo(GO_MOVEFLAG_ILLEGAL));
     ++m_gameLength;
+    OnPlay();
 }
 
 void GoUctState::ExecutePlayout(SgMove move)
@@ -132,12 +155,26 @@ void GoUctState::ExecutePlayout(SgMove move)
     ++m_gameLength;
 }
 
+void GoUctState::OnBoardChange()
+{ }
+
+void GoUctState::OnPlay()
+{ }
+
+void GoUctState::PreUndo()
+{ }
+
 void GoUctState::GameStart()
 {
     m_isInPlayout = false;
     m_gameLength = 0;
 }
 
+void GoUctState::SetNeighborhoodHash(bool enable)
+{
+    m_bd.SetNeighborhoodHash(enable);
+}
+
 void GoUctState::StartPlayout()
 {
     m_uctBd.Init(m_bd);
@@ -156,7 +193,10 @@ void GoUctState::StartSearch()
 void GoUctState::TakeBackInTree(std::size_t nuMoves)
 {
     for (size_t i = 0; i < nuMoves; ++i)
+    {
+        PreUndo();
         m_bd.Undo();
+    }
 }
 
 void GoUctState::TakeBackPlayout(std::size_t nuMoves)
@@ -63,6 +63,11 @@ public:
     /** Board used during in-tree phase. */
     const GoBoard& Board() const;
 
+    /** Enable or disable the neighborhood hash codes of Board().
+        Needed by knowledge that uses them.
+        @see GoBoard::SetNeighborhoodHash() */
+    void SetNeighborhoodHash(bool enable);
+
     /** Board used during playout phase. */
     const GoUctBoard& UctBoard() const;
 
@@ -73,7 +78,46 @@ public:
 
     void Dump(std::ostream& out) const;
 
+protected:
+    /** @name Hook functions for changes of Board()
+        Called for the moves played and taken back in the in-tree phase
+        and by the synchronization with the board of the search in
+        StartSearch(), see GoBoardSynchronizer. */
+    // @{
+
+    /** Board() was initialized with a new size or setup.
+        Default implementation does nothing. */
+    virtual void OnBoardChange();
+
+    /** Move was executed on Board().
+        Default implementation does nothing. */
+    virtual void OnPlay();
+
+    /** Move on Board() is about to be taken back.
+        Default implementation does nothing. */
+    virtual void PreUndo();
+
+    // @}
+
 private:
+    /** Synchronizes Board() and calls the hook functions of the state. */
+    class Synchronizer
+        : public GoBoardSynchronizer
+    {
+    public:
+        Synchronizer(GoUctState& state, const GoBoard& publisher);
+
+    protected:
+        void OnBoardChange();
+
+        void OnPlay(GoPlayerMove move);
+
+        void PreUndo();
+
+    private:
+        GoUctState& m_state;
+    };
+
     /** Assertion handler to dump the state of a GoUctState. */
     class AssertionHandler
         : public SgAssertionHandler
@@ -95,7 +139,7 @@ private:
     /** Board used for playout phase. */
     GoUctBoard m_uctBd;
 
-    GoBoardSynchronizer m_synchronizer;
+    Synchronizer m_synchronizer;
 
     bool m_isInPlayout;
 
@@ -0,0 +1,83 @@
+//----------------------------------------------------------------------------
+/** @file GoUctAdditiveKnowledgeGreenpeepTest.cpp
+    Unit tests for GoUctAdditiveKnowledgeGreenpeep. */
+//----------------------------------------------------------------------------
+
+#include "SgSystem.h"
+
+#include <boost/scoped_ptr.hpp>
+#include <boost/test/auto_unit_test.hpp>
+#include "GoBoard.h"
+#include "GoBoardUtil.h"
+#include "GoUctAdditiveKnowledgeGreenpeep.h"
+#include "SgRandom.h"
+
+//----------------------------------------------------------------------------
+
+namespace {
+
+void GenerateMoves(const GoBoard& bd, std::vector<SgUctMoveInfo>& moves)
+{
+    moves.clear();
+    for (GoBoard::Iterator it(bd); it; ++it)
+        if (bd.IsEmpty(*it) && bd.IsLegal(*it))
+            moves.push_back(SgUctMoveInfo(*it));
+    moves.push_back(SgUctMoveInfo(SG_PASS));
+}
+
+/** Check that the incrementally updated contexts are equal to the contexts
+    computed from scratch in a random walk of moves and takebacks, as done
+    in the in-tree phase of the search. */
+void CheckIncremental(const GoUctAdditiveKnowledgeParamGreenpeep& param,
+                      int size)
+{
+    SgRandom random;
+    GoBoard bd(size);
+    bd.Rules().SetKoRule(GoRules::SIMPLEKO);
+    GoUctAdditiveKnowledgeGreenpeep incremental(bd, param);
+    GoUctAdditiveKnowledgeGreenpeep full(bd, param);
+    full.SetIncremental(false);
+    std::vector<SgUctMoveInfo> moves;
+    std::vector<SgUctMoveInfo> fullMoves;
+    for (int i = 0; i < 400; ++i)
+    {
+        GenerateMoves(bd, moves);
+        fullMoves = moves;
+        incremental.ProcessPosition(moves);
+        full.ProcessPosition(fullMoves);
+        for (std::size_t j = 0; j < moves.size(); ++j)
+        {
+            BOOST_CHECK_EQUAL(incremental.Context(j), full.Context(j));
+            BOOST_CHECK_EQUAL(moves[j].m_predictorValue,
+                              fullMoves[j].m_predictorValue);
+        }
+        if (bd.MoveNumber() > 0 && random.Int(5) == 0)
+        {
+            int nuUndo = 1 + random.Int(std::min(bd.MoveNumber(), 3));
+            for (int j = 0; j < nuUndo; ++j)
+                bd.Undo();
+        }
+        else
+        {
+            SgPoint p = moves[random.Int(moves.size())].m_move;
+            if (p != SG_PASS && GoBoardUtil::IsCompletelySurrounded(bd, p))
+                p = SG_PASS;
+            bd.Play(p);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(GoUctAdditiveKnowledgeGreenpeepTest_Incremental)
+{
+    // Large pattern tables, allocate on the heap
+    boost::scoped_ptr<GoUctAdditiveKnowledgeParamGreenpeep>
+        param(new GoUctAdditiveKnowledgeParamGreenpeep());
+    // Contexts are only kept on boards of size 13 or larger. Size 13 uses
+    // the 9x9 patterns with the ko and atari bits.
+    CheckIncremental(*param, 13);
+    CheckIncremental(*param, 19);
+}
+
+} // namespace
+
+//----------------------------------------------------------------------------
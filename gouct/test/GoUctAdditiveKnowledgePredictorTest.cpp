@@ -0,0 +1,230 @@
+//----------------------------------------------------------------------------
+/** @file GoUctAdditiveKnowledgePredictorTest.cpp
+    Unit tests for GoUctAdditiveKnowledgePredictor. */
+//----------------------------------------------------------------------------
+
+#include "SgSystem.h"
+
+#include <sstream>
+#include <boost/test/auto_unit_test.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+#include "GoBoard.h"
+#include "GoUctAdditiveKnowledgePredictor.h"
+#include "SgException.h"
+
+using namespace GoUctPredictorFeatures;
+using SgPointUtil::Pt;
+
+//----------------------------------------------------------------------------
+
+namespace {
+
+/** Weights of an MLP with hidden size 5 (not a multiple of the vector
+    width). */
+const char* MLP_WEIGHTS =
+    "# test weights\n"
+    "fuego_move_predictor 1\n"
+    "hidden 5\n"
+    "bias 0.5\n"
+    "pass -1\n"
+    "hidden_bias 0.1 -0.2 0.3 -0.4 0.5\n"
+    "output 1 -2 0.5 0.25 3\n"
+    "pattern 7 0.5 0.5 -1 2 -3\n"
+    "capture 1 1 1 1 1 1\n"
+    "line 0 -0.5 0.25 0.75 -2 0.125\n"
+    "large_pattern .X.........O. 0.5\n";
+
+void GenerateMoves(const GoBoard& bd, std::vector<SgUctMoveInfo>& moves)
+{
+    moves.clear();
+    for (GoBoard::Iterator it(bd); it; ++it)
+        if (bd.IsEmpty(*it) && bd.IsLegal(*it))
+            moves.push_back(SgUctMoveInfo(*it));
+    moves.push_back(SgUctMoveInfo(SG_PASS));
+}
+
+void Read(GoUctAdditiveKnowledgeParamPredictor& param, const std::string& s)
+{
+    std::istringstream in(s);
+    param.Read(in);
+}
+
+/** Features with index 0 in all groups except the given ones. */
+std::vector<int> Features(int pattern, int capture, int line)
+{
+    std::vector<int> features(NU_GROUPS);
+    for (int g = 0; g < NU_GROUPS; ++g)
+        features[g] = Offset(Group(g));
+    features[PATTERN] += pattern;
+    features[CAPTURE] += capture;
+    features[LINE] += line;
+    return features;
+}
+
+/** Position with a white stone at E5 in atari; black to play.
+    F5 captures it. */
+void SetupCapturePosition(GoBoard& bd)
+{
+    bd.Play(Pt(5, 4), SG_BLACK);
+    bd.Play(Pt(5, 5), SG_WHITE);
+    bd.Play(Pt(5, 6), SG_BLACK);
+    bd.Play(Pt(1, 1), SG_WHITE);
+    bd.Play(Pt(4, 5), SG_BLACK);
+    bd.Play(Pt(9, 9), SG_WHITE);
+}
+
+//----------------------------------------------------------------------------
+
+/** Test that the MLP scores are equal to a direct computation. */
+BOOST_AUTO_TEST_CASE(GoUctAdditiveKnowledgePredictorTest_EvaluateMlp)
+{
+    GoUctAdditiveKnowledgeParamPredictor param;
+    Read(param, MLP_WEIGHTS);
+    BOOST_CHECK_EQUAL(param.HiddenSize(), 5);
+    BOOST_CHECK_EQUAL(param.PassScore(), -1.f);
+    const float hiddenBias[5] = { 0.1f, -0.2f, 0.3f, -0.4f, 0.5f };
+    const float output[5] = { 1.f, -2.f, 0.5f, 0.25f, 3.f };
+    const float pattern[5] = { 0.5f, 0.5f, -1.f, 2.f, -3.f };
+    const float line[5] = { -0.5f, 0.25f, 0.75f, -2.f, 0.125f };
+    std::vector<int> features;
+    std::vector<int> move = Features(7, 1, 0);
+    features.insert(features.end(), move.begin(), move.end());
+    move = Features(0, 0, 4);
+    features.insert(features.end(), move.begin(), move.end());
+    move = Features(7, 0, 0);
+    features.insert(features.end(), move.begin(), move.end());
+    float scores[3];
+    param.Evaluate(&features[0], 3, scores);
+    for (int i = 0; i < 3; ++i)
+    {
+        float expected = 0.5f;
+        for (int k = 0; k < 5; ++k)
+        {
+            float h = hiddenBias[k];
+            if (i != 1)
+                h += pattern[k] + line[k];
+            if (i == 0)
+                h += 1.f;
+            if (h > 0)
+                expected += h * output[k];
+        }
+        BOOST_CHECK_CLOSE(scores[i], expected, 1e-4f);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(GoUctAdditiveKnowledgePredictorTest_Features)
+{
+    GoBoard bd(9);
+    SetupCapturePosition(bd);
+    std::vector<SgUctMoveInfo> moves;
+    moves.push_back(SgUctMoveInfo(Pt(6, 5)));
+    moves.push_back(SgUctMoveInfo(Pt(1, 9)));
+    moves.push_back(SgUctMoveInfo(SG_PASS));
+    GoLadderCache ladderCache;
+    std::vector<int> features;
+    Compute(bd, moves, ladderCache, features);
+    BOOST_REQUIRE_EQUAL(features.size(), 3u * NU_GROUPS);
+    const int* f = &features[0];
+    BOOST_CHECK_EQUAL(f[CAPTURE], Offset(CAPTURE) + 1);
+    BOOST_CHECK_EQUAL(f[LIBERTIES], Offset(LIBERTIES) + 4);
+    BOOST_CHECK_EQUAL(f[LINE], Offset(LINE) + 3);
+    // Last move J9: dx = 3, dy = 4
+    BOOST_CHECK_EQUAL(f[DIST_LAST], Offset(DIST_LAST) + 11);
+    // Second last move D5: dx = 2, dy = 0
+    BOOST_CHECK_EQUAL(f[DIST_2ND_LAST], Offset(DIST_2ND_LAST) + 4);
+    // N, S, W, E: empty, empty, opponent, empty;
+    // NW, NE, SW, SE: own, empty, own, empty
+    BOOST_CHECK_EQUAL(f[PATTERN], (2 << 4) | (1 << 8) | (1 << 12));
+    f = &features[NU_GROUPS];
+    BOOST_CHECK_EQUAL(f[CAPTURE], Offset(CAPTURE));
+    BOOST_CHECK_EQUAL(f[LIBERTIES], Offset(LIBERTIES) + 2);
+    BOOST_CHECK_EQUAL(f[LINE], Offset(LINE));
+    BOOST_CHECK_EQUAL(f[PATTERN] & 3, 3); // N is border
+}
+
+BOOST_AUTO_TEST_CASE(GoUctAdditiveKnowledgePredictorTest_Probabilities)
+{
+    GoBoard bd(9);
+    SetupCapturePosition(bd);
+    GoUctAdditiveKnowledgeParamPredictor param;
+    GoUctAdditiveKnowledgePredictor knowledge(bd, param);
+    std::vector<SgUctMoveInfo> moves;
+    GenerateMoves(bd, moves);
+    knowledge.ProcessPosition(moves);
+    float sum = 0;
+    SgPoint best = SG_NULLMOVE;
+    float bestValue = 0;
+    for (std::size_t i = 0; i < moves.size(); ++i)
+    {
+        BOOST_CHECK(moves[i].m_predictorValue > 0);
+        sum += moves[i].m_predictorValue;
+        if (moves[i].m_predictorValue > bestValue)
+        {
+            bestValue = moves[i].m_predictorValue;
+            best = moves[i].m_move;
+        }
+    }
+    BOOST_CHECK_CLOSE(sum, 1.f, 1e-3f);
+    BOOST_CHECK_EQUAL(best, Pt(6, 5));
+}
+
+/** Test that writing and reading the weights gives the same weights. */
+BOOST_AUTO_TEST_CASE(GoUctAdditiveKnowledgePredictorTest_ReadWrite)
+{
+    GoUctAdditiveKnowledgeParamPredictor defaultParam;
+    GoUctAdditiveKnowledgeParamPredictor mlpParam;
+    Read(mlpParam, MLP_WEIGHTS);
+    const GoUctAdditiveKnowledgeParamPredictor* params[2] =
+        { &defaultParam, &mlpParam };
+    for (int i = 0; i < 2; ++i)
+    {
+        std::ostringstream out;
+        params[i]->Write(out);
+        GoUctAdditiveKnowledgeParamPredictor param;
+        Read(param, out.str());
+        std::ostringstream out2;
+        param.Write(out2);
+        BOOST_CHECK_EQUAL(out.str(), out2.str());
+        BOOST_CHECK_EQUAL(param.HiddenSize(), params[i]->HiddenSize());
+        std::vector<int> features = Features(7, 1, 0);
+        float score;
+        float expected;
+        param.Evaluate(&features[0], 1, &score);
+        params[i]->Evaluate(&features[0], 1, &expected);
+        BOOST_CHECK_EQUAL(score, expected);
+    }
+}
+
+/** Test that invalid weights throw and leave the weights unchanged. */
+BOOST_AUTO_TEST_CASE(GoUctAdditiveKnowledgePredictorTest_ReadInvalid)
+{
+    const char* invalid[] = {
+        "",
+        "hidden 0\n",
+        "fuego_move_predictor 2\nhidden 0\n",
+        "fuego_move_predictor 1\nhidden 1000\n",
+        "fuego_move_predictor 1\nbias 1\n",
+        "fuego_move_predictor 1\nhidden 0\nhidden_bias 1\n",
+        "fuego_move_predictor 1\nhidden 0\ncapture 5 1\n",
+        "fuego_move_predictor 1\nhidden 0\ncapture 1 1 2\n",
+        "fuego_move_predictor 1\nhidden 2\ncapture 1 1\n",
+        "fuego_move_predictor 1\nhidden 0\nunknown 1 1\n",
+        "fuego_move_predictor 1\nhidden 0\nbias x\n",
+        "fuego_move_predictor 1\nhidden 0\nlarge_pattern .X 1\n",
+        "fuego_move_predictor 1\nhidden 0\nlarge_pattern ............. 1 2\n"
+    };
+    GoUctAdditiveKnowledgeParamPredictor param;
+    std::ostringstream before;
+    param.Write(before);
+    for (std::size_t i = 0; i < sizeof(invalid) / sizeof(invalid[0]); ++i)
+    {
+        BOOST_CHECK_THROW(Read(param, invalid[i]), SgException);
+        std::ostringstream after;
+        param.Write(after);
+        BOOST_CHECK_EQUAL(before.str(), after.str());
+    }
+}
+
+} // namespace
+
+//----------------------------------------------------------------------------
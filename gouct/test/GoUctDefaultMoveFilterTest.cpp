@@ -0,0 +1,93 @@
+//----------------------------------------------------------------------------
+/** @file GoUctDefaultMoveFilterTest.cpp
+    Unit tests for GoUctDefaultMoveFilter. */
+//----------------------------------------------------------------------------
+
+#include "SgSystem.h"
+
+#include <algorithm>
+#include <boost/test/auto_unit_test.hpp>
+#include "GoBoard.h"
+#include "GoBoardUtil.h"
+#include "GoUctDefaultMoveFilter.h"
+#include "SgRandom.h"
+
+using namespace std;
+
+//----------------------------------------------------------------------------
+
+namespace {
+
+/** Play a random legal move that does not fill an own eye and report it to
+    the filter. */
+bool PlayRandomMove(GoBoard& bd, GoUctMoveFilter& filter, SgRandom& random)
+{
+    GoPointList moves;
+    for (GoBoard::Iterator it(bd); it; ++it)
+        if (  bd.IsEmpty(*it)
+           && bd.IsLegal(*it)
+           && ! GoBoardUtil::IsCompletelySurrounded(bd, *it)
+           )
+            moves.PushBack(*it);
+    if (moves.IsEmpty())
+        return false;
+    bd.Play(moves[random.Int(moves.Length())]);
+    filter.OnPlay();
+    return true;
+}
+
+vector<SgPoint> Sorted(vector<SgPoint> moves)
+{
+    sort(moves.begin(), moves.end());
+    return moves;
+}
+
+//----------------------------------------------------------------------------
+
+/** Test that a filter that gets the changes of the board reported returns
+    the same moves as a filter that computes everything at each call.
+    Moves are played and taken back as in the in-tree phase of a search.
+    The reporting starts in the middle of the game, so that moves are also
+    taken back that were not reported. */
+BOOST_AUTO_TEST_CASE(GoUctDefaultMoveFilterTest_Incremental)
+{
+    GoUctDefaultMoveFilterParam param;
+    param.SetCheckSafety(false);
+    // Filter defense moves independent of the length of the ladder, which
+    // can depend on the order of the liberties
+    param.SetMinLadderLength(0);
+    SgRandom random;
+    for (int game = 0; game < 4; ++game)
+    {
+        GoBoard bd(game % 2 == 0 ? 9 : 19);
+        bd.Rules().SetKoRule(GoRules::SIMPLEKO);
+        GoUctDefaultMoveFilter filter(bd, param);
+        GoUctDefaultMoveFilter reference(bd, param);
+        for (int i = 0; i < bd.Size() * bd.Size() / 4; ++i)
+            PlayRandomMove(bd, filter, random);
+        filter.OnBoardChange();
+        const int startMoveNumber = bd.MoveNumber();
+        for (int i = 0; i < 200; ++i)
+        {
+            const int nuMoves = random.Int(6);
+            for (int j = 0; j < nuMoves; ++j)
+                PlayRandomMove(bd, filter, random);
+            BOOST_CHECK(Sorted(filter.Get()) == Sorted(reference.Get()));
+            int nuUndo = random.Int(nuMoves + 1);
+            if (random.Int(20) == 0)
+                // Sometimes undo moves played before the reporting started
+                nuUndo += 3;
+            for (int j = 0; j < nuUndo && bd.MoveNumber() > 0; ++j)
+            {
+                filter.PreUndo();
+                bd.Undo();
+            }
+            BOOST_CHECK(Sorted(filter.Get()) == Sorted(reference.Get()));
+        }
+        BOOST_CHECK(bd.MoveNumber() != startMoveNumber);
+    }
+}
+
+} // namespace
+
+//----------------------------------------------------------------------------
@@ -0,0 +1,81 @@
+//----------------------------------------------------------------------------
+/** @file GoUctDefaultPriorKnowledgeTest.cpp
+    Unit tests for GoUctDefaultPriorKnowledge. */
+//----------------------------------------------------------------------------
+
+#include "SgSystem.h"
+
+#include <boost/test/auto_unit_test.hpp>
+#include "GoBoard.h"
+#include "GoBoardUtil.h"
+#include "GoUctDefaultPriorKnowledge.h"
+#include "SgRandom.h"
+
+//----------------------------------------------------------------------------
+
+namespace {
+
+void GenerateMoves(const GoBoard& bd, std::vector<SgUctMoveInfo>& moves)
+{
+    moves.clear();
+    for (GoBoard::Iterator it(bd); it; ++it)
+        if (bd.IsEmpty(*it) && bd.IsLegal(*it))
+            moves.push_back(SgUctMoveInfo(*it));
+    moves.push_back(SgUctMoveInfo(SG_PASS));
+}
+
+/** Check that the priors computed on the GoUctBoard copy of the position
+    are equal to the priors computed on the GoBoard in a random walk of
+    moves and takebacks. */
+void CheckUctBoard(int size)
+{
+    SgRandom random;
+    GoBoard bd(size);
+    bd.Rules().SetKoRule(GoRules::SIMPLEKO);
+    GoUctPlayoutPolicyParam param;
+    GoUctDefaultPriorKnowledge uctBoard(bd, param);
+    uctBoard.SetUseUctBoard(true);
+    GoUctDefaultPriorKnowledge goBoard(bd, param);
+    goBoard.SetUseUctBoard(false);
+    std::vector<SgUctMoveInfo> moves;
+    std::vector<SgUctMoveInfo> goBoardMoves;
+    for (int i = 0; i < 200; ++i)
+    {
+        GenerateMoves(bd, moves);
+        goBoardMoves = moves;
+        uctBoard.ProcessPosition(moves);
+        goBoard.ProcessPosition(goBoardMoves);
+        for (std::size_t j = 0; j < moves.size(); ++j)
+        {
+            BOOST_CHECK_EQUAL(moves[j].m_value, goBoardMoves[j].m_value);
+            BOOST_CHECK_EQUAL(moves[j].m_count, goBoardMoves[j].m_count);
+            BOOST_CHECK_EQUAL(moves[j].m_raveValue,
+                              goBoardMoves[j].m_raveValue);
+            BOOST_CHECK_EQUAL(moves[j].m_raveCount,
+                              goBoardMoves[j].m_raveCount);
+        }
+        if (bd.MoveNumber() > 0 && random.Int(5) == 0)
+        {
+            int nuUndo = 1 + random.Int(std::min(bd.MoveNumber(), 3));
+            for (int j = 0; j < nuUndo; ++j)
+                bd.Undo();
+        }
+        else
+        {
+            SgPoint p = moves[random.Int(moves.size())].m_move;
+            if (p != SG_PASS && GoBoardUtil::IsCompletelySurrounded(bd, p))
+                p = SG_PASS;
+            bd.Play(p);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(GoUctDefaultPriorKnowledgeTest_UctBoard)
+{
+    CheckUctBoard(9);
+    CheckUctBoard(19);
+}
+
+} // namespace
+
+//----------------------------------------------------------------------------
@@ -0,0 +1,108 @@
+//----------------------------------------------------------------------------
+/** @file GoUctKnowledgeCacheTest.cpp
+    Unit tests for GoUctKnowledgeCache. */
+//----------------------------------------------------------------------------
+
+#include "SgSystem.h"
+
+#include <boost/test/auto_unit_test.hpp>
+#include "GoBoard.h"
+#include "GoUctKnowledgeCache.h"
+
+using SgPointUtil::Pt;
+
+//----------------------------------------------------------------------------
+
+namespace {
+
+void CreateMoves(std::vector<SgUctMoveInfo>& moves)
+{
+    moves.clear();
+    moves.push_back(SgUctMoveInfo(Pt(3, 3), 0.5f, 10, 0.25f, 4));
+    moves.push_back(SgUctMoveInfo(Pt(5, 5)));
+    moves.back().m_predictorValue = 0.75f;
+    moves.push_back(SgUctMoveInfo(SG_PASS));
+}
+
+BOOST_AUTO_TEST_CASE(GoUctKnowledgeCacheTest_Disabled)
+{
+    GoUctKnowledgeCache cache;
+    BOOST_CHECK(! cache.IsEnabled());
+    GoBoard bd(9);
+    std::vector<SgUctMoveInfo> moves;
+    CreateMoves(moves);
+    SgHashCode key = cache.Key(bd, 0);
+    cache.Store(key, moves);
+    std::vector<SgUctMoveInfo> found;
+    BOOST_CHECK(! cache.Lookup(key, found));
+    BOOST_CHECK(found.empty());
+}
+
+/** Test that Key() includes the color to play, the last move and the
+    variant. */
+BOOST_AUTO_TEST_CASE(GoUctKnowledgeCacheTest_Key)
+{
+    GoUctKnowledgeCache cache;
+    GoBoard bd(9);
+    SgHashCode key1 = cache.Key(bd, 0);
+    BOOST_CHECK(key1 != cache.Key(bd, 1));
+    bd.SetToPlay(SG_WHITE);
+    BOOST_CHECK(key1 != cache.Key(bd, 0));
+    bd.SetToPlay(SG_BLACK);
+    BOOST_CHECK(key1 == cache.Key(bd, 0));
+    bd.Play(SG_PASS);
+    bd.Play(SG_PASS);
+    BOOST_CHECK(key1 != cache.Key(bd, 0));
+}
+
+BOOST_AUTO_TEST_CASE(GoUctKnowledgeCacheTest_StoreLookup)
+{
+    GoUctKnowledgeCache cache;
+    cache.Resize(16, 9 * 9 + 1);
+    BOOST_CHECK(cache.IsEnabled());
+    BOOST_CHECK_EQUAL(cache.NuEntries(), 16u);
+    GoBoard bd(9);
+    std::vector<SgUctMoveInfo> moves;
+    CreateMoves(moves);
+    SgHashCode key = cache.Key(bd, 0);
+    cache.Store(key, moves);
+    std::vector<SgUctMoveInfo> found;
+    BOOST_CHECK(! cache.Lookup(cache.Key(bd, 1), found));
+    BOOST_REQUIRE(cache.Lookup(key, found));
+    BOOST_REQUIRE_EQUAL(found.size(), moves.size());
+    for (std::size_t i = 0; i < moves.size(); ++i)
+    {
+        BOOST_CHECK_EQUAL(found[i].m_move, moves[i].m_move);
+        BOOST_CHECK_CLOSE(found[i].m_value, moves[i].m_value, 1e-4);
+        BOOST_CHECK_CLOSE(found[i].m_count, moves[i].m_count, 1e-4);
+        BOOST_CHECK_CLOSE(found[i].m_raveValue, moves[i].m_raveValue, 1e-4);
+        BOOST_CHECK_CLOSE(found[i].m_raveCount, moves[i].m_raveCount, 1e-4);
+        BOOST_CHECK_CLOSE(found[i].m_predictorValue,
+                          moves[i].m_predictorValue, 1e-4);
+    }
+}
+
+/** Test that a change of the context clears the cache. */
+BOOST_AUTO_TEST_CASE(GoUctKnowledgeCacheTest_SetContext)
+{
+    GoUctKnowledgeCache cache;
+    cache.Resize(16, 9 * 9 + 1);
+    GoBoard bd(9);
+    std::vector<SgUctMoveInfo> moves;
+    CreateMoves(moves);
+    SgBWSet safe;
+    cache.SetContext(cache.SafetyCode(safe));
+    SgHashCode key = cache.Key(bd, 0);
+    cache.Store(key, moves);
+    std::vector<SgUctMoveInfo> found;
+    cache.SetContext(cache.SafetyCode(safe));
+    BOOST_CHECK(cache.Lookup(key, found));
+    safe[SG_BLACK].Include(Pt(1, 1));
+    cache.SetContext(cache.SafetyCode(safe));
+    found.clear();
+    BOOST_CHECK(! cache.Lookup(key, found));
+}
+
+} // namespace
+
+//----------------------------------------------------------------------------
@@ -0,0 +1,116 @@
+//----------------------------------------------------------------------------
+/** @file GoUctNeighborhoodPatternsTest.cpp
+    Unit tests for GoUctNeighborhoodPatterns. */
+//----------------------------------------------------------------------------
+
+#include "SgSystem.h"
+
+#include <boost/test/auto_unit_test.hpp>
+#include "GoBoard.h"
+#include "GoUctBoard.h"
+#include "GoUctNeighborhoodPatterns.h"
+#include "SgException.h"
+
+using SgPointUtil::Pt;
+
+//----------------------------------------------------------------------------
+
+namespace {
+
+/** The pattern of the neighborhood of a point as seen by the color to
+    play. */
+std::string Pattern(const GoBoard& bd, SgPoint p, int radius)
+{
+    std::string pattern;
+    for (int i = 0; i < GoNeighborhoodHash::NuPoints(radius); ++i)
+    {
+        const int col = SgPointUtil::Col(p) + GoNeighborhoodHash::DeltaCol(i);
+        const int row = SgPointUtil::Row(p) + GoNeighborhoodHash::DeltaRow(i);
+        if (col < 1 || col > bd.Size() || row < 1 || row > bd.Size())
+            pattern += '#';
+        else
+        {
+            const SgBoardColor c = bd.GetColor(Pt(col, row));
+            pattern += (c == SG_EMPTY ? '.' : c == bd.ToPlay() ? 'X' : 'O');
+        }
+    }
+    return pattern;
+}
+
+/** Test a position and its mirrored, color-swapped copy with and without
+    incremental hash codes. */
+BOOST_AUTO_TEST_CASE(GoUctNeighborhoodPatternsTest_Value)
+{
+    GoBoard bd(9);
+    bd.Play(Pt(3, 3), SG_BLACK);
+    bd.Play(Pt(4, 4), SG_WHITE);
+    bd.Play(Pt(2, 5), SG_BLACK);
+    bd.Play(Pt(5, 2), SG_WHITE);
+    GoUctNeighborhoodPatterns patterns;
+    BOOST_CHECK(patterns.IsEmpty());
+    const SgPoint p = Pt(3, 4);
+    patterns.Add(Pattern(bd, p, 2), 1.f);
+    patterns.Add(Pattern(bd, p, 4), 2.f);
+    BOOST_CHECK_EQUAL(patterns.Patterns().size(), 2u);
+    BOOST_CHECK_EQUAL(patterns.Value(bd, p), 2.f);
+    BOOST_CHECK_EQUAL(patterns.Value(bd, Pt(5, 5)), 0.f);
+    // Only the radius 2 pattern matches without the stone at distance 4
+    GoBoard bd2(9);
+    bd2.Play(Pt(3, 3), SG_BLACK);
+    bd2.Play(Pt(4, 4), SG_WHITE);
+    bd2.Play(Pt(2, 5), SG_BLACK);
+    bd2.Play(SG_PASS, SG_WHITE);
+    BOOST_CHECK_EQUAL(patterns.Value(bd2, p), 1.f);
+    // Mirrored at the diagonal with colors swapped and white to play
+    GoBoard bd3(9);
+    bd3.Play(Pt(3, 3), SG_WHITE);
+    bd3.Play(Pt(4, 4), SG_BLACK);
+    bd3.Play(Pt(5, 2), SG_WHITE);
+    bd3.Play(Pt(2, 5), SG_BLACK);
+    BOOST_REQUIRE_EQUAL(bd3.ToPlay(), SG_WHITE);
+    BOOST_CHECK_EQUAL(patterns.Value(bd3, Pt(4, 3)), 2.f);
+    bd3.SetNeighborhoodHash(true);
+    BOOST_CHECK_EQUAL(patterns.Value(bd3, Pt(4, 3)), 2.f);
+    GoUctBoard uctBd(bd3);
+    uctBd.SetNeighborhoodHash(true);
+    BOOST_CHECK_EQUAL(patterns.Value(uctBd, Pt(4, 3)), 2.f);
+    patterns.Clear();
+    BOOST_CHECK_EQUAL(patterns.Value(bd3, Pt(4, 3)), 0.f);
+}
+
+/** Test that the incremental hash codes of GoUctBoard are equal to hash
+    codes computed from scratch during a game. */
+BOOST_AUTO_TEST_CASE(GoUctNeighborhoodPatternsTest_UctBoardHash)
+{
+    GoBoard bd(9);
+    GoUctBoard uctBd(bd);
+    uctBd.SetNeighborhoodHash(true);
+    // Includes captures
+    const SgPoint moves[] = { Pt(2, 1), Pt(1, 1), Pt(3, 2), Pt(2, 2),
+                              Pt(1, 2), Pt(3, 1), Pt(4, 2), Pt(1, 3),
+                              Pt(2, 3), Pt(4, 1), Pt(3, 3) };
+    for (std::size_t i = 0; i < sizeof(moves) / sizeof(moves[0]); ++i)
+    {
+        uctBd.Play(moves[i]);
+        for (GoUctBoard::Iterator it(uctBd); it; ++it)
+            for (int radius = GoNeighborhoodHash::MIN_RADIUS;
+                 radius <= GoNeighborhoodHash::MAX_RADIUS; ++radius)
+                BOOST_REQUIRE(uctBd.NeighborhoodHash()->Get(*it, radius)
+                              == GoNeighborhoodHash::Compute(uctBd, *it,
+                                                             radius));
+    }
+    BOOST_CHECK(uctBd.NumPrisoners(SG_WHITE) > 0);
+}
+
+BOOST_AUTO_TEST_CASE(GoUctNeighborhoodPatternsTest_Invalid)
+{
+    GoUctNeighborhoodPatterns patterns;
+    BOOST_CHECK_THROW(patterns.Add(".X", 1.f), SgException);
+    BOOST_CHECK_THROW(patterns.Add("X............", 1.f), SgException);
+    BOOST_CHECK_THROW(patterns.Add(".a...........", 1.f), SgException);
+    BOOST_CHECK(patterns.IsEmpty());
+}
+
+} // namespace
+
+//----------------------------------------------------------------------------
@@ -0,0 +1,79 @@
+//----------------------------------------------------------------------------
+/** @file GoUctOwnershipTest.cpp
+    Unit tests for GoUctOwnership. */
+//----------------------------------------------------------------------------
+
+#include "SgSystem.h"
+
+#include <boost/test/auto_unit_test.hpp>
+#include "GoBoard.h"
+#include "GoUctOwnership.h"
+
+using SgPointUtil::Pt;
+
+//----------------------------------------------------------------------------
+
+namespace {
+
+BOOST_AUTO_TEST_CASE(GoUctOwnershipTest_Add)
+{
+    GoBoard bd(9);
+    GoUctOwnership ownership;
+    ownership.Clear(9);
+    SgPointArray<SgUctStatistics> statistics;
+    ownership.GetStatistics(bd, statistics);
+    BOOST_CHECK_EQUAL(statistics[Pt(1, 1)].Count(), 0);
+    SgPointArray<SgEmptyBlackWhite> owner(SG_BORDER);
+    for (GoBoard::Iterator it(bd); it; ++it)
+        owner[*it] = SG_BLACK;
+    owner[Pt(2, 1)] = SG_WHITE;
+    owner[Pt(3, 1)] = SG_EMPTY;
+    ownership.Add(owner);
+    owner[Pt(1, 1)] = SG_WHITE;
+    owner[Pt(9, 9)] = SG_EMPTY;
+    ownership.Add(owner);
+    BOOST_CHECK_EQUAL(ownership.Count(), 2u);
+    BOOST_CHECK_CLOSE(ownership.Mean(Pt(1, 1)), 0.5, 1e-4);
+    BOOST_CHECK_CLOSE(ownership.Mean(Pt(2, 1)), 0, 1e-4);
+    BOOST_CHECK_CLOSE(ownership.Mean(Pt(3, 1)), 0.5, 1e-4);
+    BOOST_CHECK_CLOSE(ownership.Mean(Pt(5, 5)), 1, 1e-4);
+    BOOST_CHECK_CLOSE(ownership.Mean(Pt(9, 9)), 0.75, 1e-4);
+    ownership.GetStatistics(bd, statistics);
+    BOOST_CHECK_EQUAL(statistics[Pt(9, 9)].Count(), 2);
+    BOOST_CHECK_CLOSE(statistics[Pt(9, 9)].Mean(), 0.75, 1e-4);
+    ownership.Clear(9);
+    BOOST_CHECK_EQUAL(ownership.Count(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(GoUctOwnershipTest_Merge)
+{
+    GoBoard bd(9);
+    SgPointArray<SgEmptyBlackWhite> owner(SG_EMPTY);
+    for (GoBoard::Iterator it(bd); it; ++it)
+        owner[*it] = SG_WHITE;
+    GoUctOwnership ownership1;
+    ownership1.Clear(9);
+    ownership1.Add(owner);
+    owner[Pt(4, 4)] = SG_BLACK;
+    GoUctOwnership ownership2;
+    ownership2.Clear(9);
+    ownership2.Add(owner);
+    ownership2.Add(owner);
+    GoUctOwnership merged;
+    merged.Clear(9);
+    merged.Merge(ownership1);
+    merged.Merge(ownership2);
+    BOOST_CHECK_EQUAL(merged.Count(), 3u);
+    BOOST_CHECK_CLOSE(merged.Mean(Pt(4, 4)), 2. / 3., 1e-4);
+    BOOST_CHECK_CLOSE(merged.Mean(Pt(4, 5)), 0, 1e-4);
+    // Accumulators for another board size are ignored
+    GoUctOwnership ownership3;
+    ownership3.Clear(19);
+    ownership3.Add(owner);
+    merged.Merge(ownership3);
+    BOOST_CHECK_EQUAL(merged.Count(), 3u);
+}
+
+} // namespace
+
+//----------------------------------------------------------------------------
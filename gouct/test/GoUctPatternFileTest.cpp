@@ -0,0 +1,120 @@
+//----------------------------------------------------------------------------
+/** @file GoUctPatternFileTest.cpp
+    Unit tests for GoUctPatternFile. */
+//----------------------------------------------------------------------------
+
+#include "SgSystem.h"
+
+#include <fstream>
+#include <boost/filesystem.hpp>
+#include <boost/test/auto_unit_test.hpp>
+#include "GoUctPatternFile.h"
+#include "SgException.h"
+
+using GoUctPatternData::PatternTableEntry;
+
+//----------------------------------------------------------------------------
+
+namespace {
+
+/** Temporary file, removed in the destructor. */
+class TempFile
+{
+public:
+    TempFile();
+
+    ~TempFile();
+
+    std::string Name() const;
+
+private:
+    boost::filesystem::path m_path;
+};
+
+TempFile::TempFile()
+    : m_path(boost::filesystem::temp_directory_path()
+             / boost::filesystem::unique_path("fuego-%%%%-%%%%.dat"))
+{ }
+
+TempFile::~TempFile()
+{
+    boost::system::error_code ec;
+    boost::filesystem::remove(m_path, ec);
+}
+
+std::string TempFile::Name() const
+{
+    return m_path.string();
+}
+
+BOOST_AUTO_TEST_CASE(GoUctPatternFileTest_WriteRead)
+{
+    const uint16_t values[3] = { 1, 512, 65535 };
+    const PatternTableEntry entries[2] = { { 17, 0.5f }, { -1, 2.25f } };
+    GoUctPatternFileWriter writer;
+    writer.AddUInt16("values", values, 3);
+    writer.AddPatternEntries("entries", entries, 2);
+    TempFile tempFile;
+    writer.Write(tempFile.Name());
+    GoUctPatternFile file(tempFile.Name());
+    std::size_t nuElements;
+    const uint16_t* readValues = file.FindUInt16("values", nuElements);
+    BOOST_REQUIRE(readValues != 0);
+    BOOST_REQUIRE_EQUAL(nuElements, 3u);
+    for (int i = 0; i < 3; ++i)
+        BOOST_CHECK_EQUAL(readValues[i], values[i]);
+    const PatternTableEntry* readEntries =
+        file.FindPatternEntries("entries", nuElements);
+    BOOST_REQUIRE(readEntries != 0);
+    BOOST_REQUIRE_EQUAL(nuElements, 2u);
+    for (int i = 0; i < 2; ++i)
+    {
+        BOOST_CHECK_EQUAL(readEntries[i].m_code, entries[i].m_code);
+        BOOST_CHECK_EQUAL(readEntries[i].m_value, entries[i].m_value);
+    }
+    // Wrong element type or unknown name
+    BOOST_CHECK(file.FindUInt16("entries", nuElements) == 0);
+    BOOST_CHECK(file.FindUInt16("unknown", nuElements) == 0);
+}
+
+BOOST_AUTO_TEST_CASE(GoUctPatternFileTest_Invalid)
+{
+    TempFile tempFile;
+    {
+        std::ofstream out(tempFile.Name().c_str(), std::ios::binary);
+        out << "This is not a pattern file";
+    }
+    BOOST_CHECK_THROW(GoUctPatternFile file(tempFile.Name()), SgException);
+}
+
+BOOST_AUTO_TEST_CASE(GoUctPatternFileTest_Version)
+{
+    GoUctPatternFileWriter writer;
+    TempFile tempFile;
+    writer.Write(tempFile.Name());
+    {
+        // Version number follows the 8-byte magic
+        std::fstream f(tempFile.Name().c_str(),
+                       std::ios::in | std::ios::out | std::ios::binary);
+        const uint32_t version = GoUctPatternFile::FORMAT_VERSION + 1;
+        f.seekp(8);
+        f.write(reinterpret_cast<const char*>(&version), sizeof(version));
+    }
+    BOOST_CHECK_THROW(GoUctPatternFile file(tempFile.Name()), SgException);
+}
+
+BOOST_AUTO_TEST_CASE(GoUctPatternFileTest_Truncated)
+{
+    const uint16_t values[4] = { 1, 2, 3, 4 };
+    GoUctPatternFileWriter writer;
+    writer.AddUInt16("values", values, 4);
+    TempFile tempFile;
+    writer.Write(tempFile.Name());
+    boost::filesystem::resize_file(tempFile.Name(),
+                         boost::filesystem::file_size(tempFile.Name()) - 2);
+    BOOST_CHECK_THROW(GoUctPatternFile file(tempFile.Name()), SgException);
+}
+
+} // namespace
+
+//----------------------------------------------------------------------------
@@ -0,0 +1,122 @@
+//----------------------------------------------------------------------------
+/** @file GoUctPlayoutBatchTest.cpp
+    Unit tests for GoUctPlayoutBatch. */
+//----------------------------------------------------------------------------
+
+#include "SgSystem.h"
+
+#include <boost/test/auto_unit_test.hpp>
+#include "GoBoard.h"
+#include "GoSetupUtil.h"
+#include "GoUctBoard.h"
+#include "GoUctPlayoutBatch.h"
+#include "GoUctPlayoutPolicy.h"
+
+using SgPointUtil::Pt;
+
+//----------------------------------------------------------------------------
+
+namespace {
+
+typedef GoUctPlayoutPolicy<GoUctBoard> Policy;
+
+typedef GoUctPlayoutPolicyFactory<GoUctBoard> PolicyFactory;
+
+typedef GoUctPolicyPlayoutBatch<Policy,PolicyFactory> Batch;
+
+/** Check that the final position of a game is the same as the position
+    after replaying its move sequence on a GoBoard. */
+void CheckReplay(const GoBoard& start, const Batch& batch, std::size_t i)
+{
+    GoBoard bd(start.Size(), start.Setup());
+    // Playout boards use simple ko
+    bd.Rules().SetKoRule(GoRules::SIMPLEKO);
+    for (GoBoard::Iterator it(bd); it; ++it)
+        BOOST_REQUIRE_EQUAL(bd.GetColor(*it), start.GetColor(*it));
+    const std::vector<SgMove>& sequence = batch.Sequence(i);
+    BOOST_CHECK_EQUAL(sequence.size(), batch.SkipRaveUpdate(i).size());
+    for (std::size_t j = 0; j < sequence.size(); ++j)
+    {
+        BOOST_CHECK_EQUAL(batch.SkipRaveUpdate(i)[j], sequence[j] == SG_PASS);
+        bd.Play(sequence[j]);
+        BOOST_REQUIRE(! bd.LastMoveInfo(GO_MOVEFLAG_ILLEGAL));
+    }
+    const GoUctBoard& uctBd = batch.Board(i);
+    BOOST_CHECK_EQUAL(uctBd.ToPlay(), bd.ToPlay());
+    for (GoBoard::Iterator it(bd); it; ++it)
+        BOOST_CHECK_EQUAL(uctBd.GetColor(*it), bd.GetColor(*it));
+}
+
+BOOST_AUTO_TEST_CASE(GoUctPlayoutBatchTest_Abort)
+{
+    GoBoard bd(9);
+    GoUctPlayoutPolicyParam param;
+    PolicyFactory factory(param);
+    Batch batch(factory);
+    batch.Run(bd, 3, 5);
+    BOOST_REQUIRE_EQUAL(batch.NuGames(), 3u);
+    for (std::size_t i = 0; i < batch.NuGames(); ++i)
+    {
+        BOOST_CHECK(batch.Aborted(i));
+        BOOST_CHECK_EQUAL(batch.Sequence(i).size(), 5u);
+        CheckReplay(bd, batch, i);
+    }
+}
+
+/** Test that the mercy rule ends a game before the first move, if the
+    stone difference of the start position exceeds the threshold. */
+BOOST_AUTO_TEST_CASE(GoUctPlayoutBatchTest_MercyRule)
+{
+    GoSetup setup;
+    setup.AddBlack(Pt(3, 3));
+    setup.AddBlack(Pt(5, 5));
+    setup.m_player = SG_WHITE;
+    GoBoard bd(9, setup);
+    GoUctPlayoutPolicyParam param;
+    PolicyFactory factory(param);
+    Batch batch(factory);
+    batch.SetMercyRuleThreshold(2);
+    batch.Run(bd, 2, 1000);
+    for (std::size_t i = 0; i < batch.NuGames(); ++i)
+    {
+        BOOST_CHECK(batch.MercyRuleTriggered(i));
+        BOOST_CHECK_EQUAL(batch.MercyRuleResult(i), 0);
+        BOOST_CHECK(! batch.Aborted(i));
+        BOOST_CHECK(batch.Sequence(i).empty());
+    }
+}
+
+/** Test that games of different start positions are played to the end
+    and that the games from the same start position are not identical. */
+BOOST_AUTO_TEST_CASE(GoUctPlayoutBatchTest_Run)
+{
+    GoBoard bd1(9);
+    GoSetup setup;
+    setup.AddBlack(Pt(5, 5));
+    setup.AddWhite(Pt(3, 3));
+    GoBoard bd2(9, setup);
+    std::vector<const GoBoard*> start;
+    start.push_back(&bd1);
+    start.push_back(&bd2);
+    start.push_back(&bd1);
+    start.push_back(&bd2);
+    GoUctPlayoutPolicyParam param;
+    PolicyFactory factory(param);
+    Batch batch(factory);
+    batch.Run(start, 1000);
+    BOOST_REQUIRE_EQUAL(batch.NuGames(), 4u);
+    for (std::size_t i = 0; i < batch.NuGames(); ++i)
+    {
+        BOOST_CHECK(! batch.Aborted(i));
+        BOOST_CHECK(! batch.MercyRuleTriggered(i));
+        BOOST_CHECK_EQUAL(batch.NuPassMoves(i), 2);
+        BOOST_CHECK_GT(batch.Sequence(i).size(), 2u);
+        CheckReplay(*start[i], batch, i);
+    }
+    BOOST_CHECK(batch.Sequence(0) != batch.Sequence(2));
+    BOOST_CHECK(batch.Sequence(1) != batch.Sequence(3));
+}
+
+} // namespace
+
+//----------------------------------------------------------------------------
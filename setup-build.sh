@@ -46,6 +46,10 @@ setup() {
 	    CXXFLAGS="$GCC_OPTIMIZE -g -pipe"
 	    CONFIGUREFLAGS="--enable-max-size=9"
 	    ;;
+	opt-13)
+	    CXXFLAGS="$GCC_OPTIMIZE -g -pipe"
+	    CONFIGUREFLAGS="--enable-max-size=13"
+	    ;;
 	opt-9-float)
 	    CXXFLAGS="$GCC_OPTIMIZE -g -pipe"
 	    CONFIGUREFLAGS="--enable-max-size=9 --enable-uct-value-type=float"
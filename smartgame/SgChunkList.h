@@ -0,0 +1,203 @@
+//----------------------------------------------------------------------------
+/** @file SgChunkList.h
+    Growable list with stable element addresses. */
+//----------------------------------------------------------------------------
+
+#ifndef SG_CHUNKLIST_H
+#define SG_CHUNKLIST_H
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+//----------------------------------------------------------------------------
+
+/** Growable list with stable element addresses.
+    Stores the elements in chunks of CHUNK_SIZE elements, which are
+    allocated when the list grows beyond its capacity and only freed in the
+    destructor. Pointers to elements stay valid, until the list is shrunk
+    below the element. Like in SgArrayList, elements need to have a default
+    constructor and operations like Clear() and Resize() do not call
+    destructors or constructors of elements, so elements reused after
+    shrinking the list keep their old values.
+    Unlike SgArrayList, the memory used depends on the maximum length the
+    list had, not on the maximum length the list can have. */
+template<typename T, int CHUNK_SIZE>
+class SgChunkList
+{
+public:
+    SgChunkList();
+
+    ~SgChunkList();
+
+    T& operator[](int index);
+
+    const T& operator[](int index) const;
+
+    /** Number of elements that fit into the allocated chunks. */
+    int Capacity() const;
+
+    void Clear();
+
+    /** Index of an element given its address.
+        Needs a binary search over the chunks. Used for translating
+        pointers to elements between copies of a list.
+        @param element The address of an element of this list with an
+        index smaller than Length() */
+    int Index(const T* element) const;
+
+    bool IsEmpty() const;
+
+    T& Last();
+
+    const T& Last() const;
+
+    int Length() const;
+
+    void PopBack();
+
+    /** Change the length of the list.
+        Allocates chunks if the new length is larger than the capacity. */
+    void Resize(int length);
+
+private:
+    int m_length;
+
+    int m_capacity;
+
+    std::vector<T*> m_chunks;
+
+    /** Chunk start addresses and chunk numbers sorted by address.
+        See Index() */
+    std::vector<std::pair<const T*,int> > m_sortedChunks;
+
+    T& Get(int index) const;
+
+    /** Not implemented. */
+    SgChunkList(const SgChunkList&);
+
+    /** Not implemented. */
+    SgChunkList& operator=(const SgChunkList&);
+};
+
+template<typename T, int CHUNK_SIZE>
+inline SgChunkList<T,CHUNK_SIZE>::SgChunkList()
+    : m_length(0),
+      m_capacity(0)
+{ }
+
+template<typename T, int CHUNK_SIZE>
+SgChunkList<T,CHUNK_SIZE>::~SgChunkList()
+{
+    for (typename std::vector<T*>::iterator it = m_chunks.begin();
+         it != m_chunks.end(); ++it)
+        delete[] *it;
+}
+
+template<typename T, int CHUNK_SIZE>
+inline T& SgChunkList<T,CHUNK_SIZE>::operator[](int index)
+{
+    SG_ASSERT(index >= 0);
+    SG_ASSERT(index < m_length);
+    return Get(index);
+}
+
+template<typename T, int CHUNK_SIZE>
+inline const T& SgChunkList<T,CHUNK_SIZE>::operator[](int index) const
+{
+    SG_ASSERT(index >= 0);
+    SG_ASSERT(index < m_length);
+    return Get(index);
+}
+
+template<typename T, int CHUNK_SIZE>
+inline int SgChunkList<T,CHUNK_SIZE>::Capacity() const
+{
+    return m_capacity;
+}
+
+template<typename T, int CHUNK_SIZE>
+inline void SgChunkList<T,CHUNK_SIZE>::Clear()
+{
+    m_length = 0;
+}
+
+template<typename T, int CHUNK_SIZE>
+inline T& SgChunkList<T,CHUNK_SIZE>::Get(int index) const
+{
+    // Unsigned division, which is a shift for a power of two CHUNK_SIZE
+    const unsigned int i = static_cast<unsigned int>(index);
+    return m_chunks[i / CHUNK_SIZE][i % CHUNK_SIZE];
+}
+
+template<typename T, int CHUNK_SIZE>
+int SgChunkList<T,CHUNK_SIZE>::Index(const T* element) const
+{
+    // Last chunk with a start address not greater than element
+    typename std::vector<std::pair<const T*,int> >::const_iterator it =
+        std::upper_bound(m_sortedChunks.begin(), m_sortedChunks.end(),
+                         std::make_pair(element, static_cast<int>(
+                                                     m_chunks.size())));
+    SG_ASSERT(it != m_sortedChunks.begin());
+    --it;
+    SG_ASSERT(element - it->first < CHUNK_SIZE);
+    const int index = it->second * CHUNK_SIZE
+        + static_cast<int>(element - it->first);
+    SG_ASSERT(index < m_length);
+    return index;
+}
+
+template<typename T, int CHUNK_SIZE>
+inline bool SgChunkList<T,CHUNK_SIZE>::IsEmpty() const
+{
+    return m_length == 0;
+}
+
+template<typename T, int CHUNK_SIZE>
+inline T& SgChunkList<T,CHUNK_SIZE>::Last()
+{
+    SG_ASSERT(m_length > 0);
+    return Get(m_length - 1);
+}
+
+template<typename T, int CHUNK_SIZE>
+inline const T& SgChunkList<T,CHUNK_SIZE>::Last() const
+{
+    SG_ASSERT(m_length > 0);
+    return Get(m_length - 1);
+}
+
+template<typename T, int CHUNK_SIZE>
+inline int SgChunkList<T,CHUNK_SIZE>::Length() const
+{
+    return m_length;
+}
+
+template<typename T, int CHUNK_SIZE>
+inline void SgChunkList<T,CHUNK_SIZE>::PopBack()
+{
+    SG_ASSERT(m_length > 0);
+    --m_length;
+}
+
+template<typename T, int CHUNK_SIZE>
+inline void SgChunkList<T,CHUNK_SIZE>::Resize(int length)
+{
+    SG_ASSERT(length >= 0);
+    while (length > m_capacity)
+    {
+        T* chunk = new T[CHUNK_SIZE];
+        std::pair<const T*,int> entry(chunk,
+                                      static_cast<int>(m_chunks.size()));
+        m_sortedChunks.insert(std::upper_bound(m_sortedChunks.begin(),
+                                               m_sortedChunks.end(), entry),
+                              entry);
+        m_chunks.push_back(chunk);
+        m_capacity += CHUNK_SIZE;
+    }
+    m_length = length;
+}
+
+//----------------------------------------------------------------------------
+
+#endif // SG_CHUNKLIST_H
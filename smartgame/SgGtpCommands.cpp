@@ -33,6 +33,16 @@ string ParseCpuTimeId(const GtpCommand& cmd)
     return "total";
 }
 
+SgRandomEngineType RandomEngineArg(const GtpCommand& cmd, size_t number)
+{
+    string arg = cmd.ArgToLower(number);
+    SgRandomEngineType engine;
+    if (! SgRandomEngineTypeFromStr(arg.c_str(), engine))
+        throw GtpFailure() << "unknown random engine argument \"" << arg
+                           << '"';
+    return engine;
+}
+
 SgTimeMode TimeModeArg(const GtpCommand& cmd, size_t number)
 {
     string arg = cmd.ArgToLower(number);
@@ -211,6 +221,7 @@ void SgGtpCommands::CmdGetRandomSeed(GtpCommand& cmd)
 
 /** Set global parameters used in module SmartGame.
     Parameters:
+    @arg @c random_engine mt19937|xoshiro128|pcg32 See SgRandom::SetEngine
     @arg @c time_mode cpu|real See SgTime */
 void SgGtpCommands::CmdParam(GtpCommand& cmd)
 {
@@ -219,13 +230,17 @@ void SgGtpCommands::CmdParam(GtpCommand& cmd)
     {
         // Boolean parameters first for better layout of GoGui parameter
         // dialog, alphabetically otherwise
-        cmd << "[list/cpu/real] time_mode "
+        cmd << "[list/mt19937/xoshiro128/pcg32] random_engine "
+            << SgRandomEngineTypeStr(SgRandom::Engine()) << '\n'
+            << "[list/cpu/real] time_mode "
             << TimeModeToString(SgTime::DefaultMode()) << '\n';
     }
     else if (cmd.NuArg() >= 1 && cmd.NuArg() <= 2)
     {
         string name = cmd.Arg(0);
-        if (name == "time_mode")
+        if (name == "random_engine")
+            SgRandom::SetEngine(RandomEngineArg(cmd, 1));
+        else if (name == "time_mode")
             SgTime::SetDefaultMode(TimeModeArg(cmd, 1));
         else
             throw GtpFailure() << "unknown parameter: " << name;
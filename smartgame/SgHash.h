@@ -11,24 +11,31 @@
 #define SG_HASH_H
 
 #include <algorithm>
-#include <bitset>
 #include <iomanip>
 #include <iostream>
 #include <sstream>
+#include <stdint.h>
+#include <boost/static_assert.hpp>
 #include "SgArray.h"
 #include "SgException.h"
 #include "SgRandom.h"
 
 //----------------------------------------------------------------------------
 
-/** N-bit hash codes */
+/** N-bit hash codes.
+    N must be a multiple of 64. The code is stored in 64-bit words and the
+    loops over the words have a constant number of iterations, so the
+    operations of SgHash<64> and SgHash<128> compile to one or two integer
+    operations without branches. */
 template<int N>
 class SgHash
 {
 public:
     /** Construct hash code initialized with zero. */
     SgHash()
-    { }
+    {
+        Clear();
+    }
 
     /** Construct hash code from integer index */
     SgHash(unsigned int key);
@@ -54,7 +61,9 @@ public:
     /** Combine this hash code with the given hash code. */
     void Xor(const SgHash& code);
 
-    /** Use this hash code to hash into a table with 'max' elements. */
+    /** Use this hash code to hash into a table with 'max' elements.
+        Maps the lowest 32 bits to [0..max - 1] with a multiplication and a
+        shift instead of a division. */
     unsigned int Hash(int max) const;
 
     /** First integer (deprecated).
@@ -71,10 +80,12 @@ public:
         @return A random hash code, which is not zero. */
     static SgHash Random();
 
-    /** Roll bits n places to the left */
+    /** Roll bits n places to the left.
+        @param n In [0..N - 1] */
     void RollLeft(int n);
 
-    /** Roll bits n places to the right */
+    /** Roll bits n places to the right.
+        @param n In [0..N - 1] */
     void RollRight(int n);
 
     /** Convert hash code to string */
@@ -86,12 +97,21 @@ public:
     static int Size();
 
 private:
+    typedef uint64_t Word;
+
+    static const int NU_WORDS = N / 64;
+
+    BOOST_STATIC_ASSERT(N > 0 && N % 64 == 0);
+
+    /** The words of the code, least significant word first. */
+    Word m_code[NU_WORDS];
+
     /** Thomas Wang's 32 bit mix function */
     unsigned int Mix32(int key) const;
 
-    unsigned int GetWord() const;
-
-    std::bitset<N> m_code;
+    /** Shift bits n places to the left.
+        @param n In [1..63] */
+    void ShiftLeft(int n);
 };
 
 /** For backwards compatibility */
@@ -99,62 +119,62 @@ typedef SgHash<64> SgHashCode;
 
 template<int N>
 SgHash<N>::SgHash(unsigned int key)
-    : m_code(Mix32(key))
 {
     // Use Thomas Wang's 32 bit mix function, cyclically
+    Clear();
+    m_code[0] = Mix32(key);
     for (int i = 1; i < (N / 32); ++i)
     {
-        unsigned int mix = Mix32(GetWord());
-        m_code <<= 32;
-        m_code |= mix;
+        unsigned int mix = Mix32(Code1());
+        ShiftLeft(32);
+        m_code[0] |= mix;
     }
 }
 
 template<int N>
-bool SgHash<N>::operator<(const SgHash& code) const
+inline bool SgHash<N>::operator<(const SgHash& code) const
 {
-    // std::bitset does not define operator<, so we have to do it (less
-    // efficiently) ourselves
-    for (int i = N - 1; i >= 0; --i)
-    {
-        bool c1 = m_code[i];
-        bool c2 = code.m_code[i];
-        if (! c1 && c2)
-            return true;
-        if (c1 && ! c2)
-            return false;
-    }
-    return false;
+    // Same order as the comparison of the N-bit numbers. A difference in a
+    // more significant word overrides the result of the lower words.
+    bool isLess = false;
+    for (int i = 0; i < NU_WORDS; ++i)
+        isLess = (m_code[i] < code.m_code[i])
+                 | ((m_code[i] == code.m_code[i]) & isLess);
+    return isLess;
 }
 
 template<int N>
-bool SgHash<N>::operator==(const SgHash& code) const
+inline bool SgHash<N>::operator==(const SgHash& code) const
 {
-    return code.m_code == m_code;
+    Word diff = 0;
+    for (int i = 0; i < NU_WORDS; ++i)
+        diff |= m_code[i] ^ code.m_code[i];
+    return diff == 0;
 }
 
 template<int N>
-bool SgHash<N>::operator!=(const SgHash& code) const
+inline bool SgHash<N>::operator!=(const SgHash& code) const
 {
-    return code.m_code != m_code;
+    return ! operator==(code);
 }
 
 template<int N>
-void SgHash<N>::Clear()
+inline void SgHash<N>::Clear()
 {
-    m_code.reset();
+    for (int i = 0; i < NU_WORDS; ++i)
+        m_code[i] = 0;
 }
 
 template<int N>
-unsigned int SgHash<N>::Code1() const
+inline unsigned int SgHash<N>::Code1() const
 {
-    return GetWord();
+    return static_cast<unsigned int>(m_code[0]);
 }
 
 template<int N>
-unsigned int SgHash<N>::Code2() const
+inline unsigned int SgHash<N>::Code2() const
 {
-    return (m_code >> 32).to_ulong();
+    return static_cast<unsigned int>(m_code[0] >> 32);
 }
 
 template<int N>
@@ -164,29 +184,24 @@ void SgHash<N>::FromString(const std::string& str)
     for (std::string::const_iterator i_str = str.begin();
         i_str != str.end(); ++i_str)
     {
-        m_code <<= 4;
+        ShiftLeft(4);
         char c = *i_str;
         if (c >= '0' && c <= '9')
-            m_code |= std::bitset<N>(c - '0');
+            m_code[0] |= Word(c - '0');
         else if (c >= 'A' && c <= 'F')
-            m_code |= std::bitset<N>(10 + c - 'A');
+            m_code[0] |= Word(10 + c - 'A');
         else if (c >= 'a' && c <= 'f')
-            m_code |= std::bitset<N>(10 + c - 'a');
+            m_code[0] |= Word(10 + c - 'a');
         else throw SgException("Bad hex in hash string");
     }
 }
 
 template<int N>
-unsigned int SgHash<N>::GetWord() const
+inline unsigned int SgHash<N>::Hash(int max) const
 {
-    static const std::bitset<N> mask(0xffffffffUL);
-    return static_cast<unsigned int>((m_code & mask).to_ulong());
-}
-
-template<int N>
-unsigned int SgHash<N>::Hash(int max) const
-{
-    return GetWord() % max;
+    SG_ASSERT(max > 0);
+    return static_cast<unsigned int>(((m_code[0] & 0xffffffffULL)
+                                      * static_cast<Word>(max)) >> 32);
 }
 
 template<int N>
@@ -196,9 +211,12 @@ void SgHash<N>::Invalidate()
 }
 
 template<int N>
-bool SgHash<N>::IsZero() const
+inline bool SgHash<N>::IsZero() const
 {
-    return m_code.none();
+    Word bits = 0;
+    for (int i = 0; i < NU_WORDS; ++i)
+        bits |= m_code[i];
+    return bits == 0;
 }
 
 template<int N>
@@ -217,11 +235,11 @@ template<int N>
 SgHash<N> SgHash<N>::Random()
 {
     SgHash hashcode;
-    hashcode.m_code = SgRandom::Global().Int();
+    hashcode.m_code[0] = SgRandom::Global().Int();
     for (int i = 1; i < (N / 32); ++i)
     {
-        hashcode.m_code <<= 32;
-        hashcode.m_code |= SgRandom::Global().Int();
+        hashcode.ShiftLeft(32);
+        hashcode.m_code[0] |= SgRandom::Global().Int();
     }
 
     return hashcode;
@@ -230,13 +248,38 @@ SgHash<N> SgHash<N>::Random()
 template<int N>
 void SgHash<N>::RollLeft(int n)
 {
-    m_code = (m_code << n) ^ (m_code >> (N - n));
+    SG_ASSERT(n >= 0 && n < N);
+    const SgHash old(*this);
+    const int wordShift = n / 64;
+    const int bitShift = n % 64;
+    for (int i = 0; i < NU_WORDS; ++i)
+    {
+        const Word w = old.m_code[(i - wordShift + NU_WORDS) % NU_WORDS];
+        if (bitShift == 0)
+            m_code[i] = w;
+        else
+        {
+            const Word lower =
+                old.m_code[(i - wordShift - 1 + 2 * NU_WORDS) % NU_WORDS];
+            m_code[i] = (w << bitShift) | (lower >> (64 - bitShift));
+        }
+    }
 }
 
 template<int N>
 void SgHash<N>::RollRight(int n)
 {
-    m_code = (m_code >> n) ^ (m_code << (N - n));
+    SG_ASSERT(n >= 0 && n < N);
+    RollLeft(n == 0 ? 0 : N - n);
+}
+
+template<int N>
+inline void SgHash<N>::ShiftLeft(int n)
+{
+    SG_ASSERT(n > 0 && n < 64);
+    for (int i = NU_WORDS - 1; i > 0; --i)
+        m_code[i] = (m_code[i] << n) | (m_code[i - 1] >> (64 - n));
+    m_code[0] <<= n;
 }
 
 template<int N>
@@ -250,19 +293,16 @@ std::string SgHash<N>::ToString() const
 {
     std::ostringstream buffer;
     buffer.fill('0');
-    std::bitset<N> mask(0xff);
-    for (int i = (N + 7) / 8 - 1; i >= 0; --i)
-    {
-        std::bitset<N> b = ((m_code >> (i * 8)) & mask);
-        buffer << std::hex << std::setw(2) << b.to_ulong();
-    }
+    for (int i = NU_WORDS - 1; i >= 0; --i)
+        buffer << std::hex << std::setw(16) << m_code[i];
     return buffer.str();
 }
 
 template<int N>
-void SgHash<N>::Xor(const SgHash& code)
+inline void SgHash<N>::Xor(const SgHash& code)
 {
-    m_code ^= code.m_code;
+    for (int i = 0; i < NU_WORDS; ++i)
+        m_code[i] ^= code.m_code[i];
 }
 
 template<int N>
@@ -47,10 +47,7 @@ SgPointSet SgPointSet::Border(int boardSize) const
 
 SgPointSet SgPointSet::BorderNoClip() const
 {
-    SgPointSet bd = (*this >> SG_NS);
-    bd |= (*this << SG_NS);
-    bd |= (*this >> SG_WE);
-    bd |= (*this << SG_WE);
+    SgPointSet bd = Nb4NoClip();
     bd -= (*this);
     return bd;
 }
@@ -62,7 +59,7 @@ SgPointSet SgPointSet::Component(SgPoint p) const
     SgPointSet* a = &set1, *b = &set2;
     do
     {
-        *b = *a | (a->BorderNoClip() & (*this));
+        *b = *a | (a->Nb4NoClip() & (*this));
         swap(a, b); // swap pointers, not sets.
     } while (set1 != set2);
     return set1;
@@ -154,20 +151,14 @@ void SgPointSet::Write(ostream& out, int boardSize) const
 
 void SgPointSet::Grow(int boardSize)
 {
-    SgPointSet bd = (*this >> SG_NS);
-    bd |= (*this << SG_NS);
-    bd |= (*this >> SG_WE);
-    bd |= (*this << SG_WE);
+    SgPointSet bd = Nb4NoClip();
     bd &= AllPoints(boardSize);
     *this |= bd;
 }
 
 void SgPointSet::Grow(SgPointSet* newArea, int boardSize)
 {
-    *newArea  = (*this >> SG_NS);
-    *newArea |= (*this << SG_NS);
-    *newArea |= (*this >> SG_WE);
-    *newArea |= (*this << SG_WE);
+    *newArea = Nb4NoClip();
     *newArea &= AllPoints(boardSize);
     *newArea ^= (*this);
     *this |= *newArea;
@@ -253,11 +244,7 @@ SgPointSet SgPointSet::Kernel(int boardSize) const
     // and subtracting that from the given set.
     // @todo would direct implementation be faster?
     SgPointSet k = AllPoints(boardSize) - (*this);
-    SgPointSet bd = (k >> SG_NS);
-    bd |= (k << SG_NS);
-    bd |= (k >> SG_WE);
-    bd |= (k << SG_WE);
-    return (*this) - bd;
+    return (*this) - k.Nb4NoClip();
 }
 
 SgPoint SgPointSet::PointOf() const
@@ -7,10 +7,11 @@
 #define SG_POINTSET_H
 
 #include <algorithm>
-#include <bitset>
 #include <cstring>
 #include <iosfwd>
 #include <memory>
+#include <stdint.h>
+#include <boost/static_assert.hpp>
 #include "SgArray.h"
 #include "SgPoint.h"
 #include "SgRect.h"
@@ -20,7 +21,10 @@
 
 /** Set of points.
     Represents a set of points on the Go board. This class is efficient for
-    bit-level operations on the board as a whole. */
+    bit-level operations on the board as a whole.
+    The points are stored in an array of 64-bit words. The loops over the
+    words have a constant number of iterations, so the compiler can unroll
+    and vectorize them for the instruction set of the target. */
 class SgPointSet
 {
 public:
@@ -194,14 +198,38 @@ private:
 
     friend class SgSetIterator;
 
-    std::bitset<SG_MAXPOINT> m_a;
+    typedef uint64_t Word;
+
+    static const int NU_WORDS = (SG_MAXPOINT + 63) / 64;
+
+    /** Mask of the bits of the last word that are points.
+        The other bits are always zero. */
+    static const Word LAST_WORD_MASK =
+        ~Word(0) >> (64 * NU_WORDS - SG_MAXPOINT);
+
+    BOOST_STATIC_ASSERT(SG_NS + SG_WE < 64);
+
+    /** Bit p % 64 of word p / 64 is set, if point p is in the set. */
+    Word m_a[NU_WORDS];
 
     static PrecompAllPoints s_allPoints;
 
+    /** Shift towards lower points.
+        @param n In [1..63] */
     SgPointSet operator>>(int n) const;
 
+    /** Shift towards higher points.
+        @param n In [1..63] */
     SgPointSet operator<<(int n) const;
 
+    /** 4-Neighbor points of the points of the set, including points in the
+        set that have a neighbor in the set.
+        Computes the four shifts in a single pass over the words. */
+    SgPointSet Nb4NoClip() const;
+
+    static int CountBits(Word w);
+
+    static int LowestBit(Word w);
 };
 
 
@@ -234,48 +262,85 @@ inline SgPointSet operator^(const SgPointSet& L, const SgPointSet& R)
 }
 
 inline SgPointSet::SgPointSet()
-{ }
+{
+    Clear();
+}
 
 inline SgPointSet::~SgPointSet()
 { }
 
+inline int SgPointSet::CountBits(Word w)
+{
+#ifdef __GNUC__
+    return __builtin_popcountll(w);
+#else
+    w = w - ((w >> 1) & 0x5555555555555555ULL);
+    w = (w & 0x3333333333333333ULL) + ((w >> 2) & 0x3333333333333333ULL);
+    w = (w + (w >> 4)) & 0x0f0f0f0f0f0f0f0fULL;
+    return static_cast<int>((w * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+inline int SgPointSet::LowestBit(Word w)
+{
+    SG_ASSERT(w != 0);
+#ifdef __GNUC__
+    return __builtin_ctzll(w);
+#else
+    int i = 0;
+    while ((w & 1) == 0)
+    {
+        w >>= 1;
+        ++i;
+    }
+    return i;
+#endif
+}
+
 inline void SgPointSet::Swap(SgPointSet& other) throw()
 {
-    std::swap(m_a, other.m_a);
+    std::swap_ranges(m_a, m_a + NU_WORDS, other.m_a);
 }
 
 inline SgPointSet& SgPointSet::operator-=(const SgPointSet& other)
 {
-    m_a &= ~other.m_a;
+    for (int i = 0; i < NU_WORDS; ++i)
+        m_a[i] &= ~other.m_a[i];
     return (*this);
 }
 
 inline SgPointSet& SgPointSet::operator&=(const SgPointSet& other)
 {
-    m_a &= other.m_a;
+    for (int i = 0; i < NU_WORDS; ++i)
+        m_a[i] &= other.m_a[i];
     return (*this);
 }
 
 inline SgPointSet& SgPointSet::operator|=(const SgPointSet& other)
 {
-    m_a |= other.m_a;
+    for (int i = 0; i < NU_WORDS; ++i)
+        m_a[i] |= other.m_a[i];
     return (*this);
 }
 
 inline SgPointSet& SgPointSet::operator^=(const SgPointSet& other)
 {
-    m_a ^= other.m_a;
+    for (int i = 0; i < NU_WORDS; ++i)
+        m_a[i] ^= other.m_a[i];
     return (*this);
 }
 
 inline bool SgPointSet::operator==(const SgPointSet& other) const
 {
-    return m_a == other.m_a;
+    Word diff = 0;
+    for (int i = 0; i < NU_WORDS; ++i)
+        diff |= m_a[i] ^ other.m_a[i];
+    return diff == 0;
 }
 
 inline bool SgPointSet::operator!=(const SgPointSet& other) const
 {
-    return m_a != other.m_a;
+    return ! operator==(other);
 }
 
 inline const SgPointSet& SgPointSet::AllPoints(int boardSize)
@@ -285,14 +350,18 @@ inline const SgPointSet& SgPointSet::AllPoints(int boardSize)
 
 inline bool SgPointSet::Overlaps(const SgPointSet& other) const
 {
-    return (m_a & other.m_a).any();
+    Word common = 0;
+    for (int i = 0; i < NU_WORDS; ++i)
+        common |= m_a[i] & other.m_a[i];
+    return common != 0;
 }
 
 inline bool SgPointSet::MaxOverlap(const SgPointSet& other, int max) const
 {
-    SgPointSet s(*this);
-    s &= other;
-    return s.Size() <= max;
+    int size = 0;
+    for (int i = 0; i < NU_WORDS; ++i)
+        size += CountBits(m_a[i] & other.m_a[i]);
+    return size <= max;
 }
 
 inline bool SgPointSet::MinOverlap(const SgPointSet& s, int min) const
@@ -325,22 +394,31 @@ inline bool SgPointSet::Adjacent8To(SgPoint p) const
 
 inline bool SgPointSet::SubsetOf(const SgPointSet& other) const
 {
-    return (m_a & ~other.m_a).none();
+    Word extra = 0;
+    for (int i = 0; i < NU_WORDS; ++i)
+        extra |= m_a[i] & ~other.m_a[i];
+    return extra == 0;
 }
 
 inline bool SgPointSet::SupersetOf(const SgPointSet& other) const
 {
-    return (other.m_a & ~m_a).none();
+    return other.SubsetOf(*this);
 }
 
 inline int SgPointSet::Size() const
 {
-    return static_cast<int>(m_a.count());
+    int size = 0;
+    for (int i = 0; i < NU_WORDS; ++i)
+        size += CountBits(m_a[i]);
+    return size;
 }
 
 inline bool SgPointSet::IsEmpty() const
 {
-    return m_a.none();
+    Word bits = 0;
+    for (int i = 0; i < NU_WORDS; ++i)
+        bits |= m_a[i];
+    return bits == 0;
 }
 
 inline bool SgPointSet::NonEmpty() const
@@ -351,33 +429,35 @@ inline bool SgPointSet::NonEmpty() const
 inline SgPointSet& SgPointSet::Exclude(SgPoint p)
 {
     SG_ASSERT_BOARDRANGE(p);
-    m_a.reset(p); 
+    m_a[p / 64] &= ~(Word(1) << (p % 64));
     return (*this);
 }
 
 inline SgPointSet& SgPointSet::Include(SgPoint p)
 {
     SG_ASSERT_BOARDRANGE(p);
-    m_a.set(p);
+    m_a[p / 64] |= Word(1) << (p % 64);
     return (*this);
 }
 
 inline SgPointSet& SgPointSet::Clear()
 {
-    m_a.reset();
+    for (int i = 0; i < NU_WORDS; ++i)
+        m_a[i] = 0;
     return *this;
 }
 
 inline SgPointSet& SgPointSet::Toggle(SgPoint p)
 {
-    SG_ASSERT(p < static_cast<int>(m_a.size()));
-    m_a.flip(p);
+    SG_ASSERT(p >= 0 && p < SG_MAXPOINT);
+    m_a[p / 64] ^= Word(1) << (p % 64);
     return (*this);
 }
 
 inline bool SgPointSet::Contains(SgPoint p) const
 {
-    return m_a.test(p);
+    SG_ASSERT(p >= 0 && p < SG_MAXPOINT);
+    return ((m_a[p / 64] >> (p % 64)) & 1) != 0;
 }
 
 inline bool SgPointSet::CheckedContains(SgPoint p, bool doRangeCheck,
@@ -392,7 +472,7 @@ inline bool SgPointSet::CheckedContains(SgPoint p, bool doRangeCheck,
             SG_ASSERTRANGE(p, SgPointUtil::Pt(0, 0),
                            SgPointUtil::Pt(SG_MAX_SIZE + 1, SG_MAX_SIZE + 1));
     }
-    return m_a.test(p);
+    return Contains(p);
 }
 
 inline bool SgPointSet::ContainsPoint(SgPoint p) const
@@ -418,15 +498,40 @@ inline bool SgPointSet::NewMark(SgPoint p)
 
 inline SgPointSet SgPointSet::operator>>(int n) const
 {
-    SgPointSet result(*this);
-    result.m_a >>= n;
+    SG_ASSERT(n > 0 && n < 64);
+    SgPointSet result;
+    for (int i = 0; i < NU_WORDS - 1; ++i)
+        result.m_a[i] = (m_a[i] >> n) | (m_a[i + 1] << (64 - n));
+    result.m_a[NU_WORDS - 1] = m_a[NU_WORDS - 1] >> n;
     return result;
 }
 
 inline SgPointSet SgPointSet::operator<<(int n) const
 {
-    SgPointSet result(*this);
-    result.m_a <<= n;
+    SG_ASSERT(n > 0 && n < 64);
+    SgPointSet result;
+    result.m_a[0] = m_a[0] << n;
+    for (int i = 1; i < NU_WORDS; ++i)
+        result.m_a[i] = (m_a[i] << n) | (m_a[i - 1] >> (64 - n));
+    result.m_a[NU_WORDS - 1] &= LAST_WORD_MASK;
+    return result;
+}
+
+inline SgPointSet SgPointSet::Nb4NoClip() const
+{
+    SgPointSet result;
+    for (int i = 0; i < NU_WORDS; ++i)
+    {
+        const Word w = m_a[i];
+        const Word lower = (i > 0 ? m_a[i - 1] : 0);
+        const Word higher = (i < NU_WORDS - 1 ? m_a[i + 1] : 0);
+        result.m_a[i] =
+            (w << SG_WE) | (lower >> (64 - SG_WE))
+            | (w >> SG_WE) | (higher << (64 - SG_WE))
+            | (w << SG_NS) | (lower >> (64 - SG_NS))
+            | (w >> SG_NS) | (higher << (64 - SG_NS));
+    }
+    result.m_a[NU_WORDS - 1] &= LAST_WORD_MASK;
     return result;
 }
 
@@ -483,7 +588,7 @@ inline SgPoint SgSetIterator::operator*() const
 {
     SG_ASSERT(m_index <= Size());
     SG_ASSERT_BOARDRANGE(m_index);
-    SG_ASSERT(m_set.m_a.test(m_index));
+    SG_ASSERT(m_set.Contains(m_index));
     return m_index;
 }
 
@@ -494,17 +599,26 @@ inline SgSetIterator::operator bool() const
 
 inline void SgSetIterator::FindNext()
 {
-    int size = Size();
-    do
+    // Skip the empty words and find the lowest bit in the next non-empty
+    // word
+    ++m_index;
+    while (m_index < SG_MAXPOINT)
     {
-        ++m_index;
+        const int word = m_index / 64;
+        const SgPointSet::Word bits = m_set.m_a[word] >> (m_index % 64);
+        if (bits != 0)
+        {
+            m_index += SgPointSet::LowestBit(bits);
+            return;
+        }
+        m_index = (word + 1) * 64;
     }
-    while (m_index < size && ! m_set.m_a.test(m_index));
+    m_index = SG_MAXPOINT;
 }
 
 inline int SgSetIterator::Size() const
 {
-    return static_cast<int>(m_set.m_a.size());
+    return SG_MAXPOINT;
 }
 
 //----------------------------------------------------------------------------
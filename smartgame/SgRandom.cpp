@@ -15,11 +15,16 @@
 SgRandom::GlobalData::GlobalData()
 {
     m_seed = 0;
+    m_engine = SG_RANDOM_MT19937;
 }
 
 //----------------------------------------------------------------------------
 
-SgRandom::SgRandom() : m_floatGenerator(m_generator)
+SgRandom::SgRandom()
+    : m_engine(GetGlobalData().m_engine),
+      m_floatGenerator(m_generator),
+      m_stream(0),
+      m_subStream(0)
 {
     SetSeed();
     GetGlobalData().m_allGenerators.push_back(this);
@@ -47,12 +52,59 @@ int SgRandom::Seed()
     return GetGlobalData().m_seed;
 }
 
+SgRandomEngineType SgRandom::Engine()
+{
+    return GetGlobalData().m_engine;
+}
+
+void SgRandom::SetEngine(SgRandomEngineType engine)
+{
+    GetGlobalData().m_engine = engine;
+    for (const auto& generator : GetGlobalData().m_allGenerators)
+    {
+        generator->SetSeed();
+    }
+}
+
 void SgRandom::SetSeed()
 {
+    m_engine = GetGlobalData().m_engine;
     boost::mt19937::result_type seed = GetGlobalData().m_seed;
     if (seed == 0)
-        return;
-    m_generator.seed(seed);
+    {
+        if (m_stream == 0 && m_subStream == 0)
+            return;
+        seed = boost::mt19937::default_seed;
+    }
+    switch (m_engine)
+    {
+    case SG_RANDOM_XOSHIRO128:
+        m_xoshiro.Seed(seed);
+        for (unsigned int i = 0; i < m_stream; ++i)
+            m_xoshiro.LongJump();
+        for (unsigned int i = 0; i < m_subStream; ++i)
+            m_xoshiro.Jump();
+        break;
+    case SG_RANDOM_PCG32:
+        // Streams are 2^48 numbers apart, sub-streams 2^36
+        SG_ASSERT(m_subStream < (1 << 12));
+        m_pcg.Seed(seed);
+        m_pcg.Advance((uint64_t(m_stream) << 48)
+                      + (uint64_t(m_subStream) << 36));
+        break;
+    default:
+        // Golden ratio increments spread the seeds of consecutive streams
+        m_generator.seed(seed + m_stream * 0x9e3779b9U
+                         + m_subStream * 0x7f4a7c15U);
+        break;
+    }
+}
+
+void SgRandom::SetStream(unsigned int stream, unsigned int subStream)
+{
+    m_stream = stream;
+    m_subStream = subStream;
+    SetSeed();
 }
 
 void SgRandom::SetSeed(int seed)
@@ -11,14 +11,17 @@
 #include <boost/random/mersenne_twister.hpp>
 #include <boost/random/uniform_01.hpp>
 #include "SgArray.h"
+#include "SgRandomEngine.h"
 
 //----------------------------------------------------------------------------
 
 /** Random number generator.
-    Uses a Mersenne Twister, because this is faster than std::rand() and
+    Uses a Mersenne Twister (default) or one of the faster engines in
+    SgRandomEngine.h, because these are faster than std::rand() and
     game playing programs usually need faster random numbers more than
     high quality ones. All random generators are internally registered to
-    make it possible to change the random seed for all of them.
+    make it possible to change the random seed and the engine for all of
+    them.
 
     SgRandom is thread-safe (w.r.t. different instances) after construction
     (the constructor is not thread-safe, because it uses a global variable
@@ -49,6 +52,33 @@ public:
         See SetSeed(int) for the special meaning of zero and negative values. */
     static int Seed();
 
+    /** Set the engine for all existing and future instances of SgRandom.
+        Existing instances are seeded again with the current seed.
+        @note This function is not thread-safe. */
+    static void SetEngine(SgRandomEngineType engine);
+
+    /** Get the engine used by all instances. */
+    static SgRandomEngineType Engine();
+
+    /** Select a random number stream for this generator.
+        Generators with different stream numbers are seeded differently from
+        the same global seed (see SetSeed(int)), so that several generators
+        used at the same time (e.g. by different search threads) do not
+        produce the same sequence of random numbers. The stream numbers are
+        kept if the global seed is changed later. Stream zero is the default
+        and uses the global seed unchanged.
+        For the engines xoshiro128 and pcg32, the streams are
+        non-overlapping parts of the sequence of the global seed, reached
+        by jump-ahead. The engine mt19937 does not support jump-ahead and
+        derives a different seed for each stream.
+        @param stream The stream, e.g. the number of a search thread.
+        For xoshiro128, the cost of this function is linear in @c stream.
+        @param subStream A stream within @c stream, e.g. the slot in a
+        lockstep playout batch of a thread. For xoshiro128, the cost is
+        linear in @c subStream, for pcg32, it must be less than 4096.
+        @note This function is not thread-safe. */
+    void SetStream(unsigned int stream, unsigned int subStream = 0);
+
     /** Generate a float number in [0,range). */
     float Float(float range);
 
@@ -56,12 +86,14 @@ public:
     float Float_01();
     
     /** Get a random integer.
-        Uses a fast random generator (the Mersenne Twister boost::mt19937),
-        because in games and Monte Carlo simulations, speed is more important
-        than quality. */
+        Uses the engine selected with SetEngine(). All engines are fast
+        generators, because in games and Monte Carlo simulations, speed is
+        more important than quality. */
     unsigned int Int();
 
     /** Get a random integer in an interval.
+        Unbiased (uses Lemire's multiply-shift method with rejection) and
+        does not need a division in most cases.
         @param range The upper limit of the interval (exclusive)
         @pre range > 0
         @pre range <= SgRandom::Max()
@@ -72,8 +104,8 @@ public:
     std::size_t Int(std::size_t range);
     
     /** Get a small random integer in an interval.
-        Uses only the lower 16 bits. Faster than SgRandom::Int(int) because it
-        avoids the expensive modulo operation.
+        Same as SgRandom::Int(int), kept for compatibility and for documenting
+        that @c range is small.
         @param range The upper limit of the interval (exclusive)
         @pre range > 0
         @pre range <= (1 << 16)
@@ -104,6 +136,9 @@ private:
             Zero means not to set a random seed. */
         boost::mt19937::result_type m_seed;
 
+        /** See SetEngine() */
+        SgRandomEngineType m_engine;
+
         std::list<SgRandom*> m_allGenerators;
 
         GlobalData();
@@ -115,8 +150,15 @@ private:
         variables of other compilation units. */
     static GlobalData& GetGlobalData();
 
+    /** Copy of the global engine type, see SetEngine() */
+    SgRandomEngineType m_engine;
+
     boost::mt19937 m_generator;
 
+    SgXoshiro128 m_xoshiro;
+
+    SgPcg32 m_pcg;
+
     /*	Random number generator for Float() and Float_01(). 
     	Uses m_generator internally.
     	See http://www.boost.org/doc/libs/1_39_0/libs/random/
@@ -124,17 +166,48 @@ private:
 	*/
     boost::uniform_01<boost::mt19937, float> m_floatGenerator;
 
+    /** See SetStream() */
+    unsigned int m_stream;
+
+    /** See SetStream() */
+    unsigned int m_subStream;
+
     void SetSeed();
+
+    /** Unbiased random integer in <tt>[0..range - 1]</tt>. */
+    uint32_t Bounded(uint32_t range);
 };
 
+inline uint32_t SgRandom::Bounded(uint32_t range)
+{
+    SG_ASSERT(range > 0);
+    uint64_t m = uint64_t(Int()) * range;
+    uint32_t low = static_cast<uint32_t>(m);
+    if (low < range)
+    {
+        // Reject the values that would make some results more likely,
+        // threshold is 2^32 mod range
+        const uint32_t threshold = (0u - range) % range;
+        while (low < threshold)
+        {
+            m = uint64_t(Int()) * range;
+            low = static_cast<uint32_t>(m);
+        }
+    }
+    return static_cast<uint32_t>(m >> 32);
+}
+
 inline float SgRandom::Float_01()
 {
-    return m_floatGenerator();
+    if (m_engine == SG_RANDOM_MT19937)
+        return m_floatGenerator();
+    // Upper 24 bits give all floats of the form k / 2^24 in [0,1)
+    return float(Int() >> 8) * (1.f / 16777216.f);
 }
 
 inline float SgRandom::Float(float range)
 {
-    float v = m_floatGenerator() * range;
+    float v = Float_01() * range;
     SG_ASSERT(v <= range); 
     // @todo: should be < range? Worried about rounding issues.
     return v;
@@ -142,14 +215,22 @@ inline float SgRandom::Float(float range)
 
 inline unsigned int SgRandom::Int()
 {
-    return m_generator();
+    switch (m_engine)
+    {
+    case SG_RANDOM_XOSHIRO128:
+        return m_xoshiro();
+    case SG_RANDOM_PCG32:
+        return m_pcg();
+    default:
+        return m_generator();
+    }
 }
 
 inline int SgRandom::Int(int range)
 {
     SG_ASSERT(range > 0);
     SG_ASSERT(static_cast<unsigned int>(range) <= SgRandom::Max());
-    int i = Int() % range;
+    int i = static_cast<int>(Bounded(static_cast<uint32_t>(range)));
     SG_ASSERTRANGE(i, 0, range - 1);
     return i;
 }
@@ -157,19 +238,20 @@ inline int SgRandom::Int(int range)
 inline std::size_t SgRandom::Int(std::size_t range)
 {
     SG_ASSERT(range <= SgRandom::Max());
-    std::size_t i = Int() % range;
+    std::size_t i = Bounded(static_cast<uint32_t>(range));
     SG_ASSERT(i < range);
     return i;
 }
 
 inline unsigned int SgRandom::Max()
 {
-    return m_generator.max();
+    // All engines generate 32-bit numbers
+    return 0xffffffffU;
 }
 
 inline unsigned int SgRandom::PercentageThreshold(int percentage)
 {
-    return (m_generator.max() / 100) * percentage;
+    return (Max() / 100) * percentage;
 }
 
 inline bool SgRandom::RandomEvent(unsigned int threshold)
@@ -186,7 +268,7 @@ inline int SgRandom::SmallInt(int range)
 {
     SG_ASSERT(range > 0);
     SG_ASSERT(range <= (1 << 16));
-    int i = ((Int() & 0xffff) * range) >> 16;
+    int i = static_cast<int>(Bounded(static_cast<uint32_t>(range)));
     SG_ASSERTRANGE(i, 0, range - 1);
     return i;
 }
@@ -194,7 +276,7 @@ inline int SgRandom::SmallInt(int range)
 inline std::size_t SgRandom::SmallInt(std::size_t range)
 {
     SG_ASSERT(range <= (1 << 16));
-    std::size_t i = ((Int() & 0xffff) * range) >> 16;
+    std::size_t i = Bounded(static_cast<uint32_t>(range));
     SG_ASSERT(i < range);
     return i;
 }
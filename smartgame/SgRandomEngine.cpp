@@ -0,0 +1,119 @@
+//----------------------------------------------------------------------------
+/** @file SgRandomEngine.cpp
+    See SgRandomEngine.h. */
+//----------------------------------------------------------------------------
+
+#include "SgSystem.h"
+#include "SgRandomEngine.h"
+
+#include <cstring>
+
+//----------------------------------------------------------------------------
+
+const char* SgRandomEngineTypeStr(SgRandomEngineType type)
+{
+    switch (type)
+    {
+    case SG_RANDOM_MT19937:
+        return "mt19937";
+    case SG_RANDOM_XOSHIRO128:
+        return "xoshiro128";
+    case SG_RANDOM_PCG32:
+        return "pcg32";
+    default:
+        SG_ASSERT(false);
+        return "?";
+    }
+}
+
+bool SgRandomEngineTypeFromStr(const char* name, SgRandomEngineType& type)
+{
+    for (int i = 0; i < _SG_NU_RANDOM_ENGINE; ++i)
+    {
+        SgRandomEngineType t = static_cast<SgRandomEngineType>(i);
+        if (std::strcmp(name, SgRandomEngineTypeStr(t)) == 0)
+        {
+            type = t;
+            return true;
+        }
+    }
+    return false;
+}
+
+//----------------------------------------------------------------------------
+
+void SgXoshiro128::Seed(uint64_t seed)
+{
+    SgSplitMix64 splitMix(seed);
+    const uint64_t a = splitMix();
+    const uint64_t b = splitMix();
+    m_s[0] = static_cast<uint32_t>(a);
+    m_s[1] = static_cast<uint32_t>(a >> 32);
+    m_s[2] = static_cast<uint32_t>(b);
+    m_s[3] = static_cast<uint32_t>(b >> 32);
+    if (m_s[0] == 0 && m_s[1] == 0 && m_s[2] == 0 && m_s[3] == 0)
+        // The all-zero state is a fixed point
+        m_s[0] = 1;
+}
+
+void SgXoshiro128::Jump()
+{
+    static const uint32_t JUMP[4] =
+        { 0x8764000b, 0xf542d2d3, 0x6fa035c3, 0x77f2db5b };
+    Jump(JUMP);
+}
+
+void SgXoshiro128::LongJump()
+{
+    static const uint32_t LONG_JUMP[4] =
+        { 0xb523952e, 0x0b6f099f, 0xccf5a0ef, 0x1c580662 };
+    Jump(LONG_JUMP);
+}
+
+void SgXoshiro128::Jump(const uint32_t* jumpTable)
+{
+    uint32_t s[4] = { 0, 0, 0, 0 };
+    for (int i = 0; i < 4; ++i)
+        for (int b = 0; b < 32; ++b)
+        {
+            if (jumpTable[i] & (uint32_t(1) << b))
+                for (int j = 0; j < 4; ++j)
+                    s[j] ^= m_s[j];
+            (*this)();
+        }
+    for (int j = 0; j < 4; ++j)
+        m_s[j] = s[j];
+}
+
+//----------------------------------------------------------------------------
+
+void SgPcg32::Seed(uint64_t seed)
+{
+    m_state = 0;
+    (*this)();
+    m_state += seed;
+    (*this)();
+}
+
+void SgPcg32::Advance(uint64_t delta)
+{
+    // Brown, "Random Number Generation with Arbitrary Stride", 1994
+    uint64_t curMult = MULTIPLIER;
+    uint64_t curPlus = INCREMENT;
+    uint64_t accMult = 1;
+    uint64_t accPlus = 0;
+    while (delta > 0)
+    {
+        if (delta & 1)
+        {
+            accMult *= curMult;
+            accPlus = accPlus * curMult + curPlus;
+        }
+        curPlus = (curMult + 1) * curPlus;
+        curMult *= curMult;
+        delta >>= 1;
+    }
+    m_state = accMult * m_state + accPlus;
+}
+
+//----------------------------------------------------------------------------
@@ -0,0 +1,163 @@
+//----------------------------------------------------------------------------
+/** @file SgRandomEngine.h
+    Fast random number engines used by SgRandom. */
+//----------------------------------------------------------------------------
+
+#ifndef SG_RANDOMENGINE_H
+#define SG_RANDOMENGINE_H
+
+#include <stdint.h>
+
+//----------------------------------------------------------------------------
+
+/** Random number engines supported by SgRandom. */
+enum SgRandomEngineType
+{
+    /** Mersenne Twister (boost::mt19937).
+        Large state (2.5 KB) and slow seeding, but the original engine of
+        SgRandom, so it reproduces the results of older versions best. */
+    SG_RANDOM_MT19937,
+
+    /** xoshiro128++ (see SgXoshiro128).
+        Small state and very fast. Streams are separated by jump-ahead. */
+    SG_RANDOM_XOSHIRO128,
+
+    /** PCG32 (see SgPcg32).
+        Small state and fast. Streams are separated by jump-ahead. */
+    SG_RANDOM_PCG32,
+
+    _SG_NU_RANDOM_ENGINE
+};
+
+/** Name of an engine type, e.g. as used in GTP commands. */
+const char* SgRandomEngineTypeStr(SgRandomEngineType type);
+
+/** Parse the name of an engine type.
+    @return false, if the name is unknown */
+bool SgRandomEngineTypeFromStr(const char* name, SgRandomEngineType& type);
+
+//----------------------------------------------------------------------------
+
+/** Generator for seeding the state of other engines from a single number.
+    SplitMix64 by Sebastiano Vigna. Ensures that similar seeds (e.g.
+    consecutive numbers) give unrelated states. */
+class SgSplitMix64
+{
+public:
+    explicit SgSplitMix64(uint64_t seed);
+
+    uint64_t operator()();
+
+private:
+    uint64_t m_state;
+};
+
+inline SgSplitMix64::SgSplitMix64(uint64_t seed)
+    : m_state(seed)
+{ }
+
+inline uint64_t SgSplitMix64::operator()()
+{
+    uint64_t z = (m_state += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+//----------------------------------------------------------------------------
+
+/** The xoshiro128++ generator by David Blackman and Sebastiano Vigna.
+    32-bit output, 128-bit state, period 2^128 - 1.
+    See <a href="http://prng.di.unimi.it/">http://prng.di.unimi.it/</a> */
+class SgXoshiro128
+{
+public:
+    SgXoshiro128();
+
+    void Seed(uint64_t seed);
+
+    uint32_t operator()();
+
+    /** Advance the state by 2^64 steps.
+        Can be used to generate 2^64 non-overlapping sequences. */
+    void Jump();
+
+    /** Advance the state by 2^96 steps.
+        Can be used to generate 2^32 starting points, from each of which
+        Jump() generates 2^32 non-overlapping sequences. */
+    void LongJump();
+
+private:
+    uint32_t m_s[4];
+
+    void Jump(const uint32_t* jumpTable);
+
+    static uint32_t Rotl(uint32_t x, int k);
+};
+
+inline SgXoshiro128::SgXoshiro128()
+{
+    Seed(0);
+}
+
+inline uint32_t SgXoshiro128::operator()()
+{
+    const uint32_t result = Rotl(m_s[0] + m_s[3], 7) + m_s[0];
+    const uint32_t t = m_s[1] << 9;
+    m_s[2] ^= m_s[0];
+    m_s[3] ^= m_s[1];
+    m_s[1] ^= m_s[2];
+    m_s[0] ^= m_s[3];
+    m_s[2] ^= t;
+    m_s[3] = Rotl(m_s[3], 11);
+    return result;
+}
+
+inline uint32_t SgXoshiro128::Rotl(uint32_t x, int k)
+{
+    return (x << k) | (x >> (32 - k));
+}
+
+//----------------------------------------------------------------------------
+
+/** The PCG32 generator (PCG-XSH-RR) by Melissa O'Neill.
+    32-bit output, 64-bit state, period 2^64.
+    See <a href="http://www.pcg-random.org/">http://www.pcg-random.org/</a> */
+class SgPcg32
+{
+public:
+    SgPcg32();
+
+    void Seed(uint64_t seed);
+
+    uint32_t operator()();
+
+    /** Advance the state by @c delta steps in O(log(delta)) time. */
+    void Advance(uint64_t delta);
+
+private:
+    static const uint64_t MULTIPLIER = 6364136223846793005ULL;
+
+    static const uint64_t INCREMENT = 1442695040888963407ULL;
+
+    uint64_t m_state;
+};
+
+inline SgPcg32::SgPcg32()
+{
+    Seed(0);
+}
+
+inline uint32_t SgPcg32::operator()()
+{
+    const uint64_t oldState = m_state;
+    m_state = oldState * MULTIPLIER + INCREMENT;
+    const uint32_t xorShifted =
+        static_cast<uint32_t>(((oldState >> 18) ^ oldState) >> 27);
+    const uint32_t rot = static_cast<uint32_t>(oldState >> 59);
+    return (xorShifted >> rot) | (xorShifted << ((32 - rot) & 31));
+}
+
+//----------------------------------------------------------------------------
+
+#endif // SG_RANDOMENGINE_H
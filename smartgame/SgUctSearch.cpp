@@ -136,6 +136,17 @@ void SgUctThreadState::GameStart()
     // Default implementation does nothing
 }
 
+bool SgUctThreadState::PlayoutGames(std::size_t nuPlayouts,
+                                    std::size_t maxLength,
+                                    SgUctGameInfo& info)
+{
+    SG_UNUSED(nuPlayouts);
+    SG_UNUSED(maxLength);
+    SG_UNUSED(info);
+    // Default implementation does not support lockstep playouts
+    return false;
+}
+
 void SgUctThreadState::StartPlayout()
 {
     // Default implementation does nothing
@@ -263,6 +274,7 @@ SgUctSearch::SgUctSearch(SgUctThreadStateFactory* threadStateFactory,
       m_numberThreads(1),
       m_numberPlayouts(1),
       m_updateMultiplePlayoutsAsSingle(true),
+      m_lockstepPlayouts(false),
       m_maxNodes(GetMaxNodesDefault()),
       m_pruneMinCount(16),
       m_moveRange(moveRange),
@@ -897,7 +909,12 @@ void SgUctSearch::PlayGame(SgUctThreadState& state, GlobalLock* lock)
     else 
     {
         state.StartPlayouts();
-        for (size_t i = 0; i < m_numberPlayouts; ++i)
+        const bool isLockstep =
+               m_lockstepPlayouts
+            && m_numberPlayouts > 1
+            && ! abortInTree && ! state.m_isTreeOutOfMem && ! isTerminal
+            && PlayoutGames(state, nuMovesInTree);
+        for (size_t i = 0; ! isLockstep && i < m_numberPlayouts; ++i)
         {
             state.StartPlayout();
             info.m_sequence[i] = info.m_inTreeSequence;
@@ -932,6 +949,36 @@ void SgUctSearch::PlayGame(SgUctThreadState& state, GlobalLock* lock)
     UpdateStatistics(info);
 }
 
+/** Play all playouts of a game in lockstep.
+    See SgUctThreadState::PlayoutGames()
+    @return @c false, if the thread state does not support lockstep
+    playouts. */
+bool SgUctSearch::PlayoutGames(SgUctThreadState& state,
+                               std::size_t nuMovesInTree)
+{
+    SgUctGameInfo& info = state.m_gameInfo;
+    for (size_t i = 0; i < m_numberPlayouts; ++i)
+    {
+        info.m_sequence[i] = info.m_inTreeSequence;
+        info.m_skipRaveUpdate[i].assign(nuMovesInTree, false);
+    }
+    // Sequential playouts reinitialize the sequences, if the state does
+    // not support lockstep playouts
+    if (! state.PlayoutGames(m_numberPlayouts,
+                             m_maxGameLength - nuMovesInTree, info))
+        return false;
+    for (size_t i = 0; i < m_numberPlayouts; ++i)
+    {
+        SgUctValue eval = info.m_eval[i];
+        if (info.m_aborted[i])
+            eval = UnknownEval();
+        if (info.m_sequence[i].size() % 2 != 0)
+            eval = InverseEval(eval);
+        info.m_eval[i] = eval;
+    }
+    return true;
+}
+
 /** Backs up proven information. Last node of nodes is the newly
     proven node. */
 void SgUctSearch::PropagateProvenStatus(const vector<const SgUctNode*>& nodes)
@@ -1109,7 +1156,8 @@ SgUctValue SgUctSearch::Search(SgUctValue maxGames, double maxTime,
     {
         m_threads[i]->m_state->m_isSearchInitialized = false;
     }
-    StartSearch(rootFilter, initTree);
+    // The thread states are started in SearchLoop()
+    InitSearch(rootFilter, initTree);
     SgUctValue pruneMinCount = m_pruneMinCount;
     while (true)
     {
@@ -1158,6 +1206,7 @@ void SgUctSearch::SearchLoop(SgUctThreadState& state, GlobalLock* lock)
 {
     if (! state.m_isSearchInitialized)
     {
+        state.StartSearch();
         OnThreadStartSearch(state);
         state.m_isSearchInitialized = true;
     }
@@ -1354,8 +1403,8 @@ void SgUctSearch::SetThreadStateFactory(SgUctThreadStateFactory* factory)
     // is not fully constructed) as an argument to the Create() function
 }
 
-void SgUctSearch::StartSearch(const vector<SgMove>& rootFilter,
-                              SgUctTree* initTree)
+void SgUctSearch::InitSearch(const vector<SgMove>& rootFilter,
+                             SgUctTree* initTree)
 {
     if (m_threads.size() == 0)
         CreateThreads();
@@ -1397,10 +1446,17 @@ void SgUctSearch::StartSearch(const vector<SgMove>& rootFilter,
         SgUctThreadState& state = ThreadState(i);
         state.m_randomizeRaveCounter = m_randomizeRaveFrequency;
         state.m_randomizeBiasCounter = m_biasTermFrequency;
-        state.StartSearch();
     }
 }
 
+void SgUctSearch::StartSearch(const vector<SgMove>& rootFilter,
+                              SgUctTree* initTree)
+{
+    InitSearch(rootFilter, initTree);
+    for (unsigned int i = 0; i < m_threads.size(); ++i)
+        ThreadState(i).StartSearch();
+}
+
 void SgUctSearch::EndSearch()
 {
     OnEndSearch();
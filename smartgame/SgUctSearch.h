@@ -354,8 +354,11 @@ public:
     /** Start search.
         This function should do any necessary preparations for playing games
         in the thread, like initializing the thread's copy of the game state
-        from the global game state. The function does not have to be
-        thread-safe. */
+        from the global game state. SgUctSearch::Search() calls it in the
+        thread of this state at the beginning of SgUctSearch::SearchLoop(),
+        in parallel with the other thread states, so it may only read the
+        global game state and must only modify data of this thread
+        state. */
     virtual void StartSearch() = 0;
 
     /** Take back moves played in the in-tree phase. */
@@ -394,6 +397,26 @@ public:
         Default implementation does nothing. */
     virtual void EndPlayout();
 
+    /** Play all playouts of the current game in lockstep.
+        Called by SgUctSearch::PlayGame() instead of the StartPlayout(),
+        GeneratePlayoutMove(), ExecutePlayout(), Evaluate(), EndPlayout()
+        cycle, if SgUctSearch::LockstepPlayouts() is enabled and more than
+        one playout is played per game. An implementation advances all
+        playouts in an interleaved loop, appends the playout moves to
+        <tt>info.m_sequence[i]</tt> and <tt>info.m_skipRaveUpdate[i]</tt>
+        (which already contain the in-tree sequence), and stores the
+        evaluation for the player to move at the end of playout @c i (same
+        meaning as the return value of Evaluate()) in
+        <tt>info.m_eval[i]</tt> and the abort flag in
+        <tt>info.m_aborted[i]</tt>.
+        @param nuPlayouts The number of playouts
+        @param maxLength The maximum number of moves in each playout
+        @param info The game info
+        @return @c false, if lockstep playouts are not supported by the
+        thread state. The default implementation returns @c false. */
+    virtual bool PlayoutGames(std::size_t nuPlayouts, std::size_t maxLength,
+                              SgUctGameInfo& info);
+
     // @} // name
 };
 
@@ -573,6 +596,10 @@ public:
     void EndSearch();
 
     /** Calls StartSearch() and then PlayGame() in a loop.
+        Unlike StartSearch(), calls SgUctThreadState::StartSearch() not
+        for all thread states one after the other, but in the threads at
+        the beginning of their search loop, such that the thread states are
+        updated to the current position in parallel.
         @param maxGames The maximum number of games (greater or equal
         one). The number of games includes the ones already counted in
         the initialization tree (see parameter initTree).
@@ -620,6 +647,16 @@ public:
     SgUctValue GetBound(bool useRave, const SgUctNode& node, 
                         const SgUctNode& child) const;
 
+    /** Select the child of a node to follow in the in-tree phase.
+        Used by PlayInTree(). Public for benchmarking the selection on an
+        existing tree.
+        @param randomizeCounter The thread's counter for randomized RAVE
+        (see SgUctThreadState::m_randomizeRaveCounter)
+        @param useBiasTerm Whether to add the UCT bias term
+        @param node The node. Must have children. */
+    const SgUctNode& SelectChild(int& randomizeCounter, bool useBiasTerm,
+                                 const SgUctNode& node);
+
     // @} // name
 
 
@@ -787,6 +824,16 @@ public:
 
     void SetNumberPlayouts(std::size_t n);
 
+    /** Play the NumberPlayouts() playouts of a game in lockstep.
+        If enabled and the thread state supports it (see
+        SgUctThreadState::PlayoutGames()), the playouts of a game are advanced
+        together in an interleaved loop instead of one after the other.
+        Default is false. */
+    bool LockstepPlayouts() const;
+
+    /** See LockstepPlayouts() */
+    void SetLockstepPlayouts(bool enable);
+
     /** Use the RAVE algorithm (Rapid Action Value Estimation).
         See Gelly, Silver 2007 in the references in the class description.
         In difference to the original description of the RAVE algorithm,
@@ -878,7 +925,10 @@ public:
 
     const SgUctSearchStat& Statistics() const;
 
-    void WriteStatistics(std::ostream& out) const;
+    /** Write the statistics of the last search.
+        Subclasses can extend this function to write additional statistics
+        (e.g. of their caches). */
+    virtual void WriteStatistics(std::ostream& out) const;
 
     // @} // name
 
@@ -1020,6 +1070,9 @@ private:
     /** See UpdateMultiplePlayoutsAsSingle() */
     bool m_updateMultiplePlayoutsAsSingle;
 
+    /** See LockstepPlayouts() */
+    bool m_lockstepPlayouts;
+
     /** See MaxNodes() */
     std::size_t m_maxNodes;
 
@@ -1144,6 +1197,12 @@ private:
 
     SgUctValue Log(SgUctValue x) const;
 
+    /** Initialize the search without calling
+        SgUctThreadState::StartSearch().
+        See StartSearch() */
+    void InitSearch(const std::vector<SgMove>& rootFilter,
+                    SgUctTree* initTree);
+
     bool NeedToComputeKnowledge(const SgUctNode* current);
 
     void PlayGame(SgUctThreadState& state, GlobalLock* lock);
@@ -1152,12 +1211,12 @@ private:
 
     bool PlayoutGame(SgUctThreadState& state, std::size_t playout);
 
+    bool PlayoutGames(SgUctThreadState& state, std::size_t nuMovesInTree);
+
     void PrintSearchProgress(double currTime) const;
     
     void SearchLoop(SgUctThreadState& state, GlobalLock* lock);
 
-    const SgUctNode& SelectChild(int& randomizeCounter, bool useBiasTerm, const SgUctNode& node);
-
     std::string SummaryLine(const SgUctGameInfo& info) const;
 
     void UpdateCheckTimeInterval(double time);
@@ -1289,6 +1348,11 @@ inline std::size_t SgUctSearch::NumberPlayouts() const
     return m_numberPlayouts;
 }
 
+inline bool SgUctSearch::LockstepPlayouts() const
+{
+    return m_lockstepPlayouts;
+}
+
 inline bool SgUctSearch::UpdateMultiplePlayoutsAsSingle() const
 {
 	return m_updateMultiplePlayoutsAsSingle;
@@ -1405,6 +1469,11 @@ inline void SgUctSearch::SetNumberPlayouts(std::size_t n)
     m_numberPlayouts = n;
 }
 
+inline void SgUctSearch::SetLockstepPlayouts(bool enable)
+{
+    m_lockstepPlayouts = enable;
+}
+
 inline void SgUctSearch::SetUpdateMultiplePlayoutsAsSingle(bool enable)
 {
     m_updateMultiplePlayoutsAsSingle = enable;
@@ -0,0 +1,68 @@
+//----------------------------------------------------------------------------
+/** @file SgChunkListTest.cpp
+    Unit tests for SgChunkList. */
+//----------------------------------------------------------------------------
+
+#include "SgSystem.h"
+
+#include <boost/test/auto_unit_test.hpp>
+#include "SgChunkList.h"
+
+using namespace std;
+
+//----------------------------------------------------------------------------
+
+namespace {
+
+BOOST_AUTO_TEST_CASE(SgChunkListTest_Index)
+{
+    SgChunkList<int,4> a;
+    a.Resize(37);
+    for (int i = 0; i < a.Length(); ++i)
+        BOOST_CHECK_EQUAL(a.Index(&a[i]), i);
+}
+
+BOOST_AUTO_TEST_CASE(SgChunkListTest_Resize)
+{
+    SgChunkList<int,4> a;
+    BOOST_CHECK(a.IsEmpty());
+    BOOST_CHECK_EQUAL(a.Capacity(), 0);
+    for (int i = 0; i < 10; ++i)
+    {
+        a.Resize(a.Length() + 1);
+        a.Last() = i;
+    }
+    BOOST_CHECK_EQUAL(a.Length(), 10);
+    BOOST_CHECK_EQUAL(a.Capacity(), 12);
+    for (int i = 0; i < 10; ++i)
+        BOOST_CHECK_EQUAL(a[i], i);
+    a.PopBack();
+    BOOST_CHECK_EQUAL(a.Length(), 9);
+    BOOST_CHECK_EQUAL(a.Last(), 8);
+    a.Resize(3);
+    BOOST_CHECK_EQUAL(a.Last(), 2);
+    a.Clear();
+    BOOST_CHECK(a.IsEmpty());
+    BOOST_CHECK_EQUAL(a.Capacity(), 12);
+}
+
+/** Test that the addresses of elements do not change when the list grows.
+    */
+BOOST_AUTO_TEST_CASE(SgChunkListTest_StableAddress)
+{
+    SgChunkList<int,4> a;
+    a.Resize(1);
+    a[0] = 5;
+    int* p = &a[0];
+    a.Resize(100);
+    BOOST_CHECK_EQUAL(&a[0], p);
+    BOOST_CHECK_EQUAL(*p, 5);
+    a.Resize(1);
+    a.Resize(50);
+    BOOST_CHECK_EQUAL(&a[0], p);
+    BOOST_CHECK_EQUAL(a.Capacity(), 100);
+}
+
+} // namespace
+
+//----------------------------------------------------------------------------
@@ -61,6 +61,74 @@ BOOST_AUTO_TEST_CASE(SgHashCodeTest_Roll)
     }
 }
 
+BOOST_AUTO_TEST_CASE(SgHashCodeTest_Hash)
+{
+    for (int i = 0; i < 1000; ++i)
+    {
+        SgHashCode hash = SgHashCode::Random();
+        BOOST_CHECK_EQUAL(hash.Hash(1), 0u);
+        BOOST_CHECK_LT(hash.Hash(7), 7u);
+        BOOST_CHECK_LT(hash.Hash(4096), 4096u);
+    }
+}
+
+/** Check that operator< is the order of the numbers.
+    Compares with the order of the hex strings, which have a fixed length. */
+BOOST_AUTO_TEST_CASE(SgHashCodeTest_Less)
+{
+    for (int i = 0; i < 1000; ++i)
+    {
+        SgHash<128> hash1 = SgHash<128>::Random();
+        SgHash<128> hash2 = SgHash<128>::Random();
+        if (i % 2 == 0)
+            // Same upper word
+            hash2.FromString(hash1.ToString().substr(0, 16)
+                             + hash2.ToString().substr(16));
+        BOOST_CHECK_EQUAL(hash1 < hash2,
+                          hash1.ToString() < hash2.ToString());
+        BOOST_CHECK(! (hash1 < hash1));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(SgHashCodeTest_Roll128)
+{
+    SgHash<128> hash(12345);
+    for (int i = 0; i < SgHash<128>::Size(); ++i)
+    {
+        SgHash<128> newhash(12345);
+        newhash.RollLeft(i);
+        if (i > 0)
+            BOOST_CHECK(hash != newhash);
+        newhash.RollRight(i);
+        BOOST_CHECK(hash == newhash);
+    }
+    SgHash<128> one;
+    one.FromString("1");
+    one.RollLeft(70);
+    BOOST_CHECK_EQUAL(one.ToString(), "00000000000000400000000000000000");
+    one.RollRight(71);
+    BOOST_CHECK_EQUAL(one.ToString(), "80000000000000000000000000000000");
+}
+
+/** Check that the string representation and the codes constructed from
+    integers do not change, they are used in opening book files. */
+BOOST_AUTO_TEST_CASE(SgHashCodeTest_String)
+{
+    BOOST_CHECK_EQUAL(SgHash<64>(12345).ToString(), "525b58ec05ebc6f1");
+    BOOST_CHECK_EQUAL(SgHash<128>(12345).ToString(),
+                      "525b58ec05ebc6f1187781f302b7abfe");
+    SgHashCode hash;
+    hash.FromString("525B58EC05EBC6F1");
+    BOOST_CHECK(hash == SgHashCode(12345));
+    BOOST_CHECK_EQUAL(hash.Code1(), 0x05ebc6f1u);
+    BOOST_CHECK_EQUAL(hash.Code2(), 0x525b58ecu);
+    SgHash<128> hash128 = SgHash<128>::Random();
+    SgHash<128> copy;
+    copy.FromString(hash128.ToString());
+    BOOST_CHECK(copy == hash128);
+    BOOST_CHECK_THROW(hash.FromString("12x4"), SgException);
+}
+
 //----------------------------------------------------------------------------
 
 BOOST_AUTO_TEST_CASE(SgHashUtilTest_XorZobrist)
@@ -5,9 +5,11 @@
 
 #include "SgSystem.h"
 
+#include <bitset>
 #include <sstream>
 #include <boost/test/auto_unit_test.hpp>
 #include "SgPointSet.h"
+#include "SgRandom.h"
 
 using namespace std;
 using SgPointUtil::Pt;
@@ -471,6 +473,143 @@ BOOST_AUTO_TEST_CASE(SgPointSetTest_PointOf)
     BOOST_CHECK_EQUAL(a.PointOf(), Pt(1, 1));
 }
 
+/** Reference implementation of SgPointSet operations with std::bitset. */
+typedef bitset<SG_MAXPOINT> RefSet;
+
+RefSet ToRefSet(const SgPointSet& set)
+{
+    RefSet result;
+    for (SgPoint p = 0; p < SG_MAXPOINT; ++p)
+        if (set.Contains(p))
+            result.set(p);
+    return result;
+}
+
+RefSet RefAllPoints(int boardSize)
+{
+    RefSet result;
+    for (int col = 1; col <= boardSize; ++col)
+        for (int row = 1; row <= boardSize; ++row)
+            result.set(Pt(col, row));
+    return result;
+}
+
+RefSet RefNb4(const RefSet& set)
+{
+    return (set >> SG_NS) | (set << SG_NS) | (set >> SG_WE) | (set << SG_WE);
+}
+
+RefSet RefNb8(const RefSet& set)
+{
+    return RefNb4(set) | (set >> (SG_NS + SG_WE)) | (set << (SG_NS + SG_WE))
+        | (set >> (SG_NS - SG_WE)) | (set << (SG_NS - SG_WE));
+}
+
+RefSet RefComponent(const RefSet& set, SgPoint p)
+{
+    RefSet result;
+    result.set(p);
+    RefSet last;
+    while (result != last)
+    {
+        last = result;
+        result |= RefNb4(result) & set;
+    }
+    return result;
+}
+
+/** Random set of on-board points with a random density. */
+void RandomSet(SgRandom& random, int boardSize, SgPointSet& set,
+               RefSet& refSet)
+{
+    set.Clear();
+    refSet.reset();
+    const int percent = random.Int(101);
+    for (int col = 1; col <= boardSize; ++col)
+        for (int row = 1; row <= boardSize; ++row)
+            if (random.Int(100) < percent)
+            {
+                set.Include(Pt(col, row));
+                refSet.set(Pt(col, row));
+            }
+}
+
+/** Compare the results of the word-based SgPointSet with a reference
+    implementation on random sets. */
+BOOST_AUTO_TEST_CASE(SgPointSetTest_Random)
+{
+    SgRandom random;
+    for (int i = 0; i < 300; ++i)
+    {
+        const int size =
+            SG_MIN_SIZE + random.Int(SG_MAX_SIZE - SG_MIN_SIZE + 1);
+        const RefSet all = RefAllPoints(size);
+        SgPointSet a;
+        SgPointSet b;
+        RefSet refA;
+        RefSet refB;
+        RandomSet(random, size, a, refA);
+        RandomSet(random, size, b, refB);
+        BOOST_REQUIRE(ToRefSet(a) == refA);
+        BOOST_CHECK(ToRefSet(a & b) == (refA & refB));
+        BOOST_CHECK(ToRefSet(a | b) == (refA | refB));
+        BOOST_CHECK(ToRefSet(a ^ b) == (refA ^ refB));
+        BOOST_CHECK(ToRefSet(a - b) == (refA & ~refB));
+        BOOST_CHECK_EQUAL(a == b, refA == refB);
+        BOOST_CHECK(a == a);
+        BOOST_CHECK_EQUAL(a.Size(), static_cast<int>(refA.count()));
+        BOOST_CHECK_EQUAL(a.IsEmpty(), refA.none());
+        BOOST_CHECK_EQUAL(a.Overlaps(b), (refA & refB).any());
+        BOOST_CHECK_EQUAL(a.SubsetOf(b), (refA & ~refB).none());
+        BOOST_CHECK_EQUAL(a.SupersetOf(a & b), true);
+        const int overlap = static_cast<int>((refA & refB).count());
+        BOOST_CHECK(a.MaxOverlap(b, overlap));
+        BOOST_CHECK(! a.MaxOverlap(b, overlap - 1));
+        // The border of the border contains points outside of the board and
+        // at the ends of the range of the points
+        const RefSet refBorder = RefNb4(refA) & ~refA;
+        BOOST_CHECK(ToRefSet(a.BorderNoClip()) == refBorder);
+        BOOST_CHECK(ToRefSet(a.BorderNoClip().BorderNoClip())
+                    == (RefNb4(refBorder) & ~refBorder));
+        BOOST_CHECK(ToRefSet(a.Border(size)) == (refBorder & all));
+        BOOST_CHECK(ToRefSet(a.Border8(size))
+                    == (RefNb8(refA) & ~refA & all));
+        BOOST_CHECK(ToRefSet(a.Kernel(size))
+                    == (refA & ~RefNb4(all & ~refA)));
+        BOOST_CHECK_EQUAL(a.Adjacent(b), (refBorder & refB).any());
+        SgPointSet grown(a);
+        grown.Grow(size);
+        BOOST_CHECK(ToRefSet(grown) == (refA | (RefNb4(refA) & all)));
+        grown = a;
+        grown.Grow8(size);
+        BOOST_CHECK(ToRefSet(grown) == (refA | (RefNb8(refA) & all)));
+        grown = a;
+        SgPointSet newArea;
+        grown.Grow(&newArea, size);
+        BOOST_CHECK(ToRefSet(newArea) == ((RefNb4(refA) & all) ^ refA));
+        BOOST_CHECK(ToRefSet(grown) == (refA | (RefNb4(refA) & all)));
+        SgVector<SgPoint> points;
+        a.ToVector(&points);
+        BOOST_REQUIRE_EQUAL(points.Length(), a.Size());
+        int j = 0;
+        for (SgPoint p = 0; p < SG_MAXPOINT; ++p)
+            if (refA.test(p))
+                BOOST_CHECK_EQUAL(points[j++], p);
+        if (a.IsEmpty())
+            BOOST_CHECK_EQUAL(a.PointOf(), SG_NULLPOINT);
+        else
+        {
+            const SgPoint p = a.PointOf();
+            BOOST_CHECK_EQUAL(p, points[0]);
+            BOOST_CHECK(ToRefSet(a.Component(p)) == RefComponent(refA, p));
+            BOOST_CHECK(a.ConnComp(p) == a.Component(p));
+        }
+        a.Swap(b);
+        BOOST_CHECK(ToRefSet(a) == refB);
+        BOOST_CHECK(ToRefSet(b) == refA);
+    }
+}
+
 BOOST_AUTO_TEST_CASE(SgPointSetTest_SubsetOf)
 {
     SgPointSet a;
@@ -7,6 +7,7 @@
 
 #include <boost/test/auto_unit_test.hpp>
 #include "SgRandom.h"
+#include "SgRandomEngine.h"
 
 //----------------------------------------------------------------------------
 
@@ -37,6 +38,143 @@ BOOST_AUTO_TEST_CASE(SgRandomTestFloat)
     }
 }
 
+BOOST_AUTO_TEST_CASE(SgRandomTestSetStream)
+{
+    SgRandom r1;
+    SgRandom r2;
+    SgRandom r3;
+    r1.SetStream(1);
+    r2.SetStream(1);
+    r3.SetStream(2);
+    bool isDifferent = false;
+	for (int i=0; i < 100; ++i)
+    {
+        unsigned int n1 = r1.Int();
+        BOOST_CHECK_EQUAL(n1, r2.Int());
+        if (n1 != r3.Int())
+            isDifferent = true;
+    }
+    BOOST_CHECK(isDifferent);
+}
+
+/** Check that Int(int) returns all values with about the same frequency. */
+BOOST_AUTO_TEST_CASE(SgRandomTestIntUniform)
+{
+    SgRandom r;
+    const int range = 3;
+    const int n = 30000;
+    int count[range] = { 0, 0, 0 };
+    for (int i = 0; i < n; ++i)
+    {
+        int k = r.Int(range);
+        BOOST_REQUIRE(k >= 0 && k < range);
+        ++count[k];
+    }
+    for (int i = 0; i < range; ++i)
+    {
+        BOOST_CHECK_GT(count[i], 9500);
+        BOOST_CHECK_LT(count[i], 10500);
+    }
+}
+
+/** Test SgRandom::SetEngine() and SgRandom::SetStream() with all engines. */
+BOOST_AUTO_TEST_CASE(SgRandomTestSetEngine)
+{
+    const int oldSeed = SgRandom::Seed();
+    const SgRandomEngineType oldEngine = SgRandom::Engine();
+    for (int i = 0; i < _SG_NU_RANDOM_ENGINE; ++i)
+    {
+        SgRandomEngineType engine = static_cast<SgRandomEngineType>(i);
+        SgRandom::SetEngine(engine);
+        BOOST_CHECK_EQUAL(SgRandom::Engine(), engine);
+        SgRandom::SetSeed(1);
+        SgRandom r1;
+        SgRandom r2;
+        SgRandom r3;
+        SgRandom r4;
+        r1.SetStream(1);
+        r2.SetStream(1);
+        r3.SetStream(2);
+        r4.SetStream(1, 1);
+        bool isDifferent3 = false;
+        bool isDifferent4 = false;
+        for (int j = 0; j < 100; ++j)
+        {
+            unsigned int n1 = r1.Int();
+            BOOST_CHECK_EQUAL(n1, r2.Int());
+            if (n1 != r3.Int())
+                isDifferent3 = true;
+            if (n1 != r4.Int())
+                isDifferent4 = true;
+            float f = r1.Float_01();
+            BOOST_CHECK_EQUAL(f, r2.Float_01());
+            BOOST_CHECK_GE(f, 0.);
+            BOOST_CHECK_LT(f, 1.);
+        }
+        BOOST_CHECK(isDifferent3);
+        BOOST_CHECK(isDifferent4);
+        // Setting the seed again reproduces the sequence
+        SgRandom::SetSeed(1);
+        SgRandom r5;
+        r5.SetStream(1);
+        SgRandom::SetSeed(1);
+        BOOST_CHECK_EQUAL(r1.Int(), r5.Int());
+    }
+    SgRandom::SetEngine(oldEngine);
+    SgRandom::SetSeed(oldSeed == 0 ? -1 : oldSeed);
+}
+
+BOOST_AUTO_TEST_CASE(SgRandomEngineTestTypeStr)
+{
+    for (int i = 0; i < _SG_NU_RANDOM_ENGINE; ++i)
+    {
+        SgRandomEngineType type = static_cast<SgRandomEngineType>(i);
+        SgRandomEngineType parsed;
+        BOOST_CHECK(SgRandomEngineTypeFromStr(SgRandomEngineTypeStr(type),
+                                              parsed));
+        BOOST_CHECK_EQUAL(parsed, type);
+    }
+    SgRandomEngineType parsed;
+    BOOST_CHECK(! SgRandomEngineTypeFromStr("foo", parsed));
+}
+
+/** Test that SgPcg32::Advance() is equivalent to generating numbers. */
+BOOST_AUTO_TEST_CASE(SgRandomEngineTestPcg32Advance)
+{
+    SgPcg32 pcg1;
+    SgPcg32 pcg2;
+    pcg1.Seed(12345);
+    pcg2.Seed(12345);
+    for (int i = 0; i < 1000; ++i)
+        pcg1();
+    pcg2.Advance(1000);
+    for (int i = 0; i < 10; ++i)
+        BOOST_CHECK_EQUAL(pcg1(), pcg2());
+}
+
+/** Test that the jumps of SgXoshiro128 lead to different sequences. */
+BOOST_AUTO_TEST_CASE(SgRandomEngineTestXoshiro128Jump)
+{
+    SgXoshiro128 x1;
+    SgXoshiro128 x2;
+    SgXoshiro128 x3;
+    x1.Seed(12345);
+    x2.Seed(12345);
+    x3.Seed(12345);
+    x2.Jump();
+    x3.LongJump();
+    int nuEqual = 0;
+    for (int i = 0; i < 100; ++i)
+    {
+        uint32_t n1 = x1();
+        uint32_t n2 = x2();
+        uint32_t n3 = x3();
+        if (n1 == n2 || n1 == n3 || n2 == n3)
+            ++nuEqual;
+    }
+    BOOST_CHECK_LT(nuEqual, 2);
+}
+
 } // namespace
 
 //----------------------------------------------------------------------------
@@ -74,6 +74,9 @@ class TestThreadState
     : public SgUctThreadState
 {
 public:
+    /** Number of calls to StartSearch() */
+    int m_nuStartSearch;
+
     TestThreadState(unsigned int threadId, const vector<TestNode>& nodes);
 
 
@@ -118,6 +121,7 @@ private:
 TestThreadState::TestThreadState(unsigned int threadId,
                                  const vector<TestNode>& nodes)
     : SgUctThreadState(threadId),
+      m_nuStartSearch(0),
       m_currentNode(0),
       m_toPlay(SG_BLACK),
       m_nodes(nodes)
@@ -216,7 +220,9 @@ inline const TestNode& TestThreadState::Node(size_t index) const
 }
 
 void TestThreadState::StartSearch()
-{ }
+{
+    ++m_nuStartSearch;
+}
 
 void TestThreadState::TakeBack(size_t nuMoves)
 {
@@ -638,6 +644,23 @@ BOOST_AUTO_TEST_CASE(SgUctSearchTest_Knowledge)
 
 //----------------------------------------------------------------------------
 
+/** Test that Search() and StartSearch() start the thread state once.
+    Search() starts the thread state in the thread of the state. */
+BOOST_AUTO_TEST_CASE(SgUctSearchTest_StartSearch)
+{
+    TestUctSearch search;
+    search.AddNode(NO_NODE, SG_NULLMOVE);
+    search.AddLeafNode(0, 1, 1.f);
+    search.AddLeafNode(0, 2, 0.f);
+    vector<SgMove> sequence;
+    search.Search(10, numeric_limits<double>::max(), sequence);
+    const TestThreadState& state =
+        dynamic_cast<const TestThreadState&>(search.ThreadState(0));
+    BOOST_CHECK_EQUAL(state.m_nuStartSearch, 1);
+    search.StartSearch();
+    BOOST_CHECK_EQUAL(state.m_nuStartSearch, 2);
+}
+
 } // namespace
 
 //----------------------------------------------------------------------------